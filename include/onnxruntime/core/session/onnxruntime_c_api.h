@@ -305,6 +305,7 @@ ORT_RUNTIME_CLASS(OpAttr);
 ORT_RUNTIME_CLASS(Logger);
 ORT_RUNTIME_CLASS(ShapeInferContext);
 ORT_RUNTIME_CLASS(LoraAdapter);
+ORT_RUNTIME_CLASS(PreparedRun);
 
 #ifdef _WIN32
 typedef _Return_type_success_(return == 0) OrtStatus* OrtStatusPtr;
@@ -4778,6 +4779,66 @@ struct OrtApi {
    */
   ORT_API2_STATUS(SetEpDynamicOptions, _Inout_ OrtSession* sess, _In_reads_(kv_len) const char* const* keys,
                   _In_reads_(kv_len) const char* const* values, _In_ size_t kv_len);
+
+  /// @}
+  /// \name OrtPreparedRun
+  /// @{
+
+  /** \brief Create an ::OrtPreparedRun
+   *
+   * Validates the input and output names against the model once and resolves them to the session's internal
+   * indices. Running with the ::OrtPreparedRun through OrtApi::RunPrepared skips the name lookups and the
+   * per-call setup that OrtApi::Run performs, which matters for small models that are run many times.
+   * The inputs and outputs are still checked for type and shape on every run.
+   *
+   * An ::OrtPreparedRun can only be used with the session that created it, and must not be used by multiple
+   * threads at the same time. Create one instance per thread to run concurrently.
+   *
+   * \param[in] session
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] input_len Number of elements in the input_names array
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names array
+   * \param[out] out Created ::OrtPreparedRun instance. Must be released with OrtApi::ReleasePreparedRun
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(CreatePreparedRun, _In_ const OrtSession* session,
+                  _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Outptr_ OrtPreparedRun** out);
+
+  /** \brief Release an ::OrtPreparedRun
+   *
+   * \since Version 1.21.
+   */
+  ORT_CLASS_RELEASE(PreparedRun);
+
+  /** \brief Run the model with the inputs and outputs resolved by OrtApi::CreatePreparedRun
+   *
+   * Same as OrtApi::Run, with the input values and output values given in the order of the names passed to
+   * OrtApi::CreatePreparedRun. Active LoRA adapters in the run options have no effect.
+   *
+   * \param[in] session
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+   * \param[in] prepared_run ::OrtPreparedRun created from the same session
+   * \param[in] inputs Array of ::OrtValue%s of the input values
+   * \param[in] input_len Number of elements in the inputs array, must match the number of input names
+   * \param[in,out] outputs Array of ::OrtValue%s that the outputs are stored in. This can also be
+   *     an array of nullptr values, in this case ::OrtValue objects will be allocated and pointers
+   *     to them will be set into the `outputs` array.
+   * \param[in] output_len Number of elements in the outputs array, must match the number of output names
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.21.
+   */
+  ORT_API2_STATUS(RunPrepared, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _Inout_ OrtPreparedRun* prepared_run,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _Inout_updates_all_(output_len) OrtValue** outputs, size_t output_len);
 };
 
 /*
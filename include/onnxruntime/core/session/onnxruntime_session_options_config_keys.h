@@ -20,6 +20,28 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// Defer pre-packing of the constant initializers used by a node to the first execution of the node, instead of
+// pre-packing all of them during session initialization. Nodes that are never executed, e.g. in untaken If branches
+// or unused experts, never pre-pack their weights, and weights with external data on CPU stay memory mapped until
+// first use. Initializers are kept after being pre-packed as they may be referenced by a concurrent run.
+// Deferral is not used with a pre-packed weights container shared between sessions or when saving pre-packed
+// initializers.
+// Option values:
+// - "0": pre-pack during session initialization. [DEFAULT]
+// - "1": pre-pack on first execution of each node.
+static const char* const kOrtSessionOptionsConfigDeferPrepacking = "session.defer_prepacking";
+
+// Share identical constant initializers between the sessions of an environment that enable this option, so that
+// models with common weights, e.g. variants of a model or the parts of a split model, keep a single copy of them.
+// Initializers are matched by element type, shape and content. Only initializers allocated on CPU by the session of at
+// least 1KB are shared; memory mapped external data and initializers using the bytes of an ORT format model are
+// not. The initializers are loaded before being matched, so the peak memory usage while loading is not reduced.
+// Option values:
+// - "0": each session keeps its own copy of the initializers. [DEFAULT]
+// - "1": share the initializers with the other sessions of the environment enabling this option.
+static const char* const kOrtSessionOptionsConfigShareInitializersAcrossSessions =
+    "session.share_initializers_across_sessions";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
@@ -111,6 +133,22 @@ static const char* const kOrtSessionOptionsDisableSpecifiedOptimizers = "optimiz
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
 
+// Maximum number of threads of the intra-op thread pool used to deserialize CPU initializers without external data
+// during session initialization. The tensors are allocated sequentially so the memory layout doesn't depend on this.
+// Option values:
+// - "0": use all threads of the intra-op thread pool. [DEFAULT]
+// - "1": deserialize initializers sequentially.
+// - "N": use at most N threads.
+static const char* const kOrtSessionOptionsInitializerLoadConcurrency = "session.initializer_load_concurrency";
+
+// Ask the OS to read the external data of the initializers into the page cache in the background before they are
+// loaded during session initialization. Adjacent ranges of the external data files are coalesced into larger
+// requests. This helps when the external data is on slow or network attached storage.
+// Option values:
+// - "0": disable. [DEFAULT]
+// - "1": enable.
+static const char* const kOrtSessionOptionsExternalDataReadahead = "session.external_data_readahead";
+
 // Configure whether to allow the inter_op/intra_op threads spinning a number of times before blocking
 // "0": thread will block if found no job to run
 // "1": default, thread will spin a number of times before blocking
@@ -128,9 +166,12 @@ static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "ses
 /// <summary>
 /// Key for using the ORT format model flatbuffer bytes directly for initializers.
 /// This avoids copying the bytes and reduces peak memory usage during model loading and initialization.
-/// Requires `session.use_ort_model_bytes_directly` to be true.
+/// When creating the InferenceSession from bytes, requires `session.use_ort_model_bytes_directly` to be true.
 /// If set, the flatbuffer bytes provided when creating the InferenceSession MUST remain valid for the entire
 /// duration of the InferenceSession.
+/// When creating the InferenceSession from a file path, the file is memory mapped for the duration of the
+/// InferenceSession instead of being read, so CPU initializers are backed by the file in place and its pages are
+/// shared by all the processes on the host using the same file. The file must not be modified while in use.
 /// </summary>
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
     "session.use_ort_model_bytes_for_initializers";
@@ -189,6 +230,32 @@ static const char* const kOrtSessionOptionsConfigForceSpinningStop = "session.fo
 // May be useful to expose bugs in models.
 static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "session.strict_shape_type_inference";
 
+// When profiling is enabled, record the events of 1 in N runs only, so profiling can stay enabled with a low overhead.
+// Events recorded outside of runs, e.g. during session initialization, are always recorded.
+// The value is N, a positive integer. Default is "1", every run is recorded.
+static const char* const kOrtSessionOptionsConfigProfilingSamplingRate = "session.profiling_sampling_rate";
+
+// When profiling to a file is enabled, stream the events to the file every N milliseconds instead of keeping all of
+// them in memory until profiling ends. The events of each thread are kept in a ring buffer of bounded size between
+// flushes, events recorded while it is full are dropped and reported when profiling ends. The file is a valid trace
+// once profiling ends and can be opened by the trace viewers before that. In WebAssembly builds without threads the
+// buffers are instead flushed when they are full, so no events are dropped.
+// The value is N, a non-negative integer. Default is "0", events are written when profiling ends.
+static const char* const kOrtSessionOptionsConfigProfilingFlushIntervalMs = "session.profiling_flush_interval_ms";
+
+// When profiling is enabled, record the hardware performance counters of each kernel: cycles, instructions,
+// last level cache misses and branch misses in user mode. They are added to the event of each kernel and their totals
+// per op type and input shapes are written as one event each when profiling ends, e.g. to tell whether a kernel is
+// compute or memory bound. Only supported on Linux, where perf_event_open must be permitted (see
+// /proc/sys/kernel/perf_event_paranoid). The counters cover the thread running the kernel, work done by the other
+// threads of the intra-op thread pool is not included. When the hardware has fewer counters than are in use, the counts
+// are scaled from the part of the kernel time they were counting. Kernels during which they were not counting at all
+// have no counters.
+// Option values:
+// - "0": hardware counters are not recorded. [DEFAULT]
+// - "1": hardware counters are recorded.
+static const char* const kOrtSessionOptionsConfigProfilingHardwareCounters = "session.profiling_hardware_counters";
+
 // "1": every model using a more recent opset than the latest released one will fail
 // "0": the model may or may not work if onnxruntime cannot find an implementation, this option
 // is used for development purpose.
@@ -197,6 +264,21 @@ static const char* const kOrtSessionOptionsConfigStrictAllowReleasedOpsetsOnly =
 // The file saves configuration for partitioning node among logic streams
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
+// In parallel execution mode, graphs running on CPU can be executed by dataflow: each node is run as soon as the
+// nodes it depends on completed, on the thread completing the last of them or on the inter-op thread pool, instead of
+// following the order of the logic streams.
+// Dataflow execution is not used when a node partition config (kNodePartitionConfigFile) is set, as it would ignore
+// the logic streams the config defines.
+// Option values:
+// - "0": dataflow execution is disabled, the logic streams are run in order. [DEFAULT]
+// - "1": dataflow execution is enabled.
+static const char* const kOrtSessionOptionsEnableDataflowExecution = "session.enable_dataflow_execution";
+
+// Profile written by a previous run of the model with profiling enabled, whose kernel times replace the static cost
+// estimates of the nodes when prioritizing the nodes on the critical path in dataflow execution.
+// The static estimates are still used for the nodes missing from the profile. Not set by default.
+static const char* const kOrtSessionOptionsNodeCostProfileFile = "session.node_cost_profile_file";
+
 // This Option allows setting affinities for intra op threads.
 // Affinity string follows format:
 // logical_processor_id,logical_processor_id;logical_processor_id,logical_processor_id
@@ -246,6 +328,15 @@ static const char* const kOrtSessionOptionsDisableCPUEPFallback = "session.disab
 static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersFileName =
     "session.optimized_model_external_initializers_file_name";
 
+// Directory in which optimized models are cached in ORT format. When set, a session loading an ONNX model from a file
+// looks up the model in the cache using a fingerprint of the model file, the session options and the registered
+// execution providers. On a hit the cached model is loaded and the graph optimizations are skipped, otherwise the
+// optimized model is added to the cache during session initialization.
+// The cache is used only when the CPU execution provider is the only execution provider, the model has no external
+// data and SessionOptions.optimized_model_filepath is not set. Cached models may contain hardware specific
+// optimizations so the directory should not be shared between machines.
+static const char* const kOrtSessionOptionsConfigOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
 // Use this config to control the minimum size of the initializer when externalizing it during serialization
 static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersMinSizeInBytes =
     "session.optimized_model_external_initializers_min_size_in_bytes";
@@ -289,6 +380,14 @@ static const char* const kOrtSessionOptionShareEpContexts = "ep.share_ep_context
 // - "1": Gemm FastMath mode is enabled.
 static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas.enable_gemm_fastmath_arm64_bfloat16";
 
+// Lets the CPU Conv kernel use the Winograd F(2x2, 3x3) algorithm for 3x3 stride 1 convolutions with constant
+// weights and enough channels. The result differs from the GEMM based algorithms by a small rounding error, so the
+// algorithm is only used when enabled explicitly.
+// Option values:
+// - "0": Winograd convolution is disabled. [DEFAULT]
+// - "1": Winograd convolution is enabled.
+static const char* const kOrtSessionOptionsMlasEnableConvWinograd = "mlas.enable_conv_winograd";
+
 // When converting DQ + MatMul -> MatMulNBits, the accuracy level of the MatMulNBits is controlled by this option.
 // Refer to MatMulNBits op schema for more details.
 // If not provided, default is 4.
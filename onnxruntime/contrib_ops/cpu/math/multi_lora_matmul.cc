@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Applies a different LoRA adapter to each batch entry on top of the output of the base weights.
+// Consecutive batch entries using the same adapter form a segment whose rows are contiguous in A and Y, so each
+// segment is computed by two GEMMs against the weights of its adapter without gathering the rows.
+class MultiLoraMatMul final : public OpKernel {
+ public:
+  explicit MultiLoraMatMul(const OpKernelInfo& info) : OpKernel(info) {
+    scale_ = info.GetAttrOrDefault<float>("scale", 1.0f);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float scale_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    MultiLoraMatMul,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .MayInplace(1, 0),
+    MultiLoraMatMul);
+
+Status MultiLoraMatMul::Compute(OpKernelContext* context) const {
+  const Tensor* a = context->Input<Tensor>(0);
+  const Tensor* base_output = context->Input<Tensor>(1);
+  const Tensor* lora_a = context->Input<Tensor>(2);
+  const Tensor* lora_b = context->Input<Tensor>(3);
+  const Tensor* adapter_indices = context->Input<Tensor>(4);
+
+  const auto& a_shape = a->Shape();
+  const auto& base_output_shape = base_output->Shape();
+  const auto& lora_a_shape = lora_a->Shape();
+  const auto& lora_b_shape = lora_b->Shape();
+
+  const size_t rank_a = a_shape.NumDimensions();
+  ORT_RETURN_IF_NOT(rank_a >= 2, "A must have at least 2 dimensions, got ", a_shape);
+  ORT_RETURN_IF_NOT(lora_a_shape.NumDimensions() == 3 && lora_b_shape.NumDimensions() == 3,
+                    "lora_a and lora_b must have 3 dimensions, got ", lora_a_shape, " and ", lora_b_shape);
+
+  const int64_t batch_size = a_shape[0];
+  const int64_t k = a_shape[rank_a - 1];
+  const int64_t num_adapters = lora_a_shape[0];
+  const int64_t lora_rank = lora_a_shape[2];
+  const int64_t n = lora_b_shape[2];
+
+  ORT_RETURN_IF_NOT(lora_a_shape[1] == k, "lora_a shape ", lora_a_shape, " does not match K of A ", k);
+  ORT_RETURN_IF_NOT(lora_b_shape[0] == num_adapters && lora_b_shape[1] == lora_rank,
+                    "lora_b shape ", lora_b_shape, " does not match lora_a shape ", lora_a_shape);
+  // the leading dimensions must match one by one, the rows of each batch entry are selected by its adapter index
+  ORT_RETURN_IF_NOT(base_output_shape.NumDimensions() == rank_a &&
+                        base_output_shape.Slice(0, rank_a - 1) == a_shape.Slice(0, rank_a - 1) &&
+                        base_output_shape[rank_a - 1] == n,
+                    "base_output shape ", base_output_shape, " does not match A shape ", a_shape, " and N ", n);
+  ORT_RETURN_IF_NOT(adapter_indices->Shape().NumDimensions() == 1 && adapter_indices->Shape()[0] == batch_size,
+                    "adapter_indices must have shape (", batch_size, "), got ", adapter_indices->Shape());
+
+  Tensor* y = context->Output(0, base_output_shape);
+  float* y_data = y->MutableData<float>();
+  if (y_data != base_output->Data<float>()) {
+    memcpy(y_data, base_output->Data<float>(), base_output->SizeInBytes());
+  }
+
+  if (y->Shape().Size() == 0 || lora_rank == 0) {
+    return Status::OK();
+  }
+
+  const size_t rows_per_batch = SafeInt<size_t>(a_shape.SizeToDimension(rank_a - 1) / batch_size);
+  const size_t K = SafeInt<size_t>(k);
+  const size_t N = SafeInt<size_t>(n);
+  const size_t R = SafeInt<size_t>(lora_rank);
+
+  // find the segments of consecutive batch entries using the same adapter
+  const int32_t* indices = adapter_indices->Data<int32_t>();
+  InlinedVector<std::pair<size_t, size_t>> segments;  // begin and end batch entries
+  size_t max_segment_rows = 0;
+  for (size_t begin = 0, end; begin < static_cast<size_t>(batch_size); begin = end) {
+    const int32_t index = indices[begin];
+    ORT_RETURN_IF(index >= num_adapters, "adapter_indices[", begin, "] = ", index,
+                  " is out of range, there are ", num_adapters, " adapters.");
+    for (end = begin + 1; end < static_cast<size_t>(batch_size) && indices[end] == index; ++end) {
+    }
+
+    if (index >= 0) {
+      segments.emplace_back(begin, end);
+      max_segment_rows = std::max(max_segment_rows, (end - begin) * rows_per_batch);
+    }
+  }
+
+  if (segments.empty()) {
+    return Status::OK();
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  auto intermediate = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(max_segment_rows) * R);
+
+  const float* a_data = a->Data<float>();
+  const float* lora_a_data = lora_a->Data<float>();
+  const float* lora_b_data = lora_b->Data<float>();
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  for (const auto& [begin, end] : segments) {
+    const size_t index = static_cast<size_t>(indices[begin]);
+    const size_t first_row = begin * rows_per_batch;
+    const size_t rows = (end - begin) * rows_per_batch;
+
+    // project the rows of the segment to the low rank space of the adapter, then add the update to the base output
+    MlasGemm(CblasNoTrans, CblasNoTrans, rows, R, K,
+             1.0f, a_data + first_row * K, K,
+             lora_a_data + index * K * R, R,
+             0.0f, intermediate.get(), R, thread_pool);
+    MlasGemm(CblasNoTrans, CblasNoTrans, rows, N, R,
+             scale_, intermediate.get(), R,
+             lora_b_data + index * R * N, N,
+             1.0f, y_data + first_row * N, N, thread_pool);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
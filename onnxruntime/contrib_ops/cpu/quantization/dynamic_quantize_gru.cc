@@ -0,0 +1,324 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/narrow.h"
+#include "core/providers/cpu/rnn/deep_cpu_gru.h"
+#include "core/providers/cpu/rnn/rnn_helpers.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+using namespace rnn::detail;
+
+// GRU with 8-bit input and recurrent weights. The activations are quantized dynamically
+// on every GEMM (once for all inputs, and once per sequence step for Ht-1 and rt (.) Ht-1),
+// so the recurrent GEMMs of every step read 8-bit instead of fp32 weights.
+class DynamicQuantizeGRU : public OpKernel, public GRUBase {
+ public:
+  DynamicQuantizeGRU(const OpKernelInfo& info) : OpKernel(info), GRUBase(info) {}
+
+  Status PrePack(const Tensor& tensor, int input_idx,
+                 AllocatorPtr alloc, /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+  ~DynamicQuantizeGRU() override = default;
+
+ private:
+  Status TryPackInputWeights(const Tensor& weights, bool& is_packed, AllocatorPtr& alloc);
+
+  Status TryPackRecurrentWeights(const Tensor& weights, bool& is_packed, AllocatorPtr& alloc);
+
+  PackedWeights packed_W_;
+  // recurrent weights are split into the ZR and H column blocks so they can be applied separately.
+  PackedWeights packed_R_ZR_;
+  PackedWeights packed_R_H_;
+  bool is_W_signed_;
+  bool is_R_signed_;
+};
+
+// Pack the [K, N] column block starting at column 'col' of each direction of 'weights'
+// ([num_directions, K, ldb]) into 'packed_weights'.
+static Status PackWeightColumns(const Tensor& weights, size_t col, size_t N, bool is_weight_signed,
+                                PackedWeights& packed_weights, bool& is_packed, AllocatorPtr& alloc) {
+  const auto& shape = weights.Shape();
+  const size_t num_directions = static_cast<size_t>(shape[0]);
+  const size_t K = static_cast<size_t>(shape[1]);
+  const size_t ldb = static_cast<size_t>(shape[2]);
+
+  const size_t packed_weights_size = MlasGemmPackBSize(N, K, false /*AIsSigned*/, is_weight_signed);
+  if (packed_weights_size == 0) {
+    is_packed = false;
+    return Status::OK();
+  }
+
+  size_t packed_weights_data_size = SafeInt<size_t>(packed_weights_size) * num_directions;
+
+  packed_weights.buffer_ = IAllocator::MakeUniquePtr<void>(alloc, packed_weights_data_size, true);
+
+  auto* packed_weights_data = packed_weights.buffer_.get();
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we don not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_weights_data, 0, packed_weights_data_size);
+
+  packed_weights.buffer_size_ = packed_weights_data_size;
+  packed_weights.weights_size_ = packed_weights_size;
+  packed_weights.shape_ = shape;
+
+  const auto* weights_data = static_cast<const uint8_t*>(weights.DataRaw()) + col;
+  for (size_t i = 0; i < num_directions; i++) {
+    MlasGemmPackB(N, K, weights_data, ldb, false /*AIsSigned*/, is_weight_signed, packed_weights_data);
+    packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
+    weights_data += K * ldb;
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status DynamicQuantizeGRU::TryPackInputWeights(const Tensor& weights, bool& is_packed, AllocatorPtr& alloc) {
+  is_packed = false;
+
+  // weights: [num_directions, input_size, 3*hidden_size]
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3 || shape[0] != num_directions_ || shape[2] != static_cast<int64_t>(hidden_size_) * 3) {
+    return Status::OK();
+  }
+
+  is_W_signed_ = weights.IsDataType<int8_t>();
+  return PackWeightColumns(weights, 0, static_cast<size_t>(shape[2]), is_W_signed_, packed_W_, is_packed, alloc);
+}
+
+Status DynamicQuantizeGRU::TryPackRecurrentWeights(const Tensor& weights, bool& is_packed, AllocatorPtr& alloc) {
+  is_packed = false;
+
+  // recurrence weights: [num_directions, hidden_size, 3*hidden_size]
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3 || shape[0] != num_directions_ || shape[1] != hidden_size_ ||
+      shape[2] != static_cast<int64_t>(hidden_size_) * 3) {
+    return Status::OK();
+  }
+
+  is_R_signed_ = weights.IsDataType<int8_t>();
+
+  const size_t hidden_size = static_cast<size_t>(hidden_size_);
+  bool is_ZR_packed = false;
+  ORT_RETURN_IF_ERROR(PackWeightColumns(weights, 0, 2 * hidden_size, is_R_signed_, packed_R_ZR_, is_ZR_packed, alloc));
+  if (!is_ZR_packed) {
+    return Status::OK();
+  }
+
+  bool is_H_packed = false;
+  ORT_RETURN_IF_ERROR(PackWeightColumns(weights, 2 * hidden_size, hidden_size, is_R_signed_, packed_R_H_, is_H_packed, alloc));
+  if (!is_H_packed) {
+    packed_R_ZR_.buffer_.reset();
+    return Status::OK();
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status DynamicQuantizeGRU::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                   /*out*/ bool& is_packed,
+                                   /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  const bool share_prepacked_weights = (prepacked_weights != nullptr);
+
+  if (input_idx == 1) {
+    ORT_RETURN_IF_ERROR(TryPackInputWeights(tensor, is_packed, alloc));
+
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_W_.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_W_.buffer_size_);
+    }
+  } else if (input_idx == 2) {
+    ORT_RETURN_IF_ERROR(TryPackRecurrentWeights(tensor, is_packed, alloc));
+
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_R_ZR_.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_R_ZR_.buffer_size_);
+      prepacked_weights->buffers_.push_back(std::move(packed_R_H_.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_R_H_.buffer_size_);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DynamicQuantizeGRU::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                     int input_idx,
+                                                     /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_W_.buffer_ = std::move(prepacked_buffers[0]);
+  } else if (input_idx == 2) {
+    used_shared_buffers = true;
+    packed_R_ZR_.buffer_ = std::move(prepacked_buffers[0]);
+    packed_R_H_.buffer_ = std::move(prepacked_buffers[1]);
+  }
+
+  return Status::OK();
+}
+
+// Check the scale or zero point of a weight has shape [num_directions] for per-tensor
+// quantization, or [num_directions, 3*hidden_size] for per-channel quantization.
+static Status CheckQuantizationParameterShape(const TensorShape& shape, int64_t num_directions, int64_t hidden_size,
+                                              const char* name) {
+  if ((shape.NumDimensions() != 1 && shape.NumDimensions() != 2) ||
+      (shape.NumDimensions() == 2 && shape[1] != hidden_size * 3) ||
+      shape[0] != num_directions) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input ", name, " must have shape {", num_directions, "} for per-tensor/layer quantization or shape {",
+                           num_directions, ", 3*", hidden_size, "} for per-channel quantization. Actual:", shape);
+  }
+
+  return Status::OK();
+}
+
+// The MLAS quantized GEMM only supports a single zero point for B, so per-channel zero points
+// must be constant. Signed weights must be symmetric.
+static Status CheckWeightZeroPoint(const Tensor& zp, bool is_weight_signed, const char* name) {
+  if (zp.Shape().NumDimensions() != 2) {
+    return Status::OK();
+  }
+
+  const int64_t zp_size = zp.Shape().Size();
+  const uint8_t* zp_data = static_cast<const uint8_t*>(zp.DataRaw());
+  for (int64_t i = 0; i < zp_size; i++) {
+    if (is_weight_signed && zp_data[i] != 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "DynamicQuantizeGRU : ", name, " zero point must be zero");
+    }
+
+    if (!is_weight_signed && zp_data[i] != zp_data[0]) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "DynamicQuantizeGRU : ", name, " zero point must be constant");
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DynamicQuantizeGRU::Compute(OpKernelContext* context) const {
+  // weights. [num_directions, input_size, 3*hidden_size]
+  const Tensor* W = packed_W_.buffer_ ? nullptr : context->Input<Tensor>(1);
+  // recurrence weights. [num_directions, hidden_size, 3*hidden_size]
+  const Tensor* R = packed_R_ZR_.buffer_ ? nullptr : context->Input<Tensor>(2);
+
+  const auto& W_shape = (W != nullptr) ? W->Shape() : packed_W_.shape_;
+  const auto& R_shape = (R != nullptr) ? R->Shape() : packed_R_ZR_.shape_;
+
+  if (W_shape.NumDimensions() != 3 || R_shape.NumDimensions() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input W and R must have rank 3. W: ", W_shape,
+                           " R: ", R_shape);
+  }
+
+  // the weights are stored as [K, N] for the quantized GEMM, whereas the GRU validation expects [N, K]
+  ORT_RETURN_IF_ERROR(ValidateInputs(*context,
+                                     TensorShape{W_shape[0], W_shape[2], W_shape[1]},
+                                     TensorShape{R_shape[0], R_shape[2], R_shape[1]}));
+
+  const Tensor* w_scale = context->Input<Tensor>(6);
+  const Tensor* w_zp = context->Input<Tensor>(7);
+  const Tensor* r_scale = context->Input<Tensor>(8);
+  const Tensor* r_zp = context->Input<Tensor>(9);
+
+  ORT_RETURN_IF_ERROR(CheckQuantizationParameterShape(w_scale->Shape(), num_directions_, hidden_size_, "W_scale"));
+  ORT_RETURN_IF_ERROR(CheckQuantizationParameterShape(w_zp->Shape(), num_directions_, hidden_size_, "W_zero_point"));
+  ORT_RETURN_IF_ERROR(CheckQuantizationParameterShape(r_scale->Shape(), num_directions_, hidden_size_, "R_scale"));
+  ORT_RETURN_IF_ERROR(CheckQuantizationParameterShape(r_zp->Shape(), num_directions_, hidden_size_, "R_zero_point"));
+
+  const bool is_W_signed = (W != nullptr) ? W->IsDataType<int8_t>() : is_W_signed_;
+  const bool is_R_signed = (R != nullptr) ? R->IsDataType<int8_t>() : is_R_signed_;
+
+  ORT_RETURN_IF_ERROR(CheckWeightZeroPoint(*w_zp, is_W_signed, "W"));
+  ORT_RETURN_IF_ERROR(CheckWeightZeroPoint(*r_zp, is_R_signed, "R"));
+
+  const bool is_W_per_channel = w_scale->Shape().NumDimensions() == 2;
+  const bool is_R_per_channel = r_scale->Shape().NumDimensions() == 2;
+  const size_t hidden_size = static_cast<size_t>(hidden_size_);
+
+  const size_t W_scale_size = is_W_per_channel ? 3 * hidden_size : 1;
+  const size_t R_scale_size = is_R_per_channel ? 3 * hidden_size : 1;
+
+  // the ZR and H blocks of R use the matching slice of the per-channel scales
+  const size_t R_ZR_scale_size = is_R_per_channel ? 2 * hidden_size : 1;
+  const size_t R_H_scale_size = is_R_per_channel ? hidden_size : 1;
+  const size_t R_H_scale_offset = is_R_per_channel ? 2 * hidden_size : 0;
+
+  const float* W_scale_data = w_scale->Data<float>();
+  const float* R_scale_data = r_scale->Data<float>();
+  const uint8_t* W_zp_data = static_cast<const uint8_t*>(w_zp->DataRaw());
+  const uint8_t* R_zp_data = static_cast<const uint8_t*>(r_zp->DataRaw());
+
+  const uint8_t* W_data = W != nullptr ? static_cast<const uint8_t*>(W->DataRaw()) : nullptr;
+  const uint8_t* R_data = R != nullptr ? static_cast<const uint8_t*>(R->DataRaw()) : nullptr;
+
+  const size_t W_size_per_direction = SafeInt<size_t>(W_shape[1]) * W_shape[2];
+  const size_t R_size_per_direction = SafeInt<size_t>(R_shape[1]) * R_shape[2];
+  const size_t R_ld = 3 * hidden_size;
+
+  // spans for first direction
+  QuantizationParameter quant_para_W_1(W_scale_data, W_zp_data, is_W_signed, W_scale_size);
+  QuantizationParameter quant_para_R_ZR_1(R_scale_data, R_zp_data, is_R_signed, R_ZR_scale_size);
+  QuantizationParameter quant_para_R_H_1(R_scale_data + R_H_scale_offset, R_zp_data + R_H_scale_offset,
+                                         is_R_signed, R_H_scale_size);
+
+  GemmWeights<uint8_t> W_1(0, W_data, W_size_per_direction, packed_W_, &quant_para_W_1);
+  GemmWeights<uint8_t> R_ZR_1(0, R_data, R_size_per_direction, packed_R_ZR_, &quant_para_R_ZR_1);
+  GemmWeights<uint8_t> R_H_1(0, R_data != nullptr ? R_data + 2 * hidden_size : nullptr, R_size_per_direction,
+                             packed_R_H_, &quant_para_R_H_1);
+  R_ZR_1.ldb_ = R_ld;
+  R_H_1.ldb_ = R_ld;
+
+  GemmWeights<uint8_t> W_2;
+  GemmWeights<uint8_t> R_ZR_2;
+  GemmWeights<uint8_t> R_H_2;
+
+  QuantizationParameter quant_para_W_2(quant_para_W_1);
+  QuantizationParameter quant_para_R_ZR_2(quant_para_R_ZR_1);
+  QuantizationParameter quant_para_R_H_2(quant_para_R_H_1);
+
+  if (direction_ == Direction::kBidirectional) {
+    // zero_point and scale have same size
+    quant_para_W_2.scale += W_scale_size;
+    quant_para_W_2.zero_point += W_scale_size;
+    quant_para_R_ZR_2.scale += R_scale_size;
+    quant_para_R_ZR_2.zero_point += R_scale_size;
+    quant_para_R_H_2.scale += R_scale_size;
+    quant_para_R_H_2.zero_point += R_scale_size;
+
+    W_2.Init(1, W_data, W_size_per_direction, packed_W_, &quant_para_W_2);
+    R_ZR_2.Init(1, R_data, R_size_per_direction, packed_R_ZR_, &quant_para_R_ZR_2);
+    R_H_2.Init(1, R_data != nullptr ? R_data + 2 * hidden_size : nullptr, R_size_per_direction,
+               packed_R_H_, &quant_para_R_H_2);
+    R_ZR_2.ldb_ = R_ld;
+    R_H_2.ldb_ = R_ld;
+  }
+
+  return GRUBase::ComputeImpl<uint8_t>(*context, W_1, W_2, R_ZR_1, R_H_1, R_ZR_2, R_H_2);
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    DynamicQuantizeGRU,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int32_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}),
+    DynamicQuantizeGRU);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -8,15 +8,88 @@ namespace profiling {
 using namespace std::chrono;
 
 std::atomic<size_t> Profiler::global_max_num_events_{1000 * 1000};
+std::atomic<uint64_t> Profiler::next_instance_id_{0};
+thread_local const Profiler* Profiler::unsampled_profiler_ = nullptr;
+
+namespace {
+
+// Writes an event as a "complete event (X)" in chrome tracing format.
+void WriteEvent(std::ostream& stream, const EventRecord& rec) {
+  stream << R"({"cat" : ")" << event_category_names_[rec.cat] << "\",";
+  stream << "\"pid\" :" << rec.pid << ",";
+  stream << "\"tid\" :" << rec.tid << ",";
+  stream << "\"dur\" :" << rec.dur << ",";
+  stream << "\"ts\" :" << rec.ts << ",";
+  stream << R"("ph" : "X",)";
+  stream << R"("name" :")" << rec.name << "\",";
+  stream << "\"args\" : {";
+  bool is_first_arg = true;
+  for (std::pair<std::string, std::string> event_arg : rec.args) {
+    if (!is_first_arg) stream << ",";
+    if (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '[')) {
+      stream << "\"" << event_arg.first << "\" : " << event_arg.second << "";
+    } else {
+      stream << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
+    }
+    is_first_arg = false;
+  }
+  stream << "}}";
+}
+
+}  // namespace
+
+bool Profiler::ThreadEventBuffer::Push(EventRecord&& event) {
+  const size_t h = head.load(std::memory_order_relaxed);
+  if (h - tail.load(std::memory_order_acquire) == events.size()) {
+    num_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  events[h % events.size()] = std::move(event);
+  head.store(h + 1, std::memory_order_release);
+  return true;
+}
+
+bool Profiler::ThreadEventBuffer::IsFull() const {
+  return head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire) == events.size();
+}
+
+void Profiler::ThreadEventBuffer::Drain(Events& out) {
+  const size_t t = tail.load(std::memory_order_relaxed);
+  const size_t h = head.load(std::memory_order_acquire);
+  for (size_t i = t; i != h; ++i) {
+    out.emplace_back(std::move(events[i % events.size()]));
+  }
+  tail.store(h, std::memory_order_release);
+}
+
+Profiler::RunScope::RunScope(const Profiler& profiler) : prev_unsampled_profiler_(unsampled_profiler_) {
+  if (profiler.enabled_ && profiler.sampling_rate_ > 1) {
+    is_sampled_ = profiler.num_runs_.fetch_add(1, std::memory_order_relaxed) % profiler.sampling_rate_ == 0;
+    unsampled_profiler_ = is_sampled_ ? nullptr : &profiler;
+  }
+}
+
+Profiler::RunScope::RunScope(const Profiler& profiler, bool is_sampled)
+    : prev_unsampled_profiler_(unsampled_profiler_), is_sampled_(is_sampled) {
+  unsampled_profiler_ = is_sampled_ ? nullptr : &profiler;
+}
+
+Profiler::RunScope::~RunScope() {
+  unsampled_profiler_ = prev_unsampled_profiler_;
+}
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
 Profiler* Profiler::instance_ = nullptr;
 
 profiling::Profiler::~Profiler() {
+  StopFlushThread();
   instance_ = nullptr;
 }
 #else
-profiling::Profiler::~Profiler() {}
+profiling::Profiler::~Profiler() {
+  StopFlushThread();
+}
 #endif
 
 ::onnxruntime::TimePoint profiling::Profiler::Start() {
@@ -42,6 +115,18 @@ void Profiler::Initialize(const logging::Logger* session_logger) {
 #endif
 }
 
+void Profiler::SetSamplingRate(size_t sampling_rate) {
+  ORT_ENFORCE(!enabled_, "The sampling rate must be set before starting profiling.");
+  ORT_ENFORCE(sampling_rate > 0, "The sampling rate must be positive.");
+  sampling_rate_ = sampling_rate;
+}
+
+void Profiler::SetStreaming(std::chrono::milliseconds flush_interval) {
+  ORT_ENFORCE(!enabled_, "Streaming must be set before starting profiling.");
+  streaming_ = true;
+  flush_interval_ = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(flush_interval);
+}
+
 void Profiler::StartProfiling(const logging::Logger* custom_logger) {
   ORT_ENFORCE(custom_logger != nullptr);
   enabled_ = true;
@@ -61,6 +146,16 @@ void Profiler::StartProfiling(const std::basic_string<T>& file_name) {
 #endif
   profile_stream_file_ = ToUTF8String(file_name);
   profiling_start_time_ = std::chrono::high_resolution_clock::now();
+  if (streaming_) {
+    // an unterminated array is still accepted by the trace viewers if the process exits before EndProfiling
+    profile_stream_ << "[\n";
+    num_streamed_events_ = 0;
+#if !defined(__wasm__) || defined(__EMSCRIPTEN_PTHREADS__)
+    // without threads the buffers are flushed by the recording thread when they are full, see EndTimeAndRecordEvent
+    stop_flushing_ = false;
+    flush_thread_ = std::thread(&Profiler::FlushLoop, this);
+#endif
+  }
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->StartProfiling(profiling_start_time_);
   }
@@ -75,14 +170,34 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
                                      const std::string& event_name,
                                      const TimePoint& start_time,
                                      const std::initializer_list<std::pair<std::string, std::string>>& event_args,
+                                     bool sync_gpu) {
+  EndTimeAndRecordEvent(category, event_name, start_time,
+                        std::unordered_map<std::string, std::string>(event_args.begin(), event_args.end()), sync_gpu);
+}
+
+void Profiler::EndTimeAndRecordEvent(EventCategory category,
+                                     const std::string& event_name,
+                                     const TimePoint& start_time,
+                                     std::unordered_map<std::string, std::string>&& event_args,
                                      bool /*sync_gpu*/) {
   long long dur = TimeDiffMicroSeconds(start_time);
   long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
 
   EventRecord event(category, logging::GetProcessId(),
-                    logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
+                    logging::GetThreadId(), event_name, ts, dur, std::move(event_args));
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
+  } else if (streaming_) {
+    // written to the file by the flush thread
+    auto& buffer = GetThreadEventBuffer();
+#if defined(__wasm__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    // there is no flush thread, flush the buffer on this thread instead of dropping events
+    if (buffer.IsFull()) {
+      std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+      FlushThreadEventBuffers();
+    }
+#endif
+    buffer.Push(std::move(event));
   } else {
     // TODO: sync_gpu if needed.
     std::lock_guard<std::mutex> lock(mutex_);
@@ -102,6 +217,99 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
   }
 }
 
+void Profiler::AccumulateCounters(const std::string& group,
+                                  std::initializer_list<std::pair<const char*, uint64_t>> counters) {
+  std::lock_guard<std::mutex> lock(counters_mutex_);
+  auto& accumulated = accumulated_counters_[group];
+  if (accumulated.totals.empty()) {
+    accumulated.totals.assign(counters.begin(), counters.end());
+  } else {
+    ORT_ENFORCE(accumulated.totals.size() == counters.size(), "Counters of group ", group, " changed.");
+    size_t i = 0;
+    for (const auto& counter : counters) {
+      accumulated.totals[i++].second += counter.second;
+    }
+  }
+  ++accumulated.count;
+}
+
+void Profiler::AddAccumulatedCounterEvents(Events& events) {
+  std::lock_guard<std::mutex> lock(counters_mutex_);
+  const long long ts = TimeDiffMicroSeconds(profiling_start_time_);
+  for (const auto& [group, accumulated] : accumulated_counters_) {
+    std::unordered_map<std::string, std::string> args;
+    args.emplace("count", std::to_string(accumulated.count));
+    for (const auto& [name, total] : accumulated.totals) {
+      args.emplace(name, std::to_string(total));
+    }
+    events.emplace_back(SESSION_EVENT, logging::GetProcessId(), logging::GetThreadId(), group, ts, 0,
+                        std::move(args));
+  }
+  accumulated_counters_.clear();
+}
+
+Profiler::ThreadEventBuffer& Profiler::GetThreadEventBuffer() {
+  // cache the buffer of the last profiler used by the thread to avoid the lock in the common case
+  thread_local uint64_t cached_instance_id = 0;
+  thread_local ThreadEventBuffer* cached_buffer = nullptr;
+
+  if (cached_instance_id != instance_id_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& buffer = thread_event_buffers_[std::this_thread::get_id()];
+    if (!buffer) {
+      buffer = std::make_unique<ThreadEventBuffer>(kStreamingBufferCapacity);
+    }
+
+    cached_instance_id = instance_id_;
+    cached_buffer = buffer.get();
+  }
+
+  return *cached_buffer;
+}
+
+void Profiler::FlushThreadEventBuffers() {
+  Events events;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : thread_event_buffers_) {
+      entry.second->Drain(events);
+    }
+  }
+
+  WriteStreamedEvents(events);
+  profile_stream_.flush();
+}
+
+void Profiler::FlushLoop() {
+  std::unique_lock<std::mutex> lock(flush_mutex_);
+  while (!stop_flushing_) {
+    flush_cv_.wait_for(lock, flush_interval_, [this]() { return stop_flushing_; });
+    FlushThreadEventBuffers();
+  }
+}
+
+void Profiler::StopFlushThread() {
+  if (!flush_thread_.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    stop_flushing_ = true;
+  }
+  flush_cv_.notify_one();
+  flush_thread_.join();
+}
+
+void Profiler::WriteStreamedEvents(const Events& events) {
+  for (const auto& event : events) {
+    if (num_streamed_events_++ > 0) {
+      profile_stream_ << ",\n";
+    }
+    WriteEvent(profile_stream_, event);
+  }
+}
+
 std::string Profiler::EndProfiling() {
   if (!enabled_) {
     return std::string();
@@ -115,38 +323,53 @@ std::string Profiler::EndProfiling() {
     LOGS(*session_logger_, INFO) << "Writing profiler data to file " << profile_stream_file_;
   }
 
+  if (streaming_) {
+    StopFlushThread();
+    std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+    FlushThreadEventBuffers();
+
+    Events end_events;
+    for (const auto& ep_profiler : ep_profilers_) {
+      ep_profiler->EndProfiling(profiling_start_time_, end_events);
+    }
+    AddAccumulatedCounterEvents(end_events);
+    WriteStreamedEvents(end_events);
+    profile_stream_ << "\n]\n";
+
+    size_t num_dropped = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& entry : thread_event_buffers_) {
+        num_dropped += entry.second->num_dropped.load();
+      }
+    }
+
+    if (num_dropped > 0 && session_logger_) {
+      LOGS(*session_logger_, WARNING) << num_dropped << " profile events were dropped as they were recorded faster "
+                                      << "than they were flushed.";
+    }
+
+#if !defined(__wasm__)
+    profile_stream_.close();
+#endif
+    enabled_ = false;
+    return profile_stream_file_;
+  }
+
   std::lock_guard<std::mutex> lock(mutex_);
   profile_stream_ << "[\n";
 
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->EndProfiling(profiling_start_time_, events_);
   }
+  AddAccumulatedCounterEvents(events_);
 
   for (size_t i = 0; i < events_.size(); ++i) {
-    auto& rec = events_[i];
-    profile_stream_ << R"({"cat" : ")" << event_category_names_[rec.cat] << "\",";
-    profile_stream_ << "\"pid\" :" << rec.pid << ",";
-    profile_stream_ << "\"tid\" :" << rec.tid << ",";
-    profile_stream_ << "\"dur\" :" << rec.dur << ",";
-    profile_stream_ << "\"ts\" :" << rec.ts << ",";
-    profile_stream_ << R"("ph" : "X",)";
-    profile_stream_ << R"("name" :")" << rec.name << "\",";
-    profile_stream_ << "\"args\" : {";
-    bool is_first_arg = true;
-    for (std::pair<std::string, std::string> event_arg : rec.args) {
-      if (!is_first_arg) profile_stream_ << ",";
-      if (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '[')) {
-        profile_stream_ << "\"" << event_arg.first << "\" : " << event_arg.second << "";
-      } else {
-        profile_stream_ << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
-      }
-      is_first_arg = false;
-    }
-    profile_stream_ << "}";
+    WriteEvent(profile_stream_, events_[i]);
     if (i == events_.size() - 1) {
-      profile_stream_ << "}\n";
+      profile_stream_ << "\n";
     } else {
-      profile_stream_ << "},\n";
+      profile_stream_ << ",\n";
     }
   }
   profile_stream_ << "]\n";
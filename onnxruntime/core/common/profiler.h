@@ -4,10 +4,16 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <initializer_list>
 #include <iostream>
+#include <memory>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include "core/common/profiler_common.h"
 #include "core/common/logging/logging.h"
@@ -49,6 +55,39 @@ class Profiler {
   template <typename T>
   void StartProfiling(const std::basic_string<T>& file_name);
 
+  /*
+  Record the events of 1 in sampling_rate runs only. Events recorded outside of runs, e.g. during session
+  initialization, are always recorded. Must be called before starting profiling.
+  */
+  void SetSamplingRate(size_t sampling_rate);
+
+  /*
+  Stream the profile data to the file instead of accumulating all the events until EndProfiling.
+  Each thread records its events in a ring buffer of bounded size and a background thread appends the buffers to the
+  file every flush_interval. Events recorded while the buffer of the thread is full are dropped.
+  Must be called before starting profiling to a file.
+  */
+  void SetStreaming(std::chrono::milliseconds flush_interval);
+
+  /*
+  Decides whether the events of a run are recorded when sampling runs. IsEnabled() reflects the decision on the
+  thread that constructs it, until it is destroyed. The parts of the run executed by other threads apply the same
+  decision with the second constructor, see IsSampled().
+  */
+  class RunScope {
+   public:
+    explicit RunScope(const Profiler& profiler);
+    RunScope(const Profiler& profiler, bool is_sampled);
+    ~RunScope();
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunScope);
+
+    bool IsSampled() const { return is_sampled_; }
+
+   private:
+    const Profiler* prev_unsampled_profiler_;
+    bool is_sampled_{true};
+  };
+
   /*
   Start profiling and return current time point.
   */
@@ -58,7 +97,7 @@ class Profiler {
   Whether data collection and output from this profiler is enabled.
   */
   bool IsEnabled() const {
-    return enabled_;
+    return enabled_ && unsampled_profiler_ != this;
   }
   /*
   Return the stored start time of profiler.
@@ -80,6 +119,23 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Same as above, for event args that are not all known at compile time.
+  */
+  void EndTimeAndRecordEvent(EventCategory category,
+                             const std::string& event_name,
+                             const TimePoint& start_time,
+                             std::unordered_map<std::string, std::string>&& event_args,
+                             bool sync_gpu = false);
+
+  /*
+  Add counters to the totals of a group of events, e.g. the hardware counters of the kernels of an op type with
+  given input shapes. The totals of each group and the number of times it was added to are written as one event
+  when profiling ends.
+  */
+  void AccumulateCounters(const std::string& group,
+                          std::initializer_list<std::pair<const char*, uint64_t>> counters);
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -122,6 +178,35 @@ class Profiler {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  // Ring buffer of the events recorded by a thread when streaming. The thread is the only producer and the thread
+  // flushing the buffers, holding flush_mutex_, the only consumer.
+  struct ThreadEventBuffer {
+    explicit ThreadEventBuffer(size_t capacity) : events(capacity) {}
+
+    bool Push(EventRecord&& event);
+    bool IsFull() const;
+    void Drain(Events& out);
+
+    std::vector<EventRecord> events;
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+    std::atomic<size_t> num_dropped{0};
+  };
+
+  // Maximum number of unflushed events per thread when streaming
+  static constexpr size_t kStreamingBufferCapacity = 4 * 1024;
+
+  ThreadEventBuffer& GetThreadEventBuffer();
+
+  // Writes the events recorded by all threads to the profile file. flush_mutex_ must be held.
+  void FlushThreadEventBuffers();
+
+  // Flushes the event buffers every flush_interval_ until stop_flushing_ is set.
+  void FlushLoop();
+  void StopFlushThread();
+
+  void WriteStreamedEvents(const Events& events);
+
   /**
    * The maximum number of profiler records to collect.
    * This value is used to initialize the per-profiler maximum.
@@ -151,6 +236,36 @@ class Profiler {
   bool profile_with_logger_{false};
   const size_t max_num_events_{global_max_num_events_.load()};
 
+  // Appends an event per group of accumulated counters.
+  void AddAccumulatedCounterEvents(Events& events);
+
+  struct AccumulatedCounters {
+    uint64_t count{0};
+    std::vector<std::pair<const char*, uint64_t>> totals;
+  };
+
+  std::mutex counters_mutex_;
+  std::unordered_map<std::string, AccumulatedCounters> accumulated_counters_;
+
+  // sampling of runs
+  size_t sampling_rate_{1};
+  mutable std::atomic<uint64_t> num_runs_{0};
+  // the profiler whose current run on this thread is not sampled, if any
+  static thread_local const Profiler* unsampled_profiler_;
+
+  // streaming
+  bool streaming_{false};
+  std::chrono::high_resolution_clock::duration flush_interval_{};
+  std::mutex flush_mutex_;
+  std::condition_variable flush_cv_;
+  bool stop_flushing_{false};
+  std::thread flush_thread_;
+  std::unordered_map<std::thread::id, std::unique_ptr<ThreadEventBuffer>> thread_event_buffers_;
+  size_t num_streamed_events_{0};
+  // identifies the profiler in the per-thread cache of event buffers, as addresses may be reused
+  static std::atomic<uint64_t> next_instance_id_;
+  const uint64_t instance_id_{++next_instance_id_};
+
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
   static Profiler* instance_;
 #endif
@@ -8,6 +8,7 @@
 #include <sstream>
 #include <ctime>
 #include <iomanip>
+#include <limits>
 #include "core/common/exceptions.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
@@ -17,6 +18,7 @@
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/mldata_type_utils.h"
+#include "core/framework/node_cost_model.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
@@ -226,6 +228,16 @@ class PlannerImpl {
   // they became free (more recently freed earlier in the list).
   std::list<FreeBufferInfo> freelist_;
 
+  // A freed buffer is only reused for a smaller value if it is at most this many times larger. Reusing a much larger
+  // buffer would keep it from a later value that needs it and cause a new allocation there.
+#if defined(ENABLE_TRAINING)
+  // with only_execute_path_to_fetches a reused buffer whose producer did not run is allocated with the shape of the
+  // value reusing it, which may be smaller than what other values reusing the buffer need.
+  static constexpr double kMaxReusedBufferSizeRatio = 1.0;
+#else
+  static constexpr double kMaxReusedBufferSizeRatio = 2.0;
+#endif
+
   OrtValueIndex Index(const OrtValueName& name) {
     OrtValueIndex result;
     auto status = ort_value_name_idx_map_.GetIdx(name, result);
@@ -532,6 +544,71 @@ class PlannerImpl {
     */
   }
 
+  // Split a shape into the product of its known dimensions and the names of its symbolic dimensions.
+  // Returns false if a dimension is neither known nor named, or the product overflows.
+  static bool SplitShape(const TensorShapeProto& shape, uint64_t& known_size,
+                         InlinedVector<std::string_view>& dim_params) {
+    known_size = 1;
+    for (int i = 0, rank = shape.dim_size(); i < rank; i++) {
+      const auto& dim = shape.dim(i);
+      if (utils::HasDimValue(dim) && dim.dim_value() >= 0) {
+        const auto value = static_cast<uint64_t>(dim.dim_value());
+        if (value != 0 && known_size > std::numeric_limits<uint64_t>::max() / value) {
+          return false;
+        }
+        known_size *= value;
+      } else if (utils::HasDimParam(dim) && !dim.dim_param().empty()) {
+        dim_params.push_back(dim.dim_param());
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /*! \brief Check if a buffer planned for buffer_arg can hold arg for every value of the symbolic dimensions.
+   * The symbolic dimensions of arg need to match symbolic dimensions of the buffer, which scale both sizes by the
+   * same factor. The remaining dimensions of both need to be known.
+   * \param size_ratio receives the size of the buffer divided by the size of arg.
+   */
+  static bool FitsInBuffer(const TensorShapeProto& buffer_shape, const onnxruntime::NodeArg& buffer_arg,
+                           const TensorShapeProto& shape, const onnxruntime::NodeArg& arg, double& size_ratio) {
+    // see SameSize for why strings are excluded. the element sizes need to be the same as the execution frame
+    // checks the number of elements of the buffer when reusing it.
+    if (buffer_arg.TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        arg.TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        GetElementSize(buffer_arg.Type()) != GetElementSize(arg.Type())) {
+      return false;
+    }
+
+    uint64_t buffer_known_size = 0;
+    uint64_t known_size = 0;
+    InlinedVector<std::string_view> buffer_dim_params;
+    InlinedVector<std::string_view> dim_params;
+    if (!SplitShape(buffer_shape, buffer_known_size, buffer_dim_params) ||
+        !SplitShape(shape, known_size, dim_params)) {
+      return false;
+    }
+
+    // a symbolic dimension that is only in the buffer may be 0, so every one must cancel out
+    if (buffer_dim_params.size() != dim_params.size()) {
+      return false;
+    }
+
+    std::sort(buffer_dim_params.begin(), buffer_dim_params.end());
+    std::sort(dim_params.begin(), dim_params.end());
+    if (buffer_dim_params != dim_params) {
+      return false;
+    }
+
+    if (known_size == 0 || buffer_known_size < known_size) {
+      return false;
+    }
+
+    size_ratio = static_cast<double>(buffer_known_size) / static_cast<double>(known_size);
+    return true;
+  }
+
   static bool OutputHasConsumerNode(const Node& node, int output_idx) {
     // there will be an edge to all consumer nodes.
     // if consumed in a subgraph the edge will be to an implicit input of the node containing the subgraph.
@@ -550,7 +627,8 @@ class PlannerImpl {
     return SameSize(*p_shape1, arg1, *p_shape2, arg2);
   }
 
-  // Find if freelist contains a buffer of the same size as output_arg
+  // Find if freelist contains a buffer that can hold output_arg. A buffer of the same size is used if there is one,
+  // otherwise the smallest buffer that is at most kMaxReusedBufferSizeRatio times larger.
   bool FindReusableTensor(const onnxruntime::NodeArg& output_arg, OrtValueIndex* reusable_tensor) {
     if (!context_->GetEnableMemoryReuse()) {
       return false;
@@ -559,6 +637,9 @@ class PlannerImpl {
     if (nullptr == p_required_buffer_shape || p_required_buffer_shape->dim_size() == 0) return false;
     auto& required_memory_info = AllocPlan(output_arg.Name()).location;
 
+    auto best_fit = freelist_.end();
+    double best_fit_ratio = kMaxReusedBufferSizeRatio;
+
     for (auto it = freelist_.begin(); it != freelist_.end(); ++it) {
       size_t reusable = static_cast<size_t>(it->ml_value);
       const onnxruntime::NodeArg* p_node_arg = ort_value_info_.at(reusable).p_def_site;
@@ -586,8 +667,23 @@ class PlannerImpl {
           freelist_.erase(it);
           return true;
         }
+
+        double size_ratio = 0.0;
+        if (FitsInBuffer(*p_available_buffer_shape, *p_node_arg, *p_required_buffer_shape, output_arg,
+                         size_ratio) &&
+            size_ratio <= best_fit_ratio && (best_fit == freelist_.end() || size_ratio < best_fit_ratio)) {
+          best_fit = it;
+          best_fit_ratio = size_ratio;
+        }
       }
     }
+
+    if (best_fit != freelist_.end()) {
+      *reusable_tensor = best_fit->ml_value;
+      freelist_.erase(best_fit);
+      return true;
+    }
+
     return false;
   }
 
@@ -1810,6 +1906,225 @@ class PlannerImpl {
     }
   }
 
+  // Build the dataflow graph of the nodes for dataflow execution in parallel execution mode.
+  // A node depends on the producers of its inputs and on the sources of its control edges. If its kernel writes one
+  // of its inputs in place, it is also ordered with the other consumers of that input as in the execution order.
+  Status BuildDataflowGraph() {
+    if (!context_->IsDataflowExecutionEnabled() || parent_node_ != nullptr || graph_viewer_.NumberOfNodes() == 0) {
+      return Status::OK();
+    }
+
+    // nodes on devices with streams are synchronized through the notifications of the logic streams
+    for (const auto& stream : plan_.execution_plan) {
+      if (stream && stream->device_.Type() != OrtDevice::CPU) {
+        return Status::OK();
+      }
+    }
+#ifdef ORT_ENABLE_STREAM
+    if (!plan_.notification_owners.empty()) {
+      return Status::OK();
+    }
+#endif
+
+    const auto& execution_order = graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder());
+    const size_t num_nodes = execution_order.size();
+    constexpr size_t kNoProducer = std::numeric_limits<size_t>::max();
+
+    InlinedVector<size_t> node_positions(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1, kNoProducer);
+    for (size_t position = 0; position < num_nodes; ++position) {
+      node_positions[execution_order[position]] = position;
+    }
+
+    const auto for_each_input = [](const Node& node, const auto& fn) {
+      for (const auto* input : node.InputDefs()) {
+        if (input->Exists()) {
+          fn(*input);
+        }
+      }
+      for (const auto* input : node.ImplicitInputDefs()) {
+        if (input->Exists()) {
+          fn(*input);
+        }
+      }
+    };
+
+    // producer and consumers of each value, by position in execution order
+    const size_t num_values = SafeInt<size_t>(ort_value_name_idx_map_.MaxIdx()) + 1;
+    InlinedVector<size_t> value_producers(num_values, kNoProducer);
+    std::vector<InlinedVector<size_t>> value_consumers(num_values);
+    for (size_t position = 0; position < num_nodes; ++position) {
+      const auto* node = graph_viewer_.GetNode(execution_order[position]);
+      for (const auto* output : node->OutputDefs()) {
+        if (output->Exists()) {
+          value_producers[Index(output->Name())] = position;
+        }
+      }
+      for_each_input(*node, [&](const NodeArg& input) {
+        value_consumers[Index(input.Name())].push_back(position);
+      });
+    }
+
+    std::vector<InlinedHashSet<size_t>> dependencies(num_nodes);
+    for (size_t position = 0; position < num_nodes; ++position) {
+      const auto* node = graph_viewer_.GetNode(execution_order[position]);
+      auto& node_dependencies = dependencies[position];
+
+      for_each_input(*node, [&](const NodeArg& input) {
+        const size_t producer = value_producers[Index(input.Name())];
+        if (producer != kNoProducer && producer != position) {
+          node_dependencies.insert(producer);
+        }
+      });
+
+      for (auto it = node->InputEdgesBegin(), end = node->InputEdgesEnd(); it != end; ++it) {
+        const size_t producer = node_positions[it->GetNode().Index()];
+        if (producer != kNoProducer && producer != position) {
+          node_dependencies.insert(producer);
+        }
+      }
+
+      // inputs written in place must not be modified before the nodes earlier in execution order read them, and
+      // the nodes later in execution order read the modified values.
+      const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node->Index());
+      InlinedVector<size_t> aliased_inputs;
+      for (const auto& [input_index, output_index] : GetAliasMap(*node, ci)) {
+        aliased_inputs.push_back(static_cast<size_t>(input_index));
+      }
+      const auto& variadic_alias_offsets = ci.kernel_def->VariadicAlias();
+      if (variadic_alias_offsets.has_value()) {
+        for (size_t input_index = static_cast<size_t>(variadic_alias_offsets->first);
+             input_index < node->InputDefs().size(); ++input_index) {
+          aliased_inputs.push_back(input_index);
+        }
+      }
+
+      for (size_t input_index : aliased_inputs) {
+        if (input_index >= node->InputDefs().size() || !node->InputDefs()[input_index]->Exists()) {
+          continue;
+        }
+        for (size_t consumer : value_consumers[Index(node->InputDefs()[input_index]->Name())]) {
+          if (consumer < position) {
+            node_dependencies.insert(consumer);
+          } else if (consumer > position) {
+            dependencies[consumer].insert(position);
+          }
+        }
+      }
+    }
+
+    auto& dataflow_nodes = plan_.dataflow_nodes;
+    dataflow_nodes.resize(num_nodes);
+    for (size_t position = 0; position < num_nodes; ++position) {
+      dataflow_nodes[position].node_index = execution_order[position];
+      dataflow_nodes[position].num_dependencies = dependencies[position].size();
+      for (size_t dependency : dependencies[position]) {
+        dataflow_nodes[dependency].dependents.push_back(position);
+      }
+      if (dependencies[position].empty()) {
+        plan_.dataflow_roots.push_back(position);
+      }
+    }
+
+    PrioritizeDataflowNodes();
+
+    return Status::OK();
+  }
+
+  // Estimates the cost of each node of the dataflow graph, from the profile of a previous run when there is one, and
+  // orders the roots and dependents by the cost of their critical path, so that of the nodes made ready together
+  // the one on the longest path runs first, on the thread that made it ready.
+  void PrioritizeDataflowNodes() {
+    auto& dataflow_nodes = plan_.dataflow_nodes;
+    const size_t num_nodes = dataflow_nodes.size();
+
+    // whether the cost of each node is measured or estimated from fully known shapes
+    InlinedVector<double> costs(num_nodes);
+    InlinedVector<bool> known_costs(num_nodes);
+    for (size_t position = 0; position < num_nodes; ++position) {
+      const auto& node = *graph_viewer_.GetNode(dataflow_nodes[position].node_index);
+      costs[position] = node_cost_model::EstimateCost(node);
+      known_costs[position] = node_cost_model::HasKnownShapes(node);
+    }
+
+    const PathString node_cost_profile_file = context_->GetNodeCostProfileFile();
+    if (!node_cost_profile_file.empty()) {
+      InlinedHashMap<std::string, double> node_durations;
+      const auto status = node_cost_model::LoadProfile(node_cost_profile_file, node_durations);
+      if (status.IsOK()) {
+        // scale the static estimates of the nodes missing from the profile to the measured times of the others
+        double total_duration = 0.0;
+        double total_estimate = 0.0;
+        InlinedVector<std::optional<double>> durations(num_nodes);
+        for (size_t position = 0; position < num_nodes; ++position) {
+          const auto* node = graph_viewer_.GetNode(dataflow_nodes[position].node_index);
+          auto it = node_durations.find(node->Name());
+          if (!node->Name().empty() && it != node_durations.end()) {
+            durations[position] = it->second;
+            known_costs[position] = true;
+            total_duration += it->second;
+            total_estimate += costs[position];
+          }
+        }
+
+        if (total_estimate > 0.0) {
+          const double scale = total_duration / total_estimate;
+          for (size_t position = 0; position < num_nodes; ++position) {
+            costs[position] = durations[position].has_value() ? *durations[position] : costs[position] * scale;
+          }
+        }
+      } else {
+        LOGS(logger_, WARNING) << "Ignoring node cost profile: " << status.ErrorMessage();
+      }
+    }
+
+    // the dependents of a node come after it in execution order, so the critical paths of the nodes are computed
+    // backwards and the costs of the paths reaching them forwards.
+    for (size_t position = num_nodes; position-- > 0;) {
+      auto& dataflow_node = dataflow_nodes[position];
+      double longest_dependent_path = 0.0;
+      for (size_t dependent : dataflow_node.dependents) {
+        longest_dependent_path = std::max(longest_dependent_path, dataflow_nodes[dependent].critical_path_cost);
+      }
+      dataflow_node.critical_path_cost = costs[position] + longest_dependent_path;
+    }
+
+    InlinedVector<double> path_to_node_costs(num_nodes, 0.0);
+    double critical_path_cost = 0.0;
+    for (size_t position = 0; position < num_nodes; ++position) {
+      const double path_through_node_cost = path_to_node_costs[position] + costs[position];
+      for (size_t dependent : dataflow_nodes[position].dependents) {
+        path_to_node_costs[dependent] = std::max(path_to_node_costs[dependent], path_through_node_cost);
+      }
+      critical_path_cost = std::max(critical_path_cost, path_to_node_costs[position] +
+                                                            dataflow_nodes[position].critical_path_cost);
+    }
+
+    // a node off the critical path runs without the intra-op threads, so that it doesn't compete for them with the
+    // nodes on the critical path, if its longest path still fits in the critical path once the node is slowed down
+    // by running on a single thread instead of all of them.
+    // this is only done when the costs of all nodes are known: with symbolic dimensions counted as 1, a node on the
+    // critical path could be estimated off it and lose its intra-op threads, which costs more than ordering it late.
+    // it is also pointless if the nodes don't run concurrently, e.g. without an inter-op thread pool.
+    const bool all_costs_known = std::all_of(known_costs.begin(), known_costs.end(), [](bool known) { return known; });
+    const int intra_op_threads = context_->GetIntraOpDegreeOfParallelism();
+    const bool may_demote = all_costs_known && context_->GetInterOpDegreeOfParallelism() >= 2 && intra_op_threads >= 2;
+    for (size_t position = 0; position < num_nodes; ++position) {
+      const double slowed_down_path_cost = path_to_node_costs[position] + dataflow_nodes[position].critical_path_cost +
+                                           costs[position] * (intra_op_threads - 1);
+      dataflow_nodes[position].use_intra_op_thread_pool = !may_demote || slowed_down_path_cost > critical_path_cost;
+    }
+
+    const auto by_priority = [&dataflow_nodes](size_t lhs, size_t rhs) {
+      const double lhs_cost = dataflow_nodes[lhs].critical_path_cost;
+      const double rhs_cost = dataflow_nodes[rhs].critical_path_cost;
+      return lhs_cost > rhs_cost || (lhs_cost == rhs_cost && lhs < rhs);
+    };
+    for (auto& dataflow_node : dataflow_nodes) {
+      std::sort(dataflow_node.dependents.begin(), dataflow_node.dependents.end(), by_priority);
+    }
+    std::sort(plan_.dataflow_roots.begin(), plan_.dataflow_roots.end(), by_priority);
+  }
+
   // Convert information in execution plan and memory reuse plan into release plan
   Status GenerateDeallocationPlan() {
     // 1. build the consumer list for each value
@@ -1864,7 +2179,8 @@ class PlannerImpl {
             break;
           }
         }
-        if (is_all_consumer_same_stream) {
+        // with dataflow execution the consumers on the same stream may run in any order.
+        if (is_all_consumer_same_stream && plan_.dataflow_nodes.empty()) {
           // all the consumers are on the same stream, so the first element is the last consumer int the stream.
           process_consumer(release_action_idx, ortvalue_to_consumers_map[i][0]);
         } else {
@@ -2324,6 +2640,9 @@ Status PlannerImpl::CreatePlan(
   ORT_RETURN_IF_ERROR(ComputeAllocationOrder());
 #endif
 
+  // build the dependencies between the nodes for dataflow execution. this is needed by the deallocation plan.
+  ORT_RETURN_IF_ERROR(BuildDataflowGraph());
+
   // convert information in the freelist_ into a deallocation plan in required format
   ORT_RETURN_IF_ERROR(GenerateDeallocationPlan());
 
@@ -43,6 +43,16 @@ class ISequentialPlannerContext {
   // see PlannerImpl::ComputeReusePlan
   virtual bool IsParallelExecutionEnabled() const { return false; }
 
+  // If it returns true, planner builds the dataflow graph of the nodes, see SequentialExecutionPlan::dataflow_nodes
+  virtual bool IsDataflowExecutionEnabled() const { return false; }
+
+  // Profile of a previous run used to estimate the cost of the nodes of the dataflow graph, if not empty
+  virtual PathString GetNodeCostProfileFile() const { return {}; }
+
+  // Number of threads the nodes of the dataflow graph run on, and that each node may parallelize over
+  virtual int GetInterOpDegreeOfParallelism() const { return 1; }
+  virtual int GetIntraOpDegreeOfParallelism() const { return 1; }
+
   virtual ExecutionOrder GetExecutionOrder() const { return ExecutionOrder::DEFAULT; }
 
   virtual bool GetEnableMemoryReuse() const { return true; }
@@ -51,10 +61,16 @@ class ISequentialPlannerContext {
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse)
+  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse,
+                           bool enable_dataflow_execution = false, PathString node_cost_profile_file = {},
+                           int inter_op_degree_of_parallelism = 1, int intra_op_degree_of_parallelism = 1)
       : execution_mode_(execution_mode),
         execution_order_(execution_order),
-        enable_memory_reuse_(enable_memory_reuse) {
+        enable_memory_reuse_(enable_memory_reuse),
+        enable_dataflow_execution_(enable_dataflow_execution),
+        node_cost_profile_file_(std::move(node_cost_profile_file)),
+        inter_op_degree_of_parallelism_(inter_op_degree_of_parallelism),
+        intra_op_degree_of_parallelism_(intra_op_degree_of_parallelism) {
   }
 
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
@@ -63,6 +79,15 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
 
   bool IsParallelExecutionEnabled() const override { return execution_mode_ == ExecutionMode::ORT_PARALLEL; }
 
+  bool IsDataflowExecutionEnabled() const override {
+    return IsParallelExecutionEnabled() && enable_dataflow_execution_;
+  }
+
+  PathString GetNodeCostProfileFile() const override { return node_cost_profile_file_; }
+
+  int GetInterOpDegreeOfParallelism() const override { return inter_op_degree_of_parallelism_; }
+  int GetIntraOpDegreeOfParallelism() const override { return intra_op_degree_of_parallelism_; }
+
   ExecutionOrder GetExecutionOrder() const override { return execution_order_; }
 
   bool GetEnableMemoryReuse() const override { return enable_memory_reuse_; }
@@ -71,6 +96,10 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
   ExecutionMode execution_mode_ = ExecutionMode::ORT_SEQUENTIAL;
   ExecutionOrder execution_order_ = ExecutionOrder::DEFAULT;
   bool enable_memory_reuse_ = true;
+  bool enable_dataflow_execution_ = false;
+  PathString node_cost_profile_file_;
+  int inter_op_degree_of_parallelism_ = 1;
+  int intra_op_degree_of_parallelism_ = 1;
 };
 
 #ifdef ORT_ENABLE_STREAM
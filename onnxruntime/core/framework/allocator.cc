@@ -5,7 +5,9 @@
 #include "core/framework/allocator.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/framework/utils.h"
+#include "core/platform/env.h"
 #include "core/session/ort_apis.h"
+#include <algorithm>
 #include <cstdlib>
 #include <sstream>
 
@@ -86,9 +88,17 @@ void* AllocatorDefaultAlloc(size_t size) {
   if (p == nullptr)
     ORT_THROW_EX(std::bad_alloc);
 #else
-  int ret = posix_memalign(&p, alignment, size);
+  // large blocks such as arena regions follow the memory placement policy of the process, if any. they are aligned
+  // so the policy covers whole huge pages, and glibc serves them with fresh mappings that are not touched yet.
+  const size_t placement_alignment = Env::Default().GetMemoryPlacementAlignment();
+  const bool use_placement_policy = placement_alignment != 0 && size >= placement_alignment;
+  int ret = posix_memalign(&p, use_placement_policy ? std::max(alignment, placement_alignment) : alignment, size);
   if (ret != 0)
     ORT_THROW_EX(std::bad_alloc);
+  if (use_placement_policy) {
+    // advisory, and there may be no logger to report a failure to when the allocation is made
+    ORT_IGNORE_RETURN_VALUE(Env::Default().AdviseMemoryPlacement(p, size));
+  }
 #endif
   return p;
 }
@@ -643,12 +643,13 @@ Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_valu
           ". Validate usage of dim_value (values should be > 0) and "
           "dim_param (all values with the same string should equate to the same size) in shapes in the model.");
 
-      // be generous and use the buffer if it's large enough. log a warning though as it indicates a bad model
+      // use the buffer if it's large enough. the allocation planner reuses freed buffers that are larger than
+      // the value, so this is expected and only logged at verbose level.
       if (buffer_num_elements >= required_num_elements) {
         // View Operator is reusing the buffer bigger than the required size.
-        // Disabling warning message for now. The op is in the process of being deprecated.
+        // Disabling the message for now. The op is in the process of being deprecated.
 #ifndef ENABLE_TRAINING
-        LOGS(session_state_.Logger(), WARNING) << message;
+        LOGS(session_state_.Logger(), VERBOSE) << message;
 #endif  // ENABLE_TRAINING
       } else {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, message);
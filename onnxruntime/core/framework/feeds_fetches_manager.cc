@@ -3,6 +3,8 @@
 
 #include "core/framework/feeds_fetches_manager.h"
 
+#include <algorithm>
+
 #include "core/framework/execution_providers.h"
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/framework/utils.h"
@@ -82,4 +84,10 @@ void FeedsFetchesManager::SetDeviceCopyChecks(DeviceCopyCheck input_copy_needed,
           ? DeviceCopyCheck::NoCopy
           : DeviceCopyCheck::Copy;
 }
+
+void FeedsFetchesManager::ResetDeviceCopyInfo() {
+  device_copy_checks_ = {};
+  std::fill(feeds_device_copy_info_.begin(), feeds_device_copy_info_.end(), MLValueCopyInfo{});
+  std::fill(fetches_device_copy_info_.begin(), fetches_device_copy_info_.end(), MLValueCopyInfo{});
+}
 }  // namespace onnxruntime
@@ -101,6 +101,10 @@ class FeedsFetchesManager {
   const DeviceCopyChecks& GetDeviceCopyChecks() const { return device_copy_checks_; }
   void SetDeviceCopyChecks(DeviceCopyCheck input_copy_needed, DeviceCopyCheck output_copy_needed);
 
+  // Return the device copy checks and copy info to their initial state so the instance can be used for another
+  // execution, which may provide feeds and fetches on different devices.
+  void ResetDeviceCopyInfo();
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(FeedsFetchesManager);
 
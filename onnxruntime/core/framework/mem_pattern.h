@@ -26,11 +26,13 @@ class MemoryPattern {
 
   MemoryPattern(MemoryPattern&& rhs) noexcept
       : patterns_{std::move(rhs.patterns_)},
-        peak_size_{std::move(rhs.peak_size_)} {}
+        peak_size_{std::move(rhs.peak_size_)},
+        lower_bound_size_{std::move(rhs.lower_bound_size_)} {}
 
   MemoryPattern& operator=(MemoryPattern&& rhs) noexcept {
     patterns_ = std::move(rhs.patterns_);
     peak_size_ = std::move(rhs.peak_size_);
+    lower_bound_size_ = std::move(rhs.lower_bound_size_);
     return *this;
   }
 
@@ -38,6 +40,12 @@ class MemoryPattern {
     return peak_size_;
   }
 
+  // The largest total size of the blocks that are alive at the same time.
+  // PeakSize() can't be smaller than this, the difference is the fragmentation of the pattern.
+  size_t LowerBoundSize() const {
+    return lower_bound_size_;
+  }
+
   const MemoryBlock* GetBlock(int ml_value_idx) const {
     auto it = patterns_.find(ml_value_idx);
     if (it == patterns_.end())
@@ -56,6 +64,7 @@ class MemoryPattern {
 
   InlinedHashMap<int, MemoryBlock> patterns_;
   size_t peak_size_{0};
+  size_t lower_bound_size_{0};
 };
 
 struct MemoryPatternGroup {
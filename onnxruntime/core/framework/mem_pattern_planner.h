@@ -16,7 +16,9 @@ limitations under the License.
 // Licensed under the MIT License.
 
 #pragma once
-#include <list>
+#include <algorithm>
+#include <limits>
+#include <vector>
 #include "core/common/safeint.h"
 #include "core/framework/mem_pattern.h"
 #include "core/framework/allocation_planner.h"
@@ -26,6 +28,9 @@ namespace onnxruntime {
 // MemPatternPlanner is used to trace allocation/free steps
 // in a single iteration, record the pattern and cached for
 // future request if they have the same input shape.
+// The traced allocations are only recorded together with their lifetimes. The offsets are assigned when the
+// pattern is generated, with the lifetimes of all the blocks known, by packing the blocks in decreasing size
+// order and in allocation order and keeping the placement with the smaller peak.
 // Thread-safe.
 class MemPatternPlanner {
  public:
@@ -65,68 +70,32 @@ class MemPatternPlanner {
     return false;
   }
 
-  void TraceAllocation(int ml_value_idx, const AllocPlanPerValue::ProgramCounter& counter, size_t size) {
+  // place_first requests that the block is placed before all blocks that do not request it, in trace order.
+  // It is used for values that need to be laid out contiguously.
+  void TraceAllocation(int ml_value_idx, const AllocPlanPerValue::ProgramCounter& counter, size_t size,
+                       bool place_first = false) {
     ORT_ENFORCE(using_counters_);
 
     std::lock_guard<std::mutex> lock(lock_);
 
     if (size == 0) {
-      allocs_.emplace_back(ml_value_idx, MemoryBlock(0, 0));
+      allocs_.emplace_back(ml_value_idx, 0);
       return;
     }
 
-    size_t current = 0;
-    size_t waste_bytes = std::numeric_limits<size_t>::max();
-    size_t best_offset = 0;
-    bool best_offset_found = false;
-    for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
-      // Memory block can be re-used as long as there is no overlap between their time schedules.
-      if (allocs_[*it].reuse_ && !OverlappingTimeSchedules(counter, *allocs_[*it].counter_)) {
-        continue;
-      }
-
-      if (allocs_[*it].block_.offset_ >= current) {
-        auto gap = allocs_[*it].block_.offset_ - current;
-        if (gap >= size && (gap - size) < waste_bytes) {
-          waste_bytes = gap - size;
-          best_offset = current;
-          best_offset_found = true;
-        }
-      }
-
-      current = std::max(current, allocs_[*it].block_.offset_ + allocs_[*it].block_.size_);
-    }
-
-    ORT_ENFORCE(current <= buffer_size_);
-
-    if (current < buffer_size_) {
-      auto gap = buffer_size_ - current;
-      if ((gap >= size) && ((gap - size) < waste_bytes)) {
-        best_offset = current;
-        best_offset_found = true;
-      }
-    }
-
-    if (!best_offset_found) {
-      best_offset = current;
-    }
-
-    // we only need to bounds check the addition of size to best_offset as that is the only time we extend
-    // the maximum size of the buffer.
-    buffer_size_ = std::max(buffer_size_, SafeInt<size_t>(best_offset) + size);
-    allocs_.emplace_back(ml_value_idx, counter, MemoryBlock(best_offset, size));
-    std::list<int>::iterator best_fit_it = blocks_.end();
-    for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
-      if (allocs_[*it].block_.offset_ < best_offset)
-        continue;
-
-      if ((allocs_[*it].block_.offset_ > best_offset) || (allocs_[*it].block_.size_ >= size)) {
-        best_fit_it = it;
-        break;
-      }
+    // the program counter holds the complete lifetime so TraceFree is not needed for these blocks.
+    // a value without valid entries is kept alive for the whole execution.
+    OrtValueAllocation alloc(ml_value_idx, size);
+    alloc.counter_ = &counter;
+    alloc.place_first_ = place_first;
+    if (counter.HasValidEntries()) {
+      alloc.start_ = counter.Starts().front();
+      alloc.end_ = counter.Ends().back() + 1;
+    } else {
+      alloc.start_ = 0;
     }
 
-    blocks_.insert(best_fit_it, (static_cast<int>(allocs_.size()) - 1));
+    allocs_.push_back(alloc);
   }
 #endif
 
@@ -136,97 +105,84 @@ class MemPatternPlanner {
     std::lock_guard<std::mutex> lock(lock_);
 
     if (size == 0) {
-      allocs_.emplace_back(ml_value_idx, MemoryBlock(0, 0));
+      allocs_.emplace_back(ml_value_idx, 0);
       return;
     }
 
-    size_t current = 0;
-    size_t waste_bytes = std::numeric_limits<size_t>::max();
-    size_t best_offset = 0;
-    bool best_offset_found = false;
-
-    for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
-      if (allocs_[*it].block_.offset_ >= current) {
-        auto gap = allocs_[*it].block_.offset_ - current;
-        if (gap >= size && (gap - size) < waste_bytes) {
-          waste_bytes = gap - size;
-          best_offset = current;
-          best_offset_found = true;
-        }
-      }
-      current = std::max(current, allocs_[*it].block_.offset_ + allocs_[*it].block_.size_);
-    }
-
-    ORT_ENFORCE(current <= buffer_size_);
+    OrtValueAllocation alloc(ml_value_idx, size);
+    alloc.start_ = clock_++;
+    open_allocs_.insert_or_assign(ml_value_idx, allocs_.size());
+    allocs_.push_back(alloc);
+  }
 
-    if (current < buffer_size_) {
-      auto gap = buffer_size_ - current;
-      if ((gap >= size) && ((gap - size) < waste_bytes)) {
-        best_offset = current;
-        best_offset_found = true;
-      }
-    }
+  void TraceFree(int ml_value_index) {
+    std::lock_guard<std::mutex> lock(lock_);
 
-    if (!best_offset_found) {
-      best_offset = current;
+    if (using_counters_) {
+      return;
     }
 
-    // we only need to bounds check the addition of size to best_offset as that is the only time we extend
-    // the maximum size of the buffer.
-    buffer_size_ = std::max(buffer_size_, SafeInt<size_t>(best_offset) + size);
-    allocs_.emplace_back(ml_value_idx, MemoryBlock(best_offset, size));
-    std::list<int>::iterator best_fit_it = blocks_.end();
-    for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
-      if (allocs_[*it].block_.offset_ < best_offset)
-        continue;
-
-      if ((allocs_[*it].block_.offset_ > best_offset) || (allocs_[*it].block_.size_ >= size)) {
-        best_fit_it = it;
-        break;
-      }
+    auto it = open_allocs_.find(ml_value_index);
+    if (it != open_allocs_.end()) {
+      allocs_[it->second].end_ = clock_++;
+      open_allocs_.erase(it);
     }
-
-    blocks_.insert(best_fit_it, (static_cast<int>(allocs_.size()) - 1));
   }
 
-  void TraceFree(int ml_value_index) {
+  MemoryPattern GenerateMemPattern() const {
     std::lock_guard<std::mutex> lock(lock_);
 
-    for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
-      if (allocs_[*it].index_ == ml_value_index) {
-        blocks_.erase(it);
-        break;
+    // allocs_ is in trace order
+    InlinedVector<size_t> in_trace_order;
+    in_trace_order.reserve(allocs_.size());
+    for (size_t i = 0; i < allocs_.size(); ++i) {
+      if (allocs_[i].size_ != 0) {
+        in_trace_order.push_back(i);
       }
     }
-  }
 
-  MemoryPattern GenerateMemPattern() const {
-    std::lock_guard<std::mutex> lock(lock_);
+    InlinedVector<size_t> by_size(in_trace_order.begin(), in_trace_order.end());
+    std::stable_sort(by_size.begin(), by_size.end(), [this](size_t a, size_t b) {
+      if (allocs_[a].place_first_ || allocs_[b].place_first_) {
+        return allocs_[a].place_first_ && !allocs_[b].place_first_;
+      }
+      return allocs_[a].size_ > allocs_[b].size_;
+    });
+
+    // placing in trace order matches what an online planner does. placing the largest blocks first usually
+    // packs tighter, but not always, so keep whichever has the smaller peak.
+    const LifetimeIndex lifetimes(allocs_, in_trace_order);
+    InlinedVector<size_t> offsets;
+    const size_t peak_in_trace_order = PackBlocks(in_trace_order, lifetimes, offsets);
+
+    InlinedVector<size_t> offsets_by_size;
+    const size_t peak_by_size = PackBlocks(by_size, lifetimes, offsets_by_size);
+    size_t peak_size = peak_in_trace_order;
+    if (peak_by_size < peak_in_trace_order) {
+      offsets.swap(offsets_by_size);
+      peak_size = peak_by_size;
+    }
 
 #ifdef ENABLE_TRAINING
     if (using_counters_) {
       // Time schedules of overlapping memory blocks SHOULD NOT intersect.
       for (size_t index_1 = 0; index_1 < allocs_.size(); index_1 += 1) {
-        if (!allocs_[index_1].reuse_)
+        if (allocs_[index_1].size_ == 0)
           continue;
 
         for (size_t index_2 = index_1 + 1; index_2 < allocs_.size(); index_2 += 1) {
-          if (!allocs_[index_2].reuse_)
+          if (allocs_[index_2].size_ == 0)
             continue;
 
-          size_t alloc_1_start = allocs_[index_1].block_.offset_;
-          size_t alloc_1_end = alloc_1_start + allocs_[index_1].block_.size_ - 1;
-
-          ORT_ENFORCE(alloc_1_start <= alloc_1_end);
+          size_t alloc_1_start = offsets[index_1];
+          size_t alloc_1_end = alloc_1_start + allocs_[index_1].size_ - 1;
 
-          size_t alloc_2_start = allocs_[index_2].block_.offset_;
-          size_t alloc_2_end = alloc_2_start + allocs_[index_2].block_.size_ - 1;
-
-          ORT_ENFORCE(alloc_2_start <= alloc_2_end);
+          size_t alloc_2_start = offsets[index_2];
+          size_t alloc_2_end = alloc_2_start + allocs_[index_2].size_ - 1;
 
           if (((alloc_1_start >= alloc_2_start) && (alloc_1_start <= alloc_2_end)) ||
               ((alloc_2_start >= alloc_1_start) && (alloc_2_start <= alloc_1_end))) {
-            ORT_ENFORCE(!OverlappingTimeSchedules(*allocs_[index_1].counter_, *allocs_[index_2].counter_));
+            ORT_ENFORCE(!OverlappingLifetimes(allocs_[index_1], allocs_[index_2]));
           }
         }
       }
@@ -234,32 +190,211 @@ class MemPatternPlanner {
 #endif
 
     MemoryPattern pattern;
-    pattern.peak_size_ = buffer_size_;
+    pattern.peak_size_ = peak_size;
+    pattern.lower_bound_size_ = ComputeLowerBoundSize();
     pattern.patterns_.reserve(allocs_.size());
-    for (auto& alloc : allocs_) {
-      pattern.patterns_.insert_or_assign(alloc.index_, alloc.block_);
+    for (size_t i = 0; i < allocs_.size(); ++i) {
+      const auto& alloc = allocs_[i];
+      pattern.patterns_.insert_or_assign(alloc.index_, MemoryBlock(alloc.size_ != 0 ? offsets[i] : 0, alloc.size_));
     }
 
     return pattern;
   }
 
  private:
-  struct OrtValueAllocationBlock {
+  static constexpr size_t kEndOfExecution = std::numeric_limits<size_t>::max();
+
+  struct OrtValueAllocation {
     int index_{-1};
-    MemoryBlock block_;
+    size_t size_{0};
+    // lifetime as the half open range [start_, end_) of trace steps or program counter values
+    size_t start_{0};
+    size_t end_{kEndOfExecution};
     const AllocPlanPerValue::ProgramCounter* counter_{nullptr};
-    bool reuse_{false};
-    OrtValueAllocationBlock() = default;
-    OrtValueAllocationBlock(int index, const MemoryBlock& block) : index_(index), block_(block), reuse_{false} {}
-    OrtValueAllocationBlock(int index, const AllocPlanPerValue::ProgramCounter& counter, const MemoryBlock& block)
-        : index_(index), block_(block), counter_(&counter), reuse_{true} {
+    bool place_first_{false};
+    OrtValueAllocation(int index, size_t size) : index_(index), size_(size) {}
+  };
+
+  bool OverlappingLifetimes(const OrtValueAllocation& alloc_1, const OrtValueAllocation& alloc_2) const {
+    if (alloc_1.end_ <= alloc_2.start_ || alloc_2.end_ <= alloc_1.start_) {
+      return false;
     }
+
+#ifdef ENABLE_TRAINING
+    // the ranges are the hulls of the program counters, which may have gaps the other value fits in
+    if (alloc_1.counter_ != nullptr && alloc_2.counter_ != nullptr &&
+        alloc_1.counter_->HasValidEntries() && alloc_2.counter_->HasValidEntries()) {
+      return OverlappingTimeSchedules(*alloc_1.counter_, *alloc_2.counter_);
+    }
+#endif
+
+    return true;
+  }
+
+  // Static index of the lifetimes of the blocks, to find the blocks whose lifetime overlaps a given one without
+  // going through all of them. The blocks are sorted by start, as an implicit balanced binary tree whose nodes hold
+  // the latest end in their subtree.
+  class LifetimeIndex {
+   public:
+    LifetimeIndex(const std::vector<OrtValueAllocation>& allocs, gsl::span<const size_t> blocks)
+        : allocs_(allocs), by_start_(blocks.begin(), blocks.end()), subtree_end_(blocks.size()) {
+      std::sort(by_start_.begin(), by_start_.end(), [&allocs](size_t a, size_t b) {
+        return allocs[a].start_ < allocs[b].start_;
+      });
+      ComputeSubtreeEnds(0, by_start_.size());
+    }
+
+    // Appends the blocks whose lifetime range intersects [start, end).
+    void FindIntersecting(size_t start, size_t end, InlinedVector<size_t>& blocks) const {
+      FindIntersecting(0, by_start_.size(), start, end, blocks);
+    }
+
+   private:
+    size_t ComputeSubtreeEnds(size_t begin, size_t end) {
+      if (begin == end) {
+        return 0;
+      }
+      const size_t mid = begin + (end - begin) / 2;
+      subtree_end_[mid] = std::max({allocs_[by_start_[mid]].end_, ComputeSubtreeEnds(begin, mid),
+                                    ComputeSubtreeEnds(mid + 1, end)});
+      return subtree_end_[mid];
+    }
+
+    void FindIntersecting(size_t begin, size_t end, size_t start, size_t stop, InlinedVector<size_t>& blocks) const {
+      if (begin == end) {
+        return;
+      }
+      const size_t mid = begin + (end - begin) / 2;
+      // no block of the subtree is alive at or after start
+      if (subtree_end_[mid] <= start) {
+        return;
+      }
+      FindIntersecting(begin, mid, start, stop, blocks);
+      const auto& alloc = allocs_[by_start_[mid]];
+      // the blocks from mid on start at or after stop
+      if (alloc.start_ >= stop) {
+        return;
+      }
+      if (alloc.end_ > start) {
+        blocks.push_back(by_start_[mid]);
+      }
+      FindIntersecting(mid + 1, end, start, stop, blocks);
+    }
+
+    const std::vector<OrtValueAllocation>& allocs_;
+    InlinedVector<size_t> by_start_;
+    InlinedVector<size_t> subtree_end_;
   };
 
-  std::vector<OrtValueAllocationBlock> allocs_;
-  // blocks_ the list of currently allocated memory blocks, sorted in order of their offset
-  std::list<int> blocks_;
-  SafeInt<size_t> buffer_size_{0};
+  // Place the blocks in the given order, each at the offset of the best fitting gap between the already placed
+  // blocks with an overlapping lifetime, or above all of them if there is no such gap.
+  // Only the blocks whose lifetime intersects the one of the block being placed are looked at, so the cost of
+  // placing a block depends on the number of blocks alive with it rather than on the number of placed blocks.
+  // Returns the peak size.
+  size_t PackBlocks(gsl::span<const size_t> order, const LifetimeIndex& lifetimes,
+                    InlinedVector<size_t>& offsets) const {
+    offsets.assign(allocs_.size(), 0);
+
+    InlinedVector<bool> placed(allocs_.size(), false);
+    // placed blocks with an overlapping lifetime, sorted by their offset
+    InlinedVector<size_t> neighbors;
+    size_t peak_size = 0;
+
+    for (size_t idx : order) {
+      const auto& alloc = allocs_[idx];
+      const size_t size = alloc.size_;
+
+      neighbors.clear();
+      lifetimes.FindIntersecting(alloc.start_, alloc.end_, neighbors);
+      neighbors.erase(std::remove_if(neighbors.begin(), neighbors.end(),
+                                     [&](size_t other_idx) {
+                                       return !placed[other_idx] || !OverlappingLifetimes(alloc, allocs_[other_idx]);
+                                     }),
+                      neighbors.end());
+      std::sort(neighbors.begin(), neighbors.end(), [&offsets](size_t a, size_t b) {
+        return offsets[a] < offsets[b];
+      });
+
+      size_t current = 0;
+      size_t waste_bytes = std::numeric_limits<size_t>::max();
+      size_t best_offset = 0;
+      bool best_offset_found = false;
+
+      for (size_t other_idx : neighbors) {
+        const auto& other = allocs_[other_idx];
+        const size_t other_offset = offsets[other_idx];
+        if (other_offset >= current) {
+          auto gap = other_offset - current;
+          if (gap >= size && (gap - size) < waste_bytes) {
+            waste_bytes = gap - size;
+            best_offset = current;
+            best_offset_found = true;
+          }
+        }
+
+        current = std::max(current, other_offset + other.size_);
+      }
+
+      if (!best_offset_found) {
+        best_offset = current;
+      }
+
+      // we only need to bounds check the addition of size to best_offset as that is the only time we extend
+      // the maximum size of the buffer.
+      const size_t block_end = SafeInt<size_t>(best_offset) + size;
+      peak_size = std::max(peak_size, block_end);
+      offsets[idx] = best_offset;
+      placed[idx] = true;
+    }
+
+    return peak_size;
+  }
+
+  // The largest total size of the blocks that are alive at the same time. No placement can have a smaller peak.
+  size_t ComputeLowerBoundSize() const {
+    // (time, size delta). releases at a time step are applied before allocations at the same step.
+    std::vector<std::pair<size_t, int64_t>> events;
+    events.reserve(allocs_.size() * 2);
+
+    for (const auto& alloc : allocs_) {
+      if (alloc.size_ == 0) {
+        continue;
+      }
+
+      const auto size = static_cast<int64_t>(alloc.size_);
+#ifdef ENABLE_TRAINING
+      if (alloc.counter_ != nullptr && alloc.counter_->HasValidEntries()) {
+        const auto& starts = alloc.counter_->Starts();
+        const auto& ends = alloc.counter_->Ends();
+        for (size_t i = 0; i < starts.size(); ++i) {
+          events.emplace_back(starts[i], size);
+          events.emplace_back(ends[i] + 1, -size);
+        }
+        continue;
+      }
+#endif
+      events.emplace_back(alloc.start_, size);
+      if (alloc.end_ != kEndOfExecution) {
+        events.emplace_back(alloc.end_, -size);
+      }
+    }
+
+    std::sort(events.begin(), events.end());
+
+    int64_t live_size = 0;
+    int64_t lower_bound = 0;
+    for (const auto& event : events) {
+      live_size += event.second;
+      lower_bound = std::max(lower_bound, live_size);
+    }
+
+    return static_cast<size_t>(lower_bound);
+  }
+
+  std::vector<OrtValueAllocation> allocs_;
+  // allocations that have not been released yet. only used when not using counters.
+  InlinedHashMap<int, size_t> open_allocs_;
+  size_t clock_{0};
   bool using_counters_;
   mutable std::mutex lock_;
 };
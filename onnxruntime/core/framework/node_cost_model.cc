@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/node_cost_model.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+
+#include "core/framework/data_types.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph.h"
+
+#if !defined(ORT_MINIMAL_BUILD)
+#include "nlohmann/json.hpp"
+using json = nlohmann::json;
+#endif
+
+namespace onnxruntime {
+namespace node_cost_model {
+
+namespace {
+
+// a byte read or written costs about as much as a few floating point operations on current CPUs
+constexpr double kCostPerByte = 4.0;
+
+// cost of dispatching a kernel and creating its outputs, which dominates for nodes with small tensors
+constexpr double kCostPerNode = 1000.0;
+
+const ONNX_NAMESPACE::TensorShapeProto* GetShape(const NodeArg* arg) {
+  return arg != nullptr && arg->Exists() ? arg->Shape() : nullptr;
+}
+
+double NumElements(const ONNX_NAMESPACE::TensorShapeProto* shape) {
+  double num_elements = 1.0;
+  if (shape != nullptr) {
+    for (const auto& dim : shape->dim()) {
+      if (utils::HasDimValue(dim)) {
+        num_elements *= static_cast<double>(dim.dim_value());
+      }
+    }
+  }
+  return num_elements;
+}
+
+double Dim(const ONNX_NAMESPACE::TensorShapeProto* shape, int axis) {
+  if (shape == nullptr) {
+    return 1.0;
+  }
+  const int rank = shape->dim_size();
+  if (axis < 0) {
+    axis += rank;
+  }
+  if (axis < 0 || axis >= rank || !utils::HasDimValue(shape->dim(axis))) {
+    return 1.0;
+  }
+  return static_cast<double>(shape->dim(axis).dim_value());
+}
+
+double NumBytes(const NodeArg* arg) {
+  const auto* shape = GetShape(arg);
+  if (shape == nullptr) {
+    return 0.0;
+  }
+
+  size_t element_size = sizeof(float);
+  const auto* type = arg->TypeAsProto();
+  if (type != nullptr && utils::HasTensorType(*type) && utils::HasElemType(type->tensor_type())) {
+    const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type());
+    element_size = tensor_type->GetElementType()->Size();
+  }
+  return NumElements(shape) * static_cast<double>(element_size);
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto& attributes = node.GetAttributes();
+  auto it = attributes.find(name);
+  return it != attributes.end() && it->second.has_i() ? it->second.i() : default_value;
+}
+
+// floating point operations of the node, counting a multiply-add as two
+double EstimateFlops(const Node& node) {
+  const auto& inputs = node.InputDefs();
+  const auto& outputs = node.OutputDefs();
+  const double output_elements = outputs.empty() ? 0.0 : NumElements(GetShape(outputs[0]));
+  const auto* a_shape = inputs.empty() ? nullptr : GetShape(inputs[0]);
+  const auto* b_shape = inputs.size() < 2 ? nullptr : GetShape(inputs[1]);
+  const auto& op_type = node.OpType();
+
+  if (op_type == "MatMul" || op_type == "MatMulInteger" || op_type == "FusedMatMul" ||
+      op_type == "QLinearMatMul" || op_type == "MatMulIntegerToFloat") {
+    const bool trans_a = GetIntAttribute(node, "transA", 0) != 0;
+    return 2.0 * output_elements * Dim(a_shape, trans_a ? -2 : -1);
+  }
+
+  if (op_type == "Gemm" || op_type == "QGemm") {
+    const bool trans_a = GetIntAttribute(node, "transA", 0) != 0;
+    return 2.0 * output_elements * Dim(a_shape, trans_a ? 0 : 1);
+  }
+
+  if (op_type == "Conv" || op_type == "FusedConv" || op_type == "NhwcConv" || op_type == "ConvInteger") {
+    // W is (M x C/group x kH x kW ...), each output element reads one of the M filters
+    return 2.0 * output_elements * NumElements(b_shape) / Dim(b_shape, 0);
+  }
+
+  if (op_type == "QLinearConv") {
+    const auto* w_shape = inputs.size() < 4 ? nullptr : GetShape(inputs[3]);
+    return 2.0 * output_elements * NumElements(w_shape) / Dim(w_shape, 0);
+  }
+
+  if (op_type == "ConvTranspose") {
+    // W is (C x M/group x kH x kW ...), each input element is scattered through one of the C filters
+    return 2.0 * NumElements(a_shape) * NumElements(b_shape) / Dim(b_shape, 0);
+  }
+
+  return output_elements;
+}
+
+}  // namespace
+
+double EstimateCost(const Node& node) {
+  double bytes = 0.0;
+  for (const auto* input : node.InputDefs()) {
+    bytes += NumBytes(input);
+  }
+  for (const auto* output : node.OutputDefs()) {
+    bytes += NumBytes(output);
+  }
+
+  return kCostPerNode + EstimateFlops(node) + kCostPerByte * bytes;
+}
+
+bool HasKnownShapes(const Node& node) {
+  const auto is_known = [](const NodeArg* arg) {
+    if (arg == nullptr || !arg->Exists()) {
+      return true;
+    }
+    const auto* shape = arg->Shape();
+    return shape != nullptr && std::all_of(shape->dim().begin(), shape->dim().end(),
+                                           [](const auto& dim) { return utils::HasDimValue(dim); });
+  };
+  return std::all_of(node.InputDefs().begin(), node.InputDefs().end(), is_known) &&
+         std::all_of(node.OutputDefs().begin(), node.OutputDefs().end(), is_known);
+}
+
+Status LoadProfile(const PathString& profile_file, InlinedHashMap<std::string, double>& node_durations) {
+#if !defined(ORT_MINIMAL_BUILD)
+  std::ifstream stream(profile_file);
+  ORT_RETURN_IF_NOT(stream.is_open(), "Failed to open node cost profile file ", PathToUTF8String(profile_file));
+
+  constexpr std::string_view kKernelTimeSuffix = "_kernel_time";
+  InlinedHashMap<std::string, std::pair<double, size_t>> totals;
+  Status status;
+  ORT_TRY {
+    const json events = json::parse(stream);
+    ORT_RETURN_IF_NOT(events.is_array(), "Node cost profile is not an array of events.");
+
+    // the kernel time of each node is an event of the "Node" category named <node name>_kernel_time
+    for (const auto& event : events) {
+      if (!event.is_object() || event.value("cat", "") != "Node") {
+        continue;
+      }
+      const std::string name = event.value("name", "");
+      if (name.size() <= kKernelTimeSuffix.size() ||
+          name.compare(name.size() - kKernelTimeSuffix.size(), kKernelTimeSuffix.size(), kKernelTimeSuffix) != 0) {
+        continue;
+      }
+      auto& [total, count] = totals[name.substr(0, name.size() - kKernelTimeSuffix.size())];
+      total += event.value("dur", 0.0);
+      ++count;
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to parse node cost profile file ",
+                               PathToUTF8String(profile_file), ": ", ex.what());
+    });
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  node_durations.clear();
+  node_durations.reserve(totals.size());
+  for (const auto& [node_name, total] : totals) {
+    node_durations[node_name] = total.first / static_cast<double>(total.second);
+  }
+  return Status::OK();
+#else
+  ORT_UNUSED_PARAMETER(profile_file);
+  ORT_UNUSED_PARAMETER(node_durations);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Node cost profiles are not supported in this build.");
+#endif
+}
+
+}  // namespace node_cost_model
+}  // namespace onnxruntime
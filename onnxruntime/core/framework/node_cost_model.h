@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+class Node;
+
+// Estimates of the cost of running nodes, used by the planner to prioritize the nodes on the critical path of the
+// graph when they are executed by dataflow.
+namespace node_cost_model {
+
+// Returns a static estimate of the cost of running the node, in units of about one floating point operation.
+// It is computed from the shapes of the inputs and outputs of the node, counting the multiply-adds of the
+// matrix multiplications and convolutions, one operation per output element for other operators, plus the bytes read
+// and written and a fixed per node overhead. Dimensions that are not known when planning are counted as 1.
+double EstimateCost(const Node& node);
+
+// Returns whether the shapes of all inputs and outputs of the node are fully known when planning, so that its
+// estimated cost does not count unknown dimensions as 1.
+bool HasKnownShapes(const Node& node);
+
+// Loads the average kernel time in microseconds of each node from a profile written by a previous run of the model
+// with profiling enabled, see SessionOptions::enable_profiling.
+Status LoadProfile(const PathString& profile_file, InlinedHashMap<std::string, double>& node_durations);
+
+}  // namespace node_cost_model
+}  // namespace onnxruntime
@@ -22,8 +22,10 @@ class OpKernelContextInternal : public OpKernelContext {
                                    const OpKernel& kernel,
                                    const logging::Logger& logger,
                                    const bool& terminate_flag,
-                                   Stream* stream)
-      : OpKernelContext(&frame, &kernel, stream, session_state.GetThreadPool(), logger),
+                                   Stream* stream,
+                                   bool use_intra_op_thread_pool = true)
+      : OpKernelContext(&frame, &kernel, stream,
+                        use_intra_op_thread_pool ? session_state.GetThreadPool() : nullptr, logger),
         session_state_(session_state),
         terminate_flag_(terminate_flag) {
     const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
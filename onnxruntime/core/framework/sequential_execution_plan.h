@@ -165,6 +165,29 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
 
   size_t num_barriers{0};
 
+  // Dataflow graph of the nodes, used in parallel execution mode to run each node as soon as the nodes it depends on
+  // completed instead of following the order of the logic streams.
+  // Only built for plans whose streams are all on CPU, which need no synchronization between device streams.
+  struct DataflowNode {
+    NodeIndex node_index;
+    // number of nodes that must complete before this node runs
+    size_t num_dependencies{0};
+    // positions in dataflow_nodes of the nodes depending on this node, by decreasing priority
+    InlinedVector<size_t> dependents;
+    // estimated cost of the longest path from the start of this node to the end of the graph, which is the priority
+    // of the node: running the nodes on the critical path first shortens the run.
+    double critical_path_cost{0};
+    // whether the kernel may parallelize over the intra-op thread pool. nodes off the critical path run on a single
+    // thread, leaving the intra-op threads to the nodes on it, when the costs of all nodes are measured by a profile
+    // or estimated from fully known shapes.
+    bool use_intra_op_thread_pool{true};
+  };
+
+  // in execution order, empty if dataflow execution is not used
+  std::vector<DataflowNode> dataflow_nodes;
+  // positions in dataflow_nodes of the nodes without dependencies, by decreasing priority
+  InlinedVector<size_t> dataflow_roots;
+
 #ifdef ENABLE_TRAINING
   InlinedVector<NodeIndex> node_execution_order_in_training;
   InlinedHashMap<NodeIndex, size_t> node_index_2_toposort_index;
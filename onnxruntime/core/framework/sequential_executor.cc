@@ -3,6 +3,7 @@
 
 #include "core/framework/sequential_executor.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <vector>
@@ -15,6 +16,7 @@
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
+#include "core/platform/env.h"
 
 #if defined DEBUG_NODE_INPUTS_OUTPUTS
 #include "core/framework/debug_node_inputs_outputs_utils.h"
@@ -155,7 +157,8 @@ class SessionScope {
  public:
   friend class KernelScope;
   SessionScope(const SessionState& session_state, const ExecutionFrame& frame)
-      : session_state_(session_state)
+      : session_state_(session_state),
+        profiling_enabled_(session_state.Profiler().IsEnabled())
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
         ,
         frame_(frame)
@@ -176,8 +179,9 @@ class SessionScope {
             session_state_.GetGraphExecutionCounter(), 0}
 #endif
   {
-    if (session_state_.Profiler().IsEnabled()) {
+    if (profiling_enabled_) {
       session_start_ = session_state.Profiler().Start();
+      collect_hardware_counters_ = session_state_.GetEnableProfilingHardwareCounters();
     }
 
     auto& logger = session_state_.Logger();
@@ -224,7 +228,7 @@ class SessionScope {
     }
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (profiling_enabled_) {
       session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_);
     }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
@@ -249,7 +253,11 @@ class SessionScope {
 
  private:
   const SessionState& session_state_;
+  // whether the events of the run are recorded. when runs are sampled, it is decided on the thread calling Run and
+  // applies to the nodes run by other threads too.
+  const bool profiling_enabled_;
   TimePoint session_start_;
+  bool collect_hardware_counters_{false};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
   // Whether memory profiler need create events and flush to file.
@@ -279,6 +287,7 @@ class KernelScope {
               const OpKernel& kernel)
       : session_scope_(session_scope),
         session_state_(session_scope_.session_state_),
+        profiler_run_scope_(session_state_.Profiler(), session_scope_.profiling_enabled_),
         kernel_context_(kernel_context),
         kernel_(kernel)
 #ifdef CONCURRENCY_VISUALIZER
@@ -336,15 +345,19 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (session_scope_.profiling_enabled_) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
       concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool());
       VLOGS(session_state_.Logger(), 1) << "Computing kernel: " << node_name_;
       kernel_begin_time_ = session_state_.Profiler().Start();
+      page_faults_begin_ = Env::Default().GetPageFaultCounts();
       CalculateTotalInputSizes(&kernel_context, &kernel_,
                                input_activation_sizes_, input_parameter_sizes_,
                                node_name_, input_type_shape_);
+      // read last so the counters cover as little of the profiling itself as possible
+      has_hardware_counters_ = session_scope_.collect_hardware_counters_ &&
+                               Env::Default().GetThreadHardwareCounters(hardware_counters_begin_);
     }
   }
 
@@ -355,26 +368,65 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (session_scope_.profiling_enabled_) {
       auto& profiler = session_state_.Profiler();
+      // read first so the counters cover as little of the profiling itself as possible
+      Env::HardwareCounters hardware_counters_end;
+      const bool has_hardware_counters = has_hardware_counters_ &&
+                                         Env::Default().GetThreadHardwareCounters(hardware_counters_end);
+
       std::string output_type_shape_;
       CalculateTotalOutputSizes(&kernel_context_, total_output_sizes_, node_name_, output_type_shape_);
-      profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                     node_name_ + "_kernel_time",
-                                     kernel_begin_time_,
-                                     // Log additional operation args / info.
-                                     {
-                                         {"op_name", kernel_.KernelDef().OpName()},
-                                         {"provider", kernel_.KernelDef().Provider()},
-                                         {"node_index", std::to_string(kernel_.Node().Index())},
-                                         {"activation_size", std::to_string(input_activation_sizes_)},
-                                         {"parameter_size", std::to_string(input_parameter_sizes_)},
-                                         {"output_size", std::to_string(total_output_sizes_)},
-                                         {"input_type_shape", input_type_shape_},
-                                         {"output_type_shape", output_type_shape_},
-                                         {"thread_scheduling_stats",
-                                          concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
-                                     });
+      // process wide, so this includes the faults of concurrently running nodes
+      const auto page_faults_end = Env::Default().GetPageFaultCounts();
+      std::unordered_map<std::string, std::string> event_args{
+          // Log additional operation args / info.
+          {"op_name", kernel_.KernelDef().OpName()},
+          {"provider", kernel_.KernelDef().Provider()},
+          {"node_index", std::to_string(kernel_.Node().Index())},
+          {"activation_size", std::to_string(input_activation_sizes_)},
+          {"parameter_size", std::to_string(input_parameter_sizes_)},
+          {"output_size", std::to_string(total_output_sizes_)},
+          {"input_type_shape", input_type_shape_},
+          {"output_type_shape", output_type_shape_},
+          {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
+          {"minor_page_faults", std::to_string(page_faults_end.minor - page_faults_begin_.minor)},
+          {"major_page_faults", std::to_string(page_faults_end.major - page_faults_begin_.major)},
+      };
+
+      if (has_hardware_counters) {
+        const uint64_t time_enabled = hardware_counters_end.time_enabled - hardware_counters_begin_.time_enabled;
+        const uint64_t time_running = hardware_counters_end.time_running - hardware_counters_begin_.time_running;
+        // the counters did not count during the kernel if they were not scheduled on the hardware
+        if (time_running > 0) {
+          // extrapolate the counts to the whole kernel if the counters were multiplexed with other counters
+          const double scale = static_cast<double>(time_enabled) / static_cast<double>(time_running);
+          auto delta = [scale](uint64_t begin, uint64_t end) {
+            return static_cast<uint64_t>(static_cast<double>(end - begin) * scale + 0.5);
+          };
+          const uint64_t cycles = delta(hardware_counters_begin_.cycles, hardware_counters_end.cycles);
+          const uint64_t instructions = delta(hardware_counters_begin_.instructions,
+                                              hardware_counters_end.instructions);
+          const uint64_t llc_misses = delta(hardware_counters_begin_.llc_misses, hardware_counters_end.llc_misses);
+          const uint64_t branch_misses = delta(hardware_counters_begin_.branch_misses,
+                                               hardware_counters_end.branch_misses);
+          event_args.emplace("hardware_counters",
+                             MakeString("{\"cycles\" : ", cycles, ", \"instructions\" : ", instructions,
+                                        ", \"llc_misses\" : ", llc_misses, ", \"branch_misses\" : ", branch_misses,
+                                        "}"));
+
+          // the input shapes are quoted JSON, drop the quotes to use them in the name of the aggregated event
+          std::string group = kernel_.Node().OpType() + "_hardware_counters_" + input_type_shape_;
+          group.erase(std::remove(group.begin(), group.end(), '"'), group.end());
+          profiler.AccumulateCounters(group, {{"cycles", cycles},
+                                              {"instructions", instructions},
+                                              {"llc_misses", llc_misses},
+                                              {"branch_misses", branch_misses}});
+        }
+      }
+
+      profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT, node_name_ + "_kernel_time", kernel_begin_time_,
+                                     std::move(event_args));
     }
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
@@ -398,8 +450,13 @@ class KernelScope {
 
  private:
   TimePoint kernel_begin_time_;
+  Env::PageFaultCounts page_faults_begin_;
+  bool has_hardware_counters_{false};
+  Env::HardwareCounters hardware_counters_begin_;
   SessionScope& session_scope_;
   const SessionState& session_state_;
+  // applies the sampling decision of the run to the thread running the kernel, e.g. for the subgraphs it executes
+  profiling::Profiler::RunScope profiler_run_scope_;
   std::string node_name_;
   OpKernelContextInternal& kernel_context_;
   const OpKernel& kernel_;
@@ -426,7 +483,8 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
                                   NodeIndex idx,
                                   size_t stream_idx,
                                   const bool& terminate_flag,
-                                  SessionScope& session_scope) {
+                                  SessionScope& session_scope,
+                                  bool use_intra_op_thread_pool) {
   auto* p_kernel = ctx.GetSessionState().GetKernel(idx);
   if (p_kernel->KernelDef().OpName() == "YieldOp") {
     // Do not execute YieldOp (it is an no-op anyways).
@@ -437,13 +495,18 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     ctx.RecycleNodeInputs(idx);
     return Status::OK();
   }
+
+  // pre-pack the constant inputs of the node on its first execution if pre-packing was deferred
+  ORT_RETURN_IF_ERROR(ctx.GetSessionState().PrepackDeferredNodeConstantInputs(idx));
+
   // TODO: set terminate flag from run_option
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
                                      *p_kernel,
                                      ctx.GetLogger(),
                                      terminate_flag,
-                                     ctx.GetDeviceStream(stream_idx));
+                                     ctx.GetDeviceStream(stream_idx),
+                                     use_intra_op_thread_pool);
   onnxruntime::Status status;
   auto& logger = ctx.GetLogger();
   if (p_kernel->IsAsync()) {
@@ -529,10 +592,15 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
       valid_streams++;
   }
 
+  // with multiple threads, run the nodes by dataflow if the plan supports it, starting with a task per root node.
+  const bool run_dataflow = !single_thread_mode && !execution_plan->dataflow_nodes.empty();
+  const int32_t num_tasks = run_dataflow ? gsl::narrow<int32_t>(execution_plan->dataflow_roots.size())
+                                         : valid_streams;
+
   // prepare the execution context, notifications got initialized.
 #ifdef ORT_ENABLE_STREAM
   StreamExecutionContext ctx(session_state,
-                             valid_streams,
+                             num_tasks,
                              execution_plan->notification_owners,
                              execution_plan->num_barriers,
                              device_streams,
@@ -545,7 +613,7 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                              single_thread_mode);
 #else
   StreamExecutionContext ctx(session_state,
-                             valid_streams,
+                             num_tasks,
                              feed_mlvalue_idxs,
                              feeds,
                              fetch_mlvalue_idxs,
@@ -567,17 +635,25 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 
   auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
 
-  for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
-    if (execution_plan->execution_plan[i]->steps_.empty()) {
-      // execution context is initialized with number of valid streams
-      // for invalid stream (0 steps), it doesn't count in number of tasks
-      // so don't need to invoke CompleteTask here
-      // ctx.CompleteTask();
-    } else {
-      concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
-        RunSince(i, ctx, session_scope, terminate_flag, 0);
+  if (run_dataflow) {
+    for (size_t position : execution_plan->dataflow_roots) {
+      concurrency::ThreadPool::Schedule(tp, [position, &ctx, &terminate_flag, &session_scope]() {
+        RunDataflowSince(ctx, session_scope, terminate_flag, position);
       });
     }
+  } else {
+    for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
+      if (execution_plan->execution_plan[i]->steps_.empty()) {
+        // execution context is initialized with number of valid streams
+        // for invalid stream (0 steps), it doesn't count in number of tasks
+        // so don't need to invoke CompleteTask here
+        // ctx.CompleteTask();
+      } else {
+        concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
+          RunSince(i, ctx, session_scope, terminate_flag, 0);
+        });
+      }
+    }
   }
 
   ctx.WaitAll();
@@ -30,11 +30,14 @@ using OrtValueCache = InlinedHashMap<std::string, OrtValue>;
 using OrtValueCachePtr = std::shared_ptr<OrtValueCache>;
 #endif
 
+// use_intra_op_thread_pool: whether the kernel may parallelize over the intra-op thread pool of the session,
+// otherwise it runs on the calling thread only.
 onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
                                   NodeIndex idx,
                                   size_t stream_idx,
                                   const bool& terminate_flag,
-                                  SessionScope& session_scope);
+                                  SessionScope& session_scope,
+                                  bool use_intra_op_thread_pool = true);
 
 onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
                                    gsl::span<const OrtValue> feeds, gsl::span<const int> fetch_mlvalue_idxs,
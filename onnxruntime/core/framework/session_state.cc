@@ -90,6 +90,8 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  enable_profiling_hardware_counters_ = sess_options_.config_options.GetConfigOrDefault(
+                                            kOrtSessionOptionsConfigProfilingHardwareCounters, "0") == "1";
   if (parent_allocators) {
     allocators_ = parent_allocators;
   } else {
@@ -117,6 +119,14 @@ AllocatorPtr SessionState::GetAllocator(const OrtDevice& device) const noexcept
   return nullptr;
 }
 
+void SessionState::ReleaseSharedInitializer(int ort_value_idx) {
+  auto it = shared_initializer_keys_.find(ort_value_idx);
+  if (it != shared_initializer_keys_.end()) {
+    shared_initializer_store_->Release(it->second);
+    shared_initializer_keys_.erase(it);
+  }
+}
+
 void SessionState::UpdateAllocatorsWithEnvAllocators(const std::vector<AllocatorPtr>& env_allocators) {
   for (const auto& env_alloc : env_allocators) {
     (*allocators_)[env_alloc->Info().device] = env_alloc;
@@ -403,202 +413,214 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
-Status SessionState::PrepackConstantInitializedTensors(
-    InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
+Status SessionState::PrepackNodeConstantInputs(
+    const Node& node, bool should_cache_prepacked_weights_for_shared_initializers,
+    InlinedHashMap<std::string, size_t>* constant_initializers_use_count,
     const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          auto* prepacked_for_graph = &graph_.GetPrepacked();
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {
-                  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
-
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
-                  // because other static properties of the node like node attributes could play a role in the
-                  // pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
-                    // to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
-                                "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
-
-                    const auto& op_type = node.OpType();
-
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
-
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string prepacked_weights_container_key =
-                        GenerateKeyForPrepackedWeightsMap(op_type,
-                                                          weights_to_be_filled_in);
-
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
-                        prepacked_weights_container_key);
-
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
-                                          << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: "
-                                          << node.OpType();
-
-                      const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_shared,
-                                                                          node.Name()));
-
-                      ++used_shared_pre_packed_weights_counter_;
-
-                      // Write references to what is stored in the shared container
-                      // and release memory mapped entries this container may have loaded from disk
-                      std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
-                                                                                      prepacked_weights_container_key,
-                                                                                      prepacked_shared);
-
-                    } else {
-                      // container doesn't contain the pre-packed weight - so write into it for sharing across
-                      // kernel instances
-
-                      // Check if we loaded it from disk, then put it into the shared container so
-                      // everybody can share the same memory mapped entry
-                      // the shared container takes ownership of the memory mapped entries
-
-                      // The next line replaces the existing entry with references to it
-                      // and returns the container that holds the memory mapped entries
-                      // so we can transfer it to shared container.
-                      // if there is not an entry, we replace it with references to weights_to_be_filled_in
-                      // in saving mode and return std::nullopt
-                      auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
-                          input_name,
-                          prepacked_weights_container_key,
-                          weights_to_be_filled_in);
-
-                      if (prepacked_from_disk.has_value()) {
-                        weights_to_be_filled_in = std::move(*prepacked_from_disk);
-                      }
-
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
-                                                                     std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(
-                            ONNXRUNTIME, FAIL,
-                            "Unable to write the provided PrePackedWeights instance into the container");
-                      }
-
-                      const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          shared_prepacked,
-                                                                          node.Name()));
-                    }
-                  }
+  auto kernel = GetMutableKernel(node.Index());
+  int input_idx = 0;
+  for (auto& input_def : node.InputDefs()) {
+    if (input_def->Exists()) {
+      const std::string& input_name = input_def->Name();
+      SessionState* st = this;
+      auto* prepacked_for_graph = &graph_.GetPrepacked();
+      // subgraph can use the value from outer scope,
+      // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+      do {
+        int ort_value_idx;
+        if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+          std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
+
+          if (constant_initialized_tensors.count(ort_value_idx)) {
+            bool is_packed = false;
+            const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
+
+            auto iter = initializers_to_share_map.find(input_name);
+            bool is_shared_initializer = (iter != initializers_to_share_map.end());
+
+            // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+            if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+                node.GetExecutionProviderType() == kCpuExecutionProvider) {
+              // caching of pre-packed weights' turned ON
+
+              AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+              ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+              PrePackedWeights weights_to_be_filled_in;
+              // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+              // cached by another instance of the same op_type (for the same constant initializer) is because
+              // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+              // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
+              // because other static properties of the node like node attributes could play a role in the
+              // pre-packed weights' contents.
+              ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
+                                                  is_packed,
+                                                  &weights_to_be_filled_in));
+
+              if (is_packed) {
+                // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
+                // to be cached if the weight was pre-packed
+                ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
+                            "The kernel corresponding to the node ", node.Name(),
+                            " doesn't have an implementation that can cache computed pre-packed weights");
+
+                const auto& op_type = node.OpType();
+
+                // Sanity check
+                // TODO: Check if some version of the ONNX IR allows op_type to be empty
+                ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+
+                // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+                // that we just got by invoking PrePack() on this kernel.
+
+                const std::string prepacked_weights_container_key =
+                    GenerateKeyForPrepackedWeightsMap(op_type,
+                                                      weights_to_be_filled_in);
+
+                bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
+                    prepacked_weights_container_key);
+
+                if (container_contains_packed_weight) {
+                  LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
+                                      << input_name
+                                      << " used in the node: " << node.Name() << " which is of op type: "
+                                      << node.OpType();
+
+                  const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
+                      prepacked_weights_container_key);
+                  ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                      prepacked_shared,
+                                                                      node.Name()));
+
+                  ++used_shared_pre_packed_weights_counter_;
+
+                  // Write references to what is stored in the shared container
+                  // and release memory mapped entries this container may have loaded from disk
+                  std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
+                                                                                  prepacked_weights_container_key,
+                                                                                  prepacked_shared);
 
                 } else {
-                  // cross session caching of pre-packed weights' turned OFF
-                  // we use serialization container to share weights loaded from disk
-                  // within this session. Or if the weight is not present on disk,
-                  // we store the newly minted pre-packed data.
-
-                  AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
-                  // other static properties of the node like node attributes could play a role in the pre-packed
-                  // weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
-                  // even though they set is_packed = true so we leave it up to them.
-                  // We can change their behavior if we wish do so in a separate PR
-                  // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
-                  // produce them.
-                  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
-                    const auto& op_type = node.OpType();
-                    const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
-                        op_type,
-                        weights_to_be_filled_in);
-
-                    // See if we can use pre-packed data from disk
-                    const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
-                        prepacked_weights_container_key);
-
-                    if (weights_to_use == nullptr) {
-                      // In this case pre-packed container owns the data
-                      prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
-                                                                   std::move(weights_to_be_filled_in));
-                      weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
-                      assert(weights_to_use != nullptr);
-                    }
-
-                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                        *weights_to_use,
-                                                                        node.Name()));
+                  // container doesn't contain the pre-packed weight - so write into it for sharing across
+                  // kernel instances
+
+                  // Check if we loaded it from disk, then put it into the shared container so
+                  // everybody can share the same memory mapped entry
+                  // the shared container takes ownership of the memory mapped entries
+
+                  // The next line replaces the existing entry with references to it
+                  // and returns the container that holds the memory mapped entries
+                  // so we can transfer it to shared container.
+                  // if there is not an entry, we replace it with references to weights_to_be_filled_in
+                  // in saving mode and return std::nullopt
+                  auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
+                      input_name,
+                      prepacked_weights_container_key,
+                      weights_to_be_filled_in);
+
+                  if (prepacked_from_disk.has_value()) {
+                    weights_to_be_filled_in = std::move(*prepacked_from_disk);
                   }
-                }
 
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
-
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
-                    st->initialized_tensors_.erase(ort_value_idx);
-                    constant_initialized_tensors.erase(ort_value_idx);
+                  if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
+                                                                 std::move(weights_to_be_filled_in))) {
+                    return ORT_MAKE_STATUS(
+                        ONNXRUNTIME, FAIL,
+                        "Unable to write the provided PrePackedWeights instance into the container");
                   }
+
+                  const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
+                      prepacked_weights_container_key);
+                  ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                      shared_prepacked,
+                                                                      node.Name()));
                 }
               }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
+
+            } else {
+              // cross session caching of pre-packed weights' turned OFF
+              // we use serialization container to share weights loaded from disk
+              // within this session. Or if the weight is not present on disk,
+              // we store the newly minted pre-packed data.
+
+              AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+              PrePackedWeights weights_to_be_filled_in;
+              // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+              // cached by another instance of the same op_type (for the same constant initializer) is because
+              // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+              // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
+              // other static properties of the node like node attributes could play a role in the pre-packed
+              // weights' contents.
+              ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
+                                                  is_packed,
+                                                  &weights_to_be_filled_in));
+
+              // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
+              // even though they set is_packed = true so we leave it up to them.
+              // We can change their behavior if we wish do so in a separate PR
+              // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
+              // produce them.
+              if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                const auto& op_type = node.OpType();
+                const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
+                    op_type,
+                    weights_to_be_filled_in);
+
+                // See if we can use pre-packed data from disk
+                const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                    prepacked_weights_container_key);
+
+                if (weights_to_use == nullptr) {
+                  // In this case pre-packed container owns the data
+                  prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
+                                                               std::move(weights_to_be_filled_in));
+                  weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
+                  assert(weights_to_use != nullptr);
+                }
+
+                ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                    *weights_to_use,
+                                                                    node.Name()));
               }
             }
-            st = st->Parent();
-            prepacked_for_graph = &st->graph_.GetPrepacked();
-          } while (st);
+
+            if (is_packed) {
+              ++number_of_prepacks_counter_;
+
+              if (constant_initializers_use_count != nullptr && constant_initializers_use_count->count(input_name) &&
+                  --(*constant_initializers_use_count)[input_name] == 0) {
+                // release the constant initialized tensor
+                st->initialized_tensors_.erase(ort_value_idx);
+                constant_initialized_tensors.erase(ort_value_idx);
+                st->ReleaseSharedInitializer(ort_value_idx);
+              }
+            }
+          }
+          // stop searching in 2 cases:
+          // 1. value is not from OuterScope
+          // 2. value is from OuterScope and the current OuterScope has the value
+          if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+            break;
+          }
         }
-        input_idx++;
-      }
+        st = st->Parent();
+        prepacked_for_graph = &st->graph_.GetPrepacked();
+      } while (st);
+    }
+    input_idx++;
+  }
+
+  return Status::OK();
+}
+
+Status SessionState::PrepackConstantInitializedTensors(
+    InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
+    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
+  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
+                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    for (auto& node : GetGraphViewer().Nodes()) {
+      ORT_RETURN_IF_ERROR(PrepackNodeConstantInputs(node, should_cache_prepacked_weights_for_shared_initializers,
+                                                    &constant_initializers_use_count, initializers_to_share_map));
     }
 
     return Status::OK();
@@ -616,6 +638,30 @@ Status SessionState::PrepackConstantInitializedTensors(
   }
 }
 
+Status SessionState::PrepackDeferredNodeConstantInputsImpl(NodeIndex node_index) const {
+  const SessionState* root = this;
+  while (root->parent_ != nullptr) {
+    root = root->parent_;
+  }
+
+  std::lock_guard<std::mutex> l(root->deferred_prepack_mutex_);
+  if (deferred_prepack_done_[node_index].load(std::memory_order_relaxed)) {
+    return Status::OK();
+  }
+
+  // kernels and the pre-packed weights are only updated while holding the lock, and a kernel is not run before
+  // the pre-packing of its node is complete
+  auto* session_state = const_cast<SessionState*>(this);
+  const Node* node = GetGraphViewer().GetNode(node_index);
+  if (node != nullptr) {
+    ORT_RETURN_IF_ERROR(session_state->PrepackNodeConstantInputs(*node, false, nullptr,
+                                                                 sess_options_.initializers_to_share_map));
+  }
+
+  deferred_prepack_done_[node_index].store(true, std::memory_order_release);
+  return Status::OK();
+}
+
 static int64_t
 CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
   int64_t key = 0;
@@ -788,7 +834,7 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
       ORT_ENFORCE(exe_plan->allocation_plan[ml_value_idx].alloc_kind == AllocKind::kAllocate);
 
       const auto& counter = exe_plan->allocation_plan[ml_value_idx].program_counter;
-      ORT_RETURN_IF_ERROR(mem_planner.TraceAllocation(ml_value_idx, counter, size));
+      ORT_RETURN_IF_ERROR(mem_planner.TraceAllocation(ml_value_idx, counter, size, /*place_first*/ true));
     }
   }
   // TODO: add check for single stream
@@ -859,6 +905,15 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
+static void LogMemoryPatternGroup(const MemoryPatternGroup& mem_patterns, const logging::Logger& logger) {
+  for (size_t i = 0, end = mem_patterns.locations.size(); i < end; ++i) {
+    const auto& pattern = mem_patterns.patterns[i];
+    LOGS(logger, VERBOSE) << "Memory pattern for " << mem_patterns.locations[i].ToString()
+                          << ": peak size " << pattern.PeakSize()
+                          << " bytes, lower bound " << pattern.LowerBoundSize() << " bytes";
+  }
+}
+
 // MemoryPatternGroup pointer is cached. It only inserted upon creation
 // and is not updated if already present.
 const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
@@ -874,6 +929,7 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
     MemoryPatternGroup mem_patterns;
     InlinedHashMap<int, TensorShape> inferred_shapes;
     if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
+      LogMemoryPatternGroup(mem_patterns, logger_);
       auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
       auto ptr = &patt_insert.first->second;
       auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
@@ -945,7 +1001,10 @@ Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> ten
 
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
   // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  auto result = mem_patterns_.emplace(key, std::move(mem_patterns));
+  if (result.second) {
+    LogMemoryPatternGroup(result.first->second, logger_);
+  }
   return Status::OK();
 }
 
@@ -1142,6 +1201,7 @@ Status SessionState::CreateSubgraphSessionState() {
                                          thread_pool_, inter_op_thread_pool_, data_transfer_mgr_,
                                          external_data_loader_mgr_, logger_, profiler_, sess_options_,
                                          prepacked_weights_container_, allocators_);
+      subgraph_session_state->SetSharedInitializerStore(shared_initializer_store_);
 
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
@@ -1497,24 +1557,41 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
-  SequentialPlannerContext context(session_options.execution_mode,
-                                   session_options.execution_order,
-                                   session_options.enable_mem_reuse);
-
 #ifdef _WIN32
 
   PathString partition_config_file =
       ToWideString(session_options.config_options.GetConfigOrDefault(
           kNodePartitionConfigFile, ""));
+  PathString node_cost_profile_file =
+      ToWideString(session_options.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsNodeCostProfileFile, ""));
 
 #else
 
   PathString partition_config_file =
       session_options.config_options.GetConfigOrDefault(
           kNodePartitionConfigFile, "");
+  PathString node_cost_profile_file =
+      session_options.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsNodeCostProfileFile, "");
 
 #endif
 
+  // the dataflow graph ignores the logic streams, so it isn't used when they are configured explicitly
+  bool enable_dataflow_execution =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableDataflowExecution, "0") == "1";
+  if (enable_dataflow_execution && !partition_config_file.empty()) {
+    LOGS(logger_, WARNING) << "Dataflow execution is not used since a node partition config is set.";
+    enable_dataflow_execution = false;
+  }
+  SequentialPlannerContext context(session_options.execution_mode,
+                                   session_options.execution_order,
+                                   session_options.enable_mem_reuse,
+                                   enable_dataflow_execution,
+                                   std::move(node_cost_profile_file),
+                                   concurrency::ThreadPool::DegreeOfParallelism(inter_op_thread_pool_),
+                                   concurrency::ThreadPool::DegreeOfParallelism(thread_pool_));
+
   auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
                                               execution_providers_, kernel_create_info_map_,
                                               subgraphs_kernel_create_info_maps,
@@ -1528,6 +1605,12 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                               p_seq_exec_plan_);
   ORT_RETURN_IF_ERROR(status);
 
+  if (session_options.execution_mode == ExecutionMode::ORT_PARALLEL) {
+    LOGS(logger_, INFO) << "Parallel execution "
+                        << (p_seq_exec_plan_->dataflow_nodes.empty() ? "runs the logic streams in order."
+                                                                     : "runs the nodes by dataflow.");
+  }
+
   // Record the allocation plan
 
   // Uncomment the below to dump the allocation plan to std::cout
@@ -1600,14 +1683,33 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
       ort_value_name_idx_map_, initializer_allocation_order, *tensor_allocator,
       [this, remove_initializers](const std::string& name, int idx, const OrtValue& value, const OrtCallback& d,
                                   bool constant, bool sparse) -> Status {
-        ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, value, &d, constant, sparse));
+        if (shared_initializer_store_ != nullptr && constant && !sparse && d.f == nullptr &&
+            SharedInitializerStore::CanShare(value)) {
+          SharedInitializerStore::Key key;
+          bool reused = false;
+          OrtValue shared_value = shared_initializer_store_->Acquire(value, key, reused);
+          shared_initializer_keys_.insert_or_assign(idx, key);
+          if (reused) {
+            shared_initializer_bytes_ += shared_value.Get<Tensor>().SizeInBytes();
+          }
+
+          ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, shared_value, &d, constant, sparse));
+        } else {
+          ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, value, &d, constant, sparse));
+        }
+
         if (remove_initializers) {
           graph_.RemoveInitializedTensor(name);
         }
         return Status::OK();
       },
       logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
-      memory_profile_func, name_to_buffered_tensor_, graph_.GetPrepacked()));
+      memory_profile_func, name_to_buffered_tensor_, graph_.GetPrepacked(), thread_pool_));
+
+  if (shared_initializer_bytes_ > 0) {
+    LOGS(logger_, INFO) << "Reused " << shared_initializer_bytes_
+                        << " bytes of constant initializers from other sessions.";
+  }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1623,7 +1725,15 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
 
-  if (!disable_prepacking) {
+  // Pre-packing is deferred to the first execution of each node if requested, unless the pre-packed weights are
+  // shared with other sessions or saved to disk, both of which need every weight to be pre-packed up front.
+  const bool defer_prepacking =
+      !disable_prepacking && prepacked_weights_container_ == nullptr && !graph_.GetPrepacked().IsSaveModeOn() &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDeferPrepacking, "0") == "1";
+
+  if (defer_prepacking) {
+    deferred_prepack_done_.reset(new std::atomic<bool>[graph_viewer_->MaxNodeIndex()]());
+  } else if (!disable_prepacking) {
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
                                                           session_options.initializers_to_share_map));
   }
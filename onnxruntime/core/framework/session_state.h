@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -26,6 +27,7 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
@@ -105,6 +107,10 @@ class SessionState {
     for (auto& kvp : deleter_for_initialized_tensors_) {
       kvp.second.f(kvp.second.param);
     }
+
+    for (const auto& kvp : shared_initializer_keys_) {
+      shared_initializer_store_->Release(kvp.second);
+    }
   }
 
   // Graph viewer. CreateGraphInfo must have been called previously.
@@ -138,6 +144,15 @@ class SessionState {
 
   void UpdateAllocatorsWithEnvAllocators(const std::vector<AllocatorPtr>&);
 
+  /**
+   * Sets the store used to share constant initializers with other sessions. Must be called before
+   * FinalizeSessionState. The store must outlive the session state.
+   */
+  void SetSharedInitializerStore(SharedInitializerStore* store) { shared_initializer_store_ = store; }
+
+  /** Returns the size in bytes of the initializers of this graph that are reused from other sessions. */
+  size_t GetSharedInitializerBytes() const noexcept { return shared_initializer_bytes_; }
+
   const OrtValueNameIdxMap& GetOrtValueNameIdxMap() const noexcept { return ort_value_name_idx_map_; }
 
   /**
@@ -251,6 +266,12 @@ class SessionState {
 
   bool GetEnableMemoryReuse() const;
 
+  /**
+  Get whether the hardware performance counters of the kernels are recorded when profiling.
+  See kOrtSessionOptionsConfigProfilingHardwareCounters.
+  */
+  bool GetEnableProfilingHardwareCounters() const noexcept { return enable_profiling_hardware_counters_; }
+
   /**
   Update enable_mem_pattern_ flag according to the presence of graph inputs' shape
   If any one of the graph input is shapeless, enable_mem_pattern_ will be set to false
@@ -323,6 +344,16 @@ class SessionState {
     return parent_;
   }
 
+  // Pre-pack the constant inputs of a node before its first execution if pre-packing is deferred.
+  // See kOrtSessionOptionsConfigDeferPrepacking.
+  Status PrepackDeferredNodeConstantInputs(NodeIndex node_index) const {
+    if (deferred_prepack_done_ == nullptr || deferred_prepack_done_[node_index].load(std::memory_order_acquire)) {
+      return Status::OK();
+    }
+
+    return PrepackDeferredNodeConstantInputsImpl(node_index);
+  }
+
   // Clear all removable attributes if they exists.
   // The function logs the list of removable attributes for every node.
   void PruneRemovableAttributes();
@@ -395,6 +426,20 @@ class SessionState {
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
                                            const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
 
+  // Releases the initializer with the given index if it was acquired from the shared initializer store.
+  void ReleaseSharedInitializer(int ort_value_idx);
+
+  /**
+   * Prepack the constant initialized tensors used by a node.
+   * If constant_initializers_use_count is not null, the constant initialized tensors which have been pre-packed
+   * by all their consumers are removed.
+   */
+  Status PrepackNodeConstantInputs(const Node& node, bool should_cache_prepacked_weights_for_shared_initializers,
+                                   InlinedHashMap<std::string, size_t>* constant_initializers_use_count,
+                                   const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+
+  Status PrepackDeferredNodeConstantInputsImpl(NodeIndex node_index) const;
+
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
   Status CreateSubgraphSessionState();
@@ -505,6 +550,9 @@ class SessionState {
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
+  // switch for recording the hardware performance counters of the kernels when profiling.
+  bool enable_profiling_hardware_counters_;
+
   // lock for the mem_patterns_
   mutable std::mutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
@@ -571,6 +619,22 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // when pre-packing is deferred, set for a node once its constant inputs have been pre-packed
+  std::unique_ptr<std::atomic<bool>[]> deferred_prepack_done_;
+
+  // serializes deferred pre-packing in the session. only the mutex of the root session state is used as
+  // pre-packing a node in a subgraph may update the pre-packed weights of the outer graphs.
+  mutable std::mutex deferred_prepack_mutex_;
+
+  // store of constant initializers shared with other sessions. not owned.
+  SharedInitializerStore* shared_initializer_store_ = nullptr;
+
+  // keys of the initializers acquired from shared_initializer_store_ by ort value index
+  InlinedHashMap<int, SharedInitializerStore::Key> shared_initializer_keys_;
+
+  // size of the initializers reused from other sessions
+  size_t shared_initializer_bytes_ = 0;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -14,6 +16,7 @@
 #include "core/framework/session_state_utils.h"
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/graph_partitioner.h"
@@ -28,6 +31,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -276,7 +280,8 @@ common::Status SaveInitializedTensors(
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
     std::unordered_map<std::string, std::unique_ptr<Tensor>>& buffered_tensors,
-    PrepackedWeightsForGraph& prepacked_for_graph) {
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -372,29 +377,132 @@ common::Status SaveInitializedTensors(
   OrtCallback deleter{nullptr, nullptr};
 
   // 3. create weight tensors based on weights buffer
+  //  initializers without external data that are deserialized on CPU are independent of each other. their tensors
+  //  are allocated in order and filled in parallel first. everything else is deserialized in order when it is saved.
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
+  int load_concurrency = 0;
+  const auto load_concurrency_config =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsInitializerLoadConcurrency, "0");
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(load_concurrency_config, load_concurrency) && load_concurrency >= 0,
+                    "Invalid value for ", kOrtSessionOptionsInitializerLoadConcurrency, ": ", load_concurrency_config);
+  const bool parallel_load_enabled = load_concurrency != 1 &&
+                                     concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1;
+
+  struct InitializerToLoad {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::optional<MemBuffer> m;
+    AllocatorPtr alloc;
+    std::unique_ptr<Tensor> p_tensor;  // preallocated tensor to deserialize into in parallel
+    OrtValue ort_value;
+  };
+
+  InlinedVector<InitializerToLoad> initializers_to_load;
+  initializers_to_load.reserve(id_to_initialized_tensor.size());
+  InlinedVector<size_t> parallel_loads;
+
   for (const auto& entry : id_to_initialized_tensor) {
-    int ort_value_index = entry.first;
+    auto& to_load = initializers_to_load.emplace_back(InitializerToLoad{entry.first, entry.second, {}, {}, {}, {}});
     const std::string& name = entry.second->name();
+    if (name.empty() || user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+      continue;
+    }
+
+    // TODO: if the tensor need be copied, does it have enough room?
+    ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(entry.first, name, to_load.m, to_load.alloc));
+
+    const auto& memory_info = to_load.m.has_value() ? to_load.m->GetAllocInfo() : to_load.alloc->Info();
+    if (parallel_load_enabled && memory_info.device.Type() == OrtDevice::CPU &&
+        !utils::HasExternalData(*entry.second) &&
+        entry.second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING &&
+        buffered_tensors.find(name) == buffered_tensors.end()) {
+      TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(*entry.second);
+      const auto* type = DataTypeImpl::TensorTypeFromONNXEnum(entry.second->data_type())->GetElementType();
+      ORT_RETURN_IF_ERROR(AllocateTensor(to_load.m.has_value() ? &*to_load.m : nullptr, to_load.p_tensor, type,
+                                         tensor_shape, use_device_allocator_for_initializers, to_load.alloc));
+      parallel_loads.push_back(initializers_to_load.size() - 1);
+    }
+  }
+
+  if (!parallel_loads.empty()) {
+    std::ptrdiff_t num_batches = concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+    if (load_concurrency > 1) {
+      num_batches = std::min<std::ptrdiff_t>(num_batches, load_concurrency);
+    }
+    num_batches = std::min<std::ptrdiff_t>(num_batches, static_cast<std::ptrdiff_t>(parallel_loads.size()));
+
+    InlinedVector<Status> statuses(parallel_loads.size());
+    concurrency::ThreadPool::TryBatchParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(parallel_loads.size()),
+        [&](std::ptrdiff_t i) {
+          auto& to_load = initializers_to_load[parallel_loads[i]];
+          statuses[i] = utils::TensorProtoToTensor(env, graph_loc.c_str(), *to_load.tensor_proto, *to_load.p_tensor);
+        },
+        num_batches);
+
+    for (size_t i = 0; i < parallel_loads.size(); ++i) {
+      auto& to_load = initializers_to_load[parallel_loads[i]];
+      const auto& st = statuses[i];
+      if (!st.IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << to_load.tensor_proto->name() << " failed." << st.ErrorMessage();
+        return Status(st.Category(), st.Code(), oss.str());
+      }
+
+      auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+      to_load.ort_value.Init(to_load.p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+    }
+  }
+
+  // external data is consumed in no particular order, one tensor at a time. read it ahead in file order with larger
+  // requests so the storage is not waited on for each tensor.
+  if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsExternalDataReadahead, "0") == "1") {
+    InlinedVector<const ONNX_NAMESPACE::TensorProto*> external_tensor_protos;
+    for (const auto& to_load : initializers_to_load) {
+      if (!to_load.ort_value.IsAllocated() && utils::HasExternalData(*to_load.tensor_proto) &&
+          user_supplied_initializer_ids.find(to_load.ort_value_index) == user_supplied_initializer_ids.end()) {
+        external_tensor_protos.push_back(to_load.tensor_proto);
+      }
+    }
+
+    // gaps of up to this size between tensors are read too, as one larger request costs less than two
+    constexpr size_t kMaxReadaheadGap = 1024 * 1024;
+    utils::ExternalDataReadaheadStats readahead_stats;
+    const auto readahead_status = utils::ReadaheadExternalData(env, graph_loc, external_tensor_protos,
+                                                               kMaxReadaheadGap, readahead_stats);
+    if (readahead_status.IsOK()) {
+      LOGS(logger, INFO) << "Requested readahead of " << readahead_stats.num_bytes << " bytes of external data in "
+                         << readahead_stats.num_ranges << " ranges of " << readahead_stats.num_files << " files for "
+                         << external_tensor_protos.size() << " initializers";
+    } else {
+      // readahead is only a hint. the external data is still read when the initializers are loaded below, which
+      // reports any actual error.
+      LOGS(logger, WARNING) << "Readahead of external data failed, continuing without it: "
+                            << readahead_status.ErrorMessage();
+    }
+  }
+
+  size_t external_data_bytes = 0;
+  std::chrono::steady_clock::duration external_data_load_time{};
+
+  for (auto& to_load : initializers_to_load) {
+    int ort_value_index = to_load.ort_value_index;
+    const std::string& name = to_load.tensor_proto->name();
 
     if (name.empty()) {
       LOGS(logger, INFO) << "Skipping entry for missing optional value at idx " << ort_value_index;
       continue;
     }
 
-    OrtValue ort_value;
+    OrtValue& ort_value = to_load.ort_value;
 
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    if (user_supplied_initializer_ids.find(ort_value_index) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
-    } else {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
-
-      std::optional<MemBuffer> m;
-      AllocatorPtr alloc;
-      // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+    } else if (!ort_value.IsAllocated()) {
+      const ONNX_NAMESPACE::TensorProto& tensor_proto = *to_load.tensor_proto;
 
       Tensor* p_tensor = nullptr;
       if (auto iter = buffered_tensors.find(name);
@@ -403,15 +511,21 @@ common::Status SaveInitializedTensors(
         buffered_tensors.erase(iter);
       }
 
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
-                                         default_cpu_alloc, ort_value, data_transfer_mgr, external_data_loader_mgr,
-                                         prepacked_for_graph,
+      const auto load_start = std::chrono::steady_clock::now();
+      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (to_load.m.has_value()) ? &*to_load.m : nullptr,
+                                         to_load.alloc, default_cpu_alloc, ort_value, data_transfer_mgr,
+                                         external_data_loader_mgr, prepacked_for_graph,
                                          use_device_allocator_for_initializers, p_tensor);
       if (!st.IsOK()) {
         std::ostringstream oss;
         oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
         return Status(st.Category(), st.Code(), oss.str());
       }
+
+      if (utils::HasExternalData(tensor_proto) && ort_value.IsTensor()) {
+        external_data_load_time += std::chrono::steady_clock::now() - load_start;
+        external_data_bytes += ort_value.Get<Tensor>().SizeInBytes();
+      }
     }
 
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
@@ -429,6 +543,13 @@ common::Status SaveInitializedTensors(
 #endif
   }
 
+  if (external_data_bytes > 0) {
+    // memory mapped external data is only read when it is first accessed, which may be after this
+    const double seconds = std::chrono::duration<double>(external_data_load_time).count();
+    LOGS(logger, INFO) << "Loaded " << external_data_bytes << " bytes of external data in " << seconds * 1000
+                       << " ms (" << (seconds > 0 ? external_data_bytes / seconds / (1024 * 1024) : 0) << " MB/s)";
+  }
+
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+namespace {
+
+uint64_t HashTensor(const Tensor& tensor) {
+  // MurmurHash3 takes an int length, so hash large tensors in chunks and chain the hashes through the seed
+  constexpr size_t kMaxChunkSize = static_cast<size_t>(std::numeric_limits<int>::max());
+
+  const auto* data = static_cast<const char*>(tensor.DataRaw());
+  size_t remaining = tensor.SizeInBytes();
+  uint64_t hash[2] = {static_cast<uint64_t>(tensor.GetElementType()), 0};
+  do {
+    const size_t chunk_size = std::min(remaining, kMaxChunkSize);
+    MurmurHash3::x86_128(data, static_cast<int>(chunk_size), static_cast<uint32_t>(hash[0]), hash);
+    data += chunk_size;
+    remaining -= chunk_size;
+  } while (remaining > 0);
+
+  return hash[0] ^ hash[1];
+}
+
+bool IsSameTensor(const Tensor& a, const Tensor& b) {
+  return a.GetElementType() == b.GetElementType() &&
+         a.Shape() == b.Shape() &&
+         a.Location().device == b.Location().device &&
+         std::memcmp(a.DataRaw(), b.DataRaw(), a.SizeInBytes()) == 0;
+}
+
+}  // namespace
+
+bool SharedInitializerStore::CanShare(const OrtValue& value) {
+  if (!value.IsTensor()) {
+    return false;
+  }
+
+  // a tensor that doesn't own its buffer may point into memory owned by the session that created it, e.g. a planned
+  // weights buffer or the bytes of an ORT format model, which could go away before the other sessions using it.
+  // memory mapped external data is not shared either, its pages are already shared through the page cache.
+  const auto& tensor = value.Get<Tensor>();
+  return tensor.OwnsBuffer() && tensor.Location().device.Type() == OrtDevice::CPU && !tensor.IsDataTypeString() &&
+         tensor.SizeInBytes() >= kMinTensorSizeInBytes;
+}
+
+OrtValue SharedInitializerStore::Acquire(const OrtValue& value, Key& key, bool& reused) {
+  ORT_ENFORCE(CanShare(value), "Only CPU tensors of at least ", kMinTensorSizeInBytes, " bytes can be shared.");
+
+  const auto& tensor = value.Get<Tensor>();
+  const uint64_t hash = HashTensor(tensor);
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& bucket = entries_[hash];
+  for (auto& entry : bucket) {
+    if (IsSameTensor(entry.value.Get<Tensor>(), tensor)) {
+      ++entry.ref_count;
+      key = {hash, entry.value.Get<Tensor>().DataRaw()};
+      reused = true;
+      return entry.value;
+    }
+  }
+
+  bucket.push_back({value, 1});
+  key = {hash, tensor.DataRaw()};
+  reused = false;
+  return value;
+}
+
+void SharedInitializerStore::Release(const Key& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto bucket = entries_.find(key.hash);
+  ORT_ENFORCE(bucket != entries_.end(), "Releasing a shared initializer that is not in the store.");
+
+  auto& entries = bucket->second;
+  auto entry = std::find_if(entries.begin(), entries.end(), [&key](const Entry& e) {
+    return e.value.Get<Tensor>().DataRaw() == key.data;
+  });
+  ORT_ENFORCE(entry != entries.end(), "Releasing a shared initializer that is not in the store.");
+
+  if (--entry->ref_count == 0) {
+    entries.erase(entry);
+    if (entries.empty()) {
+      entries_.erase(bucket);
+    }
+  }
+}
+
+size_t SharedInitializerStore::GetNumberOfEntries() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  size_t num_entries = 0;
+  for (const auto& [hash, entries] : entries_) {
+    num_entries += entries.size();
+  }
+  return num_entries;
+}
+
+}  // namespace onnxruntime
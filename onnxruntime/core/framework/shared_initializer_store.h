@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+
+// Content addressed store of constant initializers shared by the sessions of an environment, so that sessions of
+// models with common weights, e.g. variants of a model or the parts of a split model, keep a single copy of them.
+// Entries are reference counted and removed when the last session using them releases them.
+// Only CPU tensors that own their buffer are shared, as their content is compared on the host and they must not depend
+// on the session that created them.
+class SharedInitializerStore final {
+ public:
+  // Identifies an entry of the store acquired by a session.
+  struct Key {
+    uint64_t hash;
+    const void* data;
+  };
+
+  // Tensors smaller than this are not worth hashing and tracking.
+  static constexpr size_t kMinTensorSizeInBytes = 1024;
+
+  SharedInitializerStore() = default;
+
+  // Returns true if the value is a tensor that can be shared.
+  static bool CanShare(const OrtValue& value);
+
+  // Looks up a tensor with the same element type, shape and content as value. If there is one it is returned and
+  // its reference count is incremented, otherwise value is added and returned. `reused` is set to whether an existing
+  // tensor was returned. Every call must be matched with a call to Release() with the returned key.
+  OrtValue Acquire(const OrtValue& value, Key& key, bool& reused);
+
+  // Releases an entry acquired with Acquire(). The entry is removed when it is not used by any session anymore.
+  void Release(const Key& key);
+
+  // Returns the number of tensors in the store.
+  size_t GetNumberOfEntries() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerStore);
+
+ private:
+  struct Entry {
+    OrtValue value;
+    size_t ref_count;
+  };
+
+  mutable std::mutex mutex_;
+
+  // entries by hash of their content. entries with colliding hashes share a bucket.
+  std::unordered_map<uint64_t, InlinedVector<Entry, 1>> entries_;
+};
+
+}  // namespace onnxruntime
@@ -1,10 +1,14 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "core/framework/stream_execution_context.h"
+
+#include <optional>
+
 #include "core/framework/execution_provider.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/session_state.h"
+#include "core/framework/sequential_executor.h"
 #include "core/common/spin_pause.h"
 
 namespace onnxruntime {
@@ -62,6 +66,14 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
   for (size_t i = 0; i < release_actions.size(); ++i) {
     release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
   }
+  // init the dependency counts of the nodes for dataflow execution
+  auto& dataflow_nodes = sess_state.GetExecutionPlan()->dataflow_nodes;
+  if (!dataflow_nodes.empty()) {
+    dataflow_dependencies_ = std::make_unique<std::atomic_size_t[]>(dataflow_nodes.size());
+    for (size_t i = 0; i < dataflow_nodes.size(); ++i) {
+      dataflow_dependencies_[i].store(dataflow_nodes[i].num_dependencies, std::memory_order_relaxed);
+    }
+  }
 }
 
 synchronize::Notification* StreamExecutionContext ::GetNotification(size_t idx) { return notifications_[idx].get(); }
@@ -114,6 +126,14 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
   for (size_t i = 0; i < release_actions.size(); ++i) {
     release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
   }
+  // init the dependency counts of the nodes for dataflow execution
+  auto& dataflow_nodes = sess_state.GetExecutionPlan()->dataflow_nodes;
+  if (!dataflow_nodes.empty()) {
+    dataflow_dependencies_ = std::make_unique<std::atomic_size_t[]>(dataflow_nodes.size());
+    for (size_t i = 0; i < dataflow_nodes.size(); ++i) {
+      dataflow_dependencies_[i].store(dataflow_nodes[i].num_dependencies, std::memory_order_relaxed);
+    }
+  }
 }
 
 synchronize::Notification* StreamExecutionContext ::GetNotification(size_t /*idx*/) {
@@ -261,4 +281,79 @@ void ScheduleDownstream(StreamExecutionContext& ctx, size_t trigger, bool single
   }
 }
 
+void RunDataflowSince(StreamExecutionContext& ctx, SessionScope& session_scope, const bool& terminate_flag,
+                      size_t position) {
+  auto* plan = ctx.GetSessionState().GetExecutionPlan();
+  auto& dataflow_nodes = plan->dataflow_nodes;
+  auto* tp = ctx.SingleThreadMode() ? nullptr : ctx.GetSessionState().GetInterOpThreadPool();
+
+  // nodes made ready that are run on the current thread, without a thread pool
+  InlinedVector<size_t> ready_nodes;
+  for (;;) {
+    if (!ctx.TaskStatus().IsOK()) {
+      break;
+    }
+    if (terminate_flag) {
+      Status status_made = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+      ctx.SetStatus(status_made);
+      break;
+    }
+
+    const auto& dataflow_node = dataflow_nodes[position];
+    const NodeIndex node_index = dataflow_node.node_index;
+    Status status;
+#ifdef ENABLE_TRAINING
+    // legacy code required by ORTTrainer. Should be removed when ORTTrainer is removed
+    auto* node_to_execute = ctx.GetNodeToExecute();
+    const bool skip_node = node_to_execute && node_to_execute->count(node_index) == 0;
+#else
+    constexpr bool skip_node = false;
+#endif
+    if (!skip_node) {
+      ORT_TRY {
+        status = ExecuteKernel(ctx, node_index, plan->node_stream_map_[node_index], terminate_flag, session_scope,
+                               dataflow_node.use_intra_op_thread_pool);
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+        });
+      }
+    }
+    if (!status.IsOK()) {
+      ctx.SetStatus(status);
+      break;
+    }
+
+    // the dependent with the highest priority made ready continues on this thread, the others run concurrently
+    std::optional<size_t> next;
+    for (size_t dependent : dataflow_node.dependents) {
+      if (!ctx.DecDataflowDependency(dependent)) {
+        continue;
+      }
+      if (!next.has_value()) {
+        next = dependent;
+      } else if (tp) {
+        ctx.AddTask();
+        concurrency::ThreadPool::Schedule(tp, [&ctx, &session_scope, &terminate_flag, dependent]() {
+          RunDataflowSince(ctx, session_scope, terminate_flag, dependent);
+        });
+      } else {
+        ready_nodes.push_back(dependent);
+      }
+    }
+
+    if (next.has_value()) {
+      position = *next;
+    } else if (!ready_nodes.empty()) {
+      position = ready_nodes.back();
+      ready_nodes.pop_back();
+    } else {
+      break;
+    }
+  }
+
+  ctx.CompleteTask();
+}
+
 }  // namespace onnxruntime
@@ -43,11 +43,12 @@ class StreamExecutionContext {
     }
 
     bool Dec() {
-      return v_.fetch_sub(1, std::memory_order_relaxed) == 1;
+      // release the work done before, so that it is visible to the thread observing the count reaching 0
+      return v_.fetch_sub(1, std::memory_order_acq_rel) == 1;
     }
 
     int32_t Get() {
-      return gsl::narrow_cast<int32_t>(v_.load(std::memory_order_relaxed));
+      return gsl::narrow_cast<int32_t>(v_.load(std::memory_order_acquire));
     }
 
     void Inc() {
@@ -116,6 +117,13 @@ class StreamExecutionContext {
   // Release the OrtValues after a step, based on the execution plan.
   void RecycleNodeInputs(onnxruntime::NodeIndex node_index);
 
+  // Decrease the count of remaining dependencies of the dataflow node at 'position' in the execution plan.
+  // Returns true if it was the last one, i.e. the node is ready to run.
+  bool DecDataflowDependency(size_t position) {
+    // acquire the outputs of the other dependencies and release ours to the thread running the node
+    return dataflow_dependencies_[position].fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
 #ifdef ENABLE_TRAINING
   void SetOrtValueCache(OrtValueCachePtr cache) {
     cache_ = std::move(cache);
@@ -156,6 +164,9 @@ class StreamExecutionContext {
 
   std::unique_ptr<std::atomic_int[]> release_plan_;
 
+  // remaining dependencies of each node for dataflow execution, indexed by position in the execution plan.
+  std::unique_ptr<std::atomic_size_t[]> dataflow_dependencies_;
+
   CountDownBarrier remain_tasks_;
 
   Status task_status_{Status::OK()};
@@ -189,6 +200,14 @@ void RunSince(size_t stream_idx,
               const bool& terminate_flag,
               size_t since);
 
+// Execute the dataflow node at 'position' in the execution plan with execution context 'ctx', then the nodes it
+// makes ready. One of them continues on the current thread and the others are scheduled on the inter-op thread pool,
+// whose workers steal them from each other's queues when idle.
+void RunDataflowSince(StreamExecutionContext& ctx,
+                      SessionScope& session_scope,
+                      const bool& terminate_flag,
+                      size_t position);
+
 // Schedule the downstream jobs from other streams at 'trigger' step, based on the execution plan.
 void ScheduleDownstream(StreamExecutionContext& ctx,
                         size_t trigger,
@@ -6,6 +6,7 @@
 #include <memory>
 #include <algorithm>
 #include <limits>
+#include <map>
 #include <string>
 #include <filesystem>
 #if defined(__wasm__)
@@ -1086,6 +1087,65 @@ Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::path& mo
   return Status::OK();
 }
 
+Status ReadaheadExternalData(const Env& env, const std::filesystem::path& model_path,
+                             gsl::span<const ONNX_NAMESPACE::TensorProto* const> tensor_protos,
+                             size_t max_gap, ExternalDataReadaheadStats& stats) {
+  std::basic_string<ORTCHAR_T> tensor_proto_dir;
+  if (!model_path.empty()) {
+    ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(model_path, tensor_proto_dir));
+  }
+
+  // std::map so the files are visited in a deterministic order
+  std::map<std::basic_string<ORTCHAR_T>, std::vector<Env::FileRange>> file_ranges;
+  for (const auto* tensor_proto : tensor_protos) {
+    if (!utils::HasExternalData(*tensor_proto)) {
+      continue;
+    }
+
+    std::basic_string<ORTCHAR_T> external_data_file_path;
+    FileOffsetType file_offset;
+    SafeInt<size_t> raw_data_safe_len = 0;
+    ORT_RETURN_IF_ERROR(GetExternalDataInfo(*tensor_proto, tensor_proto_dir, external_data_file_path, file_offset,
+                                            raw_data_safe_len));
+    if (external_data_file_path == onnxruntime::utils::kTensorProtoMemoryAddressTag || file_offset < 0 ||
+        raw_data_safe_len == 0) {
+      continue;
+    }
+
+    file_ranges[external_data_file_path].push_back({file_offset, static_cast<size_t>(raw_data_safe_len)});
+  }
+
+  for (auto& [file_path, ranges] : file_ranges) {
+    std::sort(ranges.begin(), ranges.end(), [](const Env::FileRange& a, const Env::FileRange& b) {
+      return a.offset < b.offset;
+    });
+
+    std::vector<Env::FileRange> coalesced;
+    for (const auto& range : ranges) {
+      if (!coalesced.empty()) {
+        auto& last = coalesced.back();
+        const FileOffsetType last_end = last.offset + static_cast<FileOffsetType>(last.length);
+        if (range.offset <= last_end + static_cast<FileOffsetType>(max_gap)) {
+          const FileOffsetType end = std::max(last_end, range.offset + static_cast<FileOffsetType>(range.length));
+          last.length = static_cast<size_t>(end - last.offset);
+          continue;
+        }
+      }
+      coalesced.push_back(range);
+    }
+
+    ORT_RETURN_IF_ERROR(env.ReadaheadFile(file_path.c_str(), coalesced));
+
+    ++stats.num_files;
+    stats.num_ranges += coalesced.size();
+    for (const auto& range : coalesced) {
+      stats.num_bytes += range.length;
+    }
+  }
+
+  return Status::OK();
+}
+
 Status LoadExtDataToTensorFromTensorProto(const Env& env, const std::filesystem::path& model_path,
                                           const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                           const IExternalDataLoader& ext_data_loader,
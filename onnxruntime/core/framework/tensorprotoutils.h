@@ -177,6 +177,20 @@ common::Status GetExtDataFromTensorProto(const Env& env, const std::filesystem::
                                          Tensor* buffered_tensor = nullptr,
                                          PrepackedWeightsForGraph* prepacked_for_graph = nullptr);
 
+// Statistics of the external data requested by ReadaheadExternalData().
+struct ExternalDataReadaheadStats {
+  size_t num_files = 0;
+  size_t num_ranges = 0;
+  size_t num_bytes = 0;
+};
+
+// Ask the OS to read the external data of the tensor protos into the page cache in the background, ahead of
+// GetExtDataFromTensorProto() or LoadExtDataToTensorFromTensorProto() consuming it. Ranges of the same file that are
+// at most max_gap bytes apart are coalesced into a single request, in file order.
+common::Status ReadaheadExternalData(const Env& env, const std::filesystem::path& model_path,
+                                     gsl::span<const ONNX_NAMESPACE::TensorProto* const> tensor_protos,
+                                     size_t max_gap, ExternalDataReadaheadStats& stats);
+
 // Given a tensor proto with external data obtain a tensor using the specified custom external data loader.
 common::Status LoadExtDataToTensorFromTensorProto(const Env& env, const std::filesystem::path& model_path,
                                                   const ONNX_NAMESPACE::TensorProto& tensor_proto,
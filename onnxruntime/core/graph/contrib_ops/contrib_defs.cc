@@ -2263,6 +2263,42 @@ ONNX_MS_OPERATOR_SET_SCHEMA(SparseToDenseMatMul, 1,
                                   sparseCompatibleMatmulShapeInference(ctx, 0, 1);
                                 }));
 
+constexpr const char* MultiLoraMatMul_ver1_doc = R"DOC(
+Adds the low rank update of a LoRA adapter to the output of a MatMul, selecting the adapter per batch entry:
+`Y[b] = base_output[b] + scale * (A[b] x lora_a[i] x lora_b[i])` with `i = adapter_indices[b]`.
+
+The base weights are applied once for the whole batch by the MatMul producing `base_output`, so requests using
+different fine-tuned variants of a model can share a batch. The adapters are stacked in `lora_a` and `lora_b`, which
+are usually initializers kept resident by the session, e.g. memory mapped from external data. Consecutive batch
+entries using the same adapter are computed by a single GEMM, so grouping the batch by adapter is more efficient.
+A negative adapter index selects the base model, `Y[b] = base_output[b]`.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(MultiLoraMatMul, 1,
+                            OpSchema()
+                                .SetDoc(MultiLoraMatMul_ver1_doc)
+                                .Attr("scale",
+                                      "Scaling factor of the low rank update, usually alpha / rank.",
+                                      AttributeProto::FLOAT,
+                                      1.0f)
+                                .Input(0, "A", "Input of the MatMul with shape (batch_size, ..., K)", "T")
+                                .Input(1, "base_output",
+                                       "Output of the MatMul of A with the base weights, with shape (batch_size, ..., N)", "T")
+                                .Input(2, "lora_a", "Stacked LoRA A matrices with shape (num_adapters, K, rank)", "T")
+                                .Input(3, "lora_b", "Stacked LoRA B matrices with shape (num_adapters, rank, N)", "T")
+                                .Input(4, "adapter_indices",
+                                       "Index of the adapter used by each batch entry with shape (batch_size). "
+                                       "A negative index selects no adapter.",
+                                       "tensor(int32)")
+                                .Output(0, "Y", "Output with the same shape as base_output", "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 1, 0);
+                                  if (hasInputShape(ctx, 1)) {
+                                    propagateShapeFromInputToOutput(ctx, 1, 0);
+                                  }
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(MurmurHash3, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(The underlying implementation is MurmurHash3_x86_32 generating low latency 32bits hash suitable for implementing lookup tables, Bloom filters, count min sketch or feature hashing.)DOC")
@@ -61,6 +61,12 @@ using ExternalDataReader = std::function<Status(uint64_t offset, gsl::span<uint8
 /// </remarks>
 constexpr uint32_t kMinimumSizeForExternalData = 64;
 
+/// <summary>
+/// Alignment of the raw data of initializers saved in an ORT format model, relative to the start of the model bytes.
+/// Initializers can then be used in place when the model bytes are memory mapped, or otherwise at least as aligned.
+/// </summary>
+constexpr size_t kInitializerRawDataAlignment = 64;
+
 /// <summary>
 /// Save an initializer to an ORT format flatbuffer.
 /// </summary>
@@ -755,6 +755,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -784,9 +785,16 @@ struct MLAS_CONV_PARAMETERS {
             CBLAS_TRANSPOSE TransB;
             size_t ldb;
         } GemmDirect;
+        struct {
+            size_t StrideK;
+        } ExpandThenGemm;
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileRowsPerBlock;
+            size_t BlockCount;
+        } Winograd;
     } u;
 };
 
@@ -806,7 +814,8 @@ MlasConvPrepare(MLAS_CONV_PARAMETERS* Parameters,
                 const MLAS_ACTIVATION* Activation,
                 size_t* WorkingBufferSize,
                 float Beta,
-                MLAS_THREADPOOL* ThreadPool);
+                MLAS_THREADPOOL* ThreadPool,
+                bool UseWinogradPackedFilter = false);
 
 void
 MLASCALL
@@ -820,6 +829,42 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd F(2x2, 3x3) convolution support. The filter transform is done once
+// by MlasConvWinogradPackFilter, typically when the weights are prepacked. The
+// packed filter is then passed to MlasConv in place of the original filter
+// after preparing the convolution with UseWinogradPackedFilter set.
+//
+
+bool
+MLASCALL
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    size_t InputChannels,
+    size_t FilterCount,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    );
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* PackedFilter
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -23,6 +23,25 @@ Abstract:
 #define MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD \
     (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK)
 
+//
+// Define the maximum number of working buffer elements used to expand the
+// input tensor for the MlasConvAlgorithmExpandThenGemm algorithm. This is the
+// same amount of memory used by the segmented algorithm at the maximum thread
+// count. Larger expansions are split along the K dimension.
+//
+
+#define MLAS_CONV_EXPAND_WORKING_BUFFER_SIZE \
+    (MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD * MLAS_MAXIMUM_THREAD_COUNT)
+
+//
+// Define the alignment of the K slices used by the ExpandThenGemm algorithm.
+// This is a multiple of every K stride selected by MlasSgemmOperation, so that
+// accumulating the slices produces the same result as a single GEMM.
+//
+
+#define MLAS_CONV_EXPAND_STRIDEK_ALIGN \
+    (MLAS_SGEMM_STRIDEK * 8)
+
 //
 // Define the parameters to execute segments of a convolution operation on
 // worker threads.
@@ -874,6 +893,16 @@ Return Value:
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    //
+    // The Winograd algorithm schedules batches, groups and tiles across
+    // multiple threads itself.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+        MlasConvWinograd(Parameters, Input, Filter, Bias, WorkingBuffer, Output, ThreadPool);
+        return;
+    }
+
     //
     // Schedule batches of GEMMs across multiple threads.
     //
@@ -952,19 +981,37 @@ Return Value:
                 case MlasConvAlgorithmExpandThenGemm:
                 {
                     //
-                    // Expand the input tensor to the working buffer and then invoke the
-                    // threaded GEMM.
+                    // Expand a slice of the input tensor along the K dimension to
+                    // the working buffer and then invoke the threaded GEMM. The
+                    // slices bound the size of the working buffer for large
+                    // filters.
                     //
 
-                    if (Parameters->Dimensions == 2) {
-                        MlasConvIm2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
-                    } else {
-                        MlasConvVol2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
-                    }
+                    const size_t StrideK = Parameters->u.ExpandThenGemm.StrideK;
+
+                    size_t CountK;
+                    float beta = Parameters->Beta;
+
+                    for (size_t k = 0; k < K; k += CountK) {
+
+                        CountK = K - k;
 
-                    MlasGemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
-                             K, WorkingBuffer, OutputSize, Parameters->Beta, Output, OutputSize,
-                             ThreadPool);
+                        if (CountK > StrideK) {
+                            CountK = StrideK;
+                        }
+
+                        if (Parameters->Dimensions == 2) {
+                            MlasConvIm2Col(Parameters, Input, WorkingBuffer, k, CountK, 0, OutputSize);
+                        } else {
+                            MlasConvVol2Col(Parameters, Input, WorkingBuffer, k, CountK, 0, OutputSize);
+                        }
+
+                        MlasGemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, CountK, 1.0f,
+                                 filter + k, K, WorkingBuffer, OutputSize, beta, Output, OutputSize,
+                                 ThreadPool);
+
+                        beta = 1.0f;
+                    }
 
                     //
                     // Apply the activation with optional bias.
@@ -1041,7 +1088,8 @@ MlasConvPrepare(
     const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize,
     float Beta,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    bool UseWinogradPackedFilter
     )
 /*++
 
@@ -1088,6 +1136,10 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    UseWinogradPackedFilter - Supplies true if the filter passed to MlasConv
+        was transformed by MlasConvWinogradPackFilter. The caller must have
+        checked MlasConvWinogradIsSupported for this convolution.
+
 Return Value:
 
     None.
@@ -1168,6 +1220,11 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    if (UseWinogradPackedFilter) {
+        MlasConvWinogradPrepare(Parameters, WorkingBufferSize, ThreadPool);
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
@@ -1215,12 +1272,31 @@ Return Value:
 
         //
         // The filter count is larger than the output dimensions, so perform the
-        // full matrix expansion and then invoke the threaded GEMM.
+        // matrix expansion and then invoke the threaded GEMM. The expansion is
+        // done in slices of the K dimension if the full expansion would exceed
+        // the working buffer limit.
         //
 
+        size_t StrideK = K;
+
+        if (OutputSize * K > MLAS_CONV_EXPAND_WORKING_BUFFER_SIZE) {
+
+            StrideK = (MLAS_CONV_EXPAND_WORKING_BUFFER_SIZE / OutputSize) &
+                ~(size_t(MLAS_CONV_EXPAND_STRIDEK_ALIGN) - 1);
+
+            if (StrideK < MLAS_CONV_EXPAND_STRIDEK_ALIGN) {
+                StrideK = MLAS_CONV_EXPAND_STRIDEK_ALIGN;
+            }
+
+            if (StrideK > K) {
+                StrideK = K;
+            }
+        }
+
         Parameters->Algorithm = MlasConvAlgorithmExpandThenGemm;
+        Parameters->u.ExpandThenGemm.StrideK = StrideK;
 
-        *WorkingBufferSize = OutputSize * K;
+        *WorkingBufferSize = OutputSize * StrideK;
 
     } else {
 
@@ -0,0 +1,697 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convolve_winograd.cpp
+
+Abstract:
+
+    This module implements the single precision Winograd F(2x2, 3x3)
+    convolution algorithm.
+
+    The input image is split into overlapping 4x4 tiles that each produce a
+    2x2 block of output. The filter and input tiles are transformed to the
+    Winograd domain, where the convolution becomes 16 independent matrix
+    multiplications of [FilterCount, InputChannels] x [InputChannels, Tiles].
+    The products are then transformed back to the spatial domain.
+
+    Only F(2x2, 3x3) is implemented. Larger output tiles such as F(4x4, 3x3)
+    reduce the multiplication count further, but the transform constants grow
+    and the numerical error becomes noticeably larger than the GEMM based
+    algorithms.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of elements in a transformed 4x4 tile.
+//
+
+#define MLAS_WINOGRAD_TILE_ELEMENTS 16
+
+//
+// Define the minimum number of input channels and filters for which the
+// Winograd algorithm is selected. Below this, the cost of the input and output
+// transforms outweighs the reduction in multiplications.
+//
+
+#define MLAS_WINOGRAD_MINIMUM_CHANNELS 16
+
+//
+// Define the target number of tiles processed per block. Blocks are built from
+// whole rows of tiles so that the activation can be applied to a contiguous
+// range of each output channel.
+//
+
+#define MLAS_WINOGRAD_TARGET_TILES_PER_BLOCK 64
+
+//
+// Define the parameters to execute segments of a Winograd convolution on
+// worker threads.
+//
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* PackedFilter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+    ptrdiff_t TargetThreadCount;
+};
+
+bool
+MLASCALL
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    size_t InputChannels,
+    size_t FilterCount,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether a convolution can be executed with the
+    Winograd F(2x2, 3x3) algorithm and whether that is expected to be faster
+    than the GEMM based algorithms.
+
+    The result only depends on the filter and the convolution attributes, so
+    the caller can decide to pack the filter before the input shape is known.
+
+Arguments:
+
+    Dimensions - Supplies the number of dimensions.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    StrideShape - Supplies the shape of the stride.
+
+Return Value:
+
+    Returns true if the Winograd algorithm should be used, else false.
+
+--*/
+{
+    if (Dimensions != 2) {
+        return false;
+    }
+
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+
+        if (KernelShape[dim] != 3 || DilationShape[dim] != 1 || StrideShape[dim] != 1) {
+            return false;
+        }
+    }
+
+    return InputChannels >= MLAS_WINOGRAD_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_WINOGRAD_MINIMUM_CHANNELS;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of elements required to store the
+    transformed filter for the Winograd algorithm.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+Return Value:
+
+    Returns the number of float elements of the packed filter buffer.
+
+--*/
+{
+    return GroupCount * MLAS_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a 3x3 filter tensor to the Winograd domain by
+    computing U = G * g * G^T for each filter and input channel.
+
+    The packed filter is stored as [GroupCount][16][FilterCount][InputChannels]
+    so that each of the 16 transformed elements forms the A matrix of one
+    GEMM.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    Filter - Supplies the filter tensor in [GroupCount * FilterCount,
+        InputChannels, 3, 3] layout.
+
+    PackedFilter - Supplies the buffer to receive the transformed filter. The
+        buffer size is returned by MlasConvWinogradPackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t MatrixSize = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                const float* g = Filter + ((group * FilterCount + f) * InputChannels + c) * 9;
+
+                //
+                // Compute G * g, where G is:
+                //
+                //  [ 1    0    0   ]
+                //  [ 1/2  1/2  1/2 ]
+                //  [ 1/2 -1/2  1/2 ]
+                //  [ 0    0    1   ]
+                //
+
+                float t[4][3];
+
+                for (size_t col = 0; col < 3; col++) {
+                    const float g0 = g[col];
+                    const float g1 = g[3 + col];
+                    const float g2 = g[6 + col];
+                    t[0][col] = g0;
+                    t[1][col] = 0.5f * (g0 + g1 + g2);
+                    t[2][col] = 0.5f * (g0 - g1 + g2);
+                    t[3][col] = g2;
+                }
+
+                //
+                // Compute (G * g) * G^T and scatter the result.
+                //
+
+                float* u = PackedFilter + f * InputChannels + c;
+
+                for (size_t row = 0; row < 4; row++) {
+                    const float t0 = t[row][0];
+                    const float t1 = t[row][1];
+                    const float t2 = t[row][2];
+                    u[(row * 4 + 0) * MatrixSize] = t0;
+                    u[(row * 4 + 1) * MatrixSize] = 0.5f * (t0 + t1 + t2);
+                    u[(row * 4 + 2) * MatrixSize] = 0.5f * (t0 - t1 + t2);
+                    u[(row * 4 + 3) * MatrixSize] = t2;
+                }
+            }
+        }
+
+        PackedFilter += MLAS_WINOGRAD_TILE_ELEMENTS * MatrixSize;
+    }
+}
+
+void
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the blocking and threading parameters for a Winograd
+    convolution.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+
+    const size_t TileRows = (OutputHeight + 1) / 2;
+    const size_t TileColumns = (OutputWidth + 1) / 2;
+
+    size_t TileRowsPerBlock = MLAS_WINOGRAD_TARGET_TILES_PER_BLOCK / TileColumns;
+
+    if (TileRowsPerBlock == 0) {
+        TileRowsPerBlock = 1;
+    } else if (TileRowsPerBlock > TileRows) {
+        TileRowsPerBlock = TileRows;
+    }
+
+    const size_t BlockCount = (TileRows + TileRowsPerBlock - 1) / TileRowsPerBlock;
+    const size_t TotalWork = Parameters->BatchCount * Parameters->GroupCount * BlockCount;
+
+    ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(TargetThreadCount) >= TotalWork) {
+        TargetThreadCount = ptrdiff_t(TotalWork);
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->ThreadCount = TargetThreadCount;
+    Parameters->u.Winograd.TileRowsPerBlock = TileRowsPerBlock;
+    Parameters->u.Winograd.BlockCount = BlockCount;
+
+    //
+    // Each thread needs space for the transformed input tiles and for the
+    // products of a block.
+    //
+
+    const size_t TilesPerBlock = TileRowsPerBlock * TileColumns;
+
+    *WorkingBufferSize = size_t(TargetThreadCount) * MLAS_WINOGRAD_TILE_ELEMENTS *
+        (Parameters->InputChannels + Parameters->FilterCount) * TilesPerBlock;
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTransformInput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    float* TransformedInput,
+    size_t TileRowStart,
+    size_t TileCount
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of 4x4 input tiles to the Winograd domain
+    by computing V = B^T * d * B.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the current batch and group.
+
+    TransformedInput - Supplies the buffer to receive the transformed tiles in
+        [16][InputChannels][TileCount] layout.
+
+    TileRowStart - Supplies the first row of tiles of the block.
+
+    TileCount - Supplies the number of tiles in the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t TileColumns = (Parameters->OutputShape[1] + 1) / 2;
+    const size_t MatrixSize = InputChannels * TileCount;
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        const float* input = Input + c * InputSize;
+        float* v = TransformedInput + c * TileCount;
+
+        for (size_t t = 0; t < TileCount; t++) {
+
+            //
+            // Gather the 4x4 input tile, substituting zero for the padding.
+            // The unsigned arithmetic wraps for rows and columns above or to
+            // the left of the image, which the bounds checks then reject.
+            //
+
+            const size_t ih = (TileRowStart + t / TileColumns) * 2 - PaddingTop;
+            const size_t iw = (t % TileColumns) * 2 - PaddingLeft;
+
+            float d[4][4];
+
+            if (ih + 4 <= InputHeight && iw + 4 <= InputWidth && ih < InputHeight && iw < InputWidth) {
+
+                const float* row = input + ih * InputWidth + iw;
+
+                for (size_t r = 0; r < 4; r++) {
+                    d[r][0] = row[0];
+                    d[r][1] = row[1];
+                    d[r][2] = row[2];
+                    d[r][3] = row[3];
+                    row += InputWidth;
+                }
+
+            } else {
+
+                for (size_t r = 0; r < 4; r++) {
+                    for (size_t col = 0; col < 4; col++) {
+                        const size_t y = ih + r;
+                        const size_t x = iw + col;
+                        d[r][col] = (y < InputHeight && x < InputWidth) ? input[y * InputWidth + x] : 0.0f;
+                    }
+                }
+            }
+
+            //
+            // Compute B^T * d, where B^T is:
+            //
+            //  [ 1  0 -1  0 ]
+            //  [ 0  1  1  0 ]
+            //  [ 0 -1  1  0 ]
+            //  [ 0  1  0 -1 ]
+            //
+
+            float s[4][4];
+
+            for (size_t col = 0; col < 4; col++) {
+                s[0][col] = d[0][col] - d[2][col];
+                s[1][col] = d[1][col] + d[2][col];
+                s[2][col] = d[2][col] - d[1][col];
+                s[3][col] = d[1][col] - d[3][col];
+            }
+
+            //
+            // Compute (B^T * d) * B and scatter the result.
+            //
+
+            for (size_t r = 0; r < 4; r++) {
+                v[(r * 4 + 0) * MatrixSize + t] = s[r][0] - s[r][2];
+                v[(r * 4 + 1) * MatrixSize + t] = s[r][1] + s[r][2];
+                v[(r * 4 + 2) * MatrixSize + t] = s[r][2] - s[r][1];
+                v[(r * 4 + 3) * MatrixSize + t] = s[r][1] - s[r][3];
+            }
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTransformOutput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Products,
+    float* Output,
+    size_t TileRowStart,
+    size_t TileCount
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of products back to the spatial domain by
+    computing Y = A^T * m * A and stores the 2x2 output tiles.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Products - Supplies the products in [16][FilterCount][TileCount] layout.
+
+    Output - Supplies the output tensor for the current batch and group.
+
+    TileRowStart - Supplies the first row of tiles of the block.
+
+    TileCount - Supplies the number of tiles in the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t TileColumns = (OutputWidth + 1) / 2;
+    const size_t MatrixSize = FilterCount * TileCount;
+    const float Beta = Parameters->Beta;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        const float* m = Products + f * TileCount;
+        float* output = Output + f * OutputSize;
+
+        for (size_t t = 0; t < TileCount; t++) {
+
+            //
+            // Compute A^T * m, where A^T is:
+            //
+            //  [ 1  1  1  0 ]
+            //  [ 0  1 -1 -1 ]
+            //
+
+            float s[2][4];
+
+            for (size_t col = 0; col < 4; col++) {
+                const float m0 = m[(0 * 4 + col) * MatrixSize + t];
+                const float m1 = m[(1 * 4 + col) * MatrixSize + t];
+                const float m2 = m[(2 * 4 + col) * MatrixSize + t];
+                const float m3 = m[(3 * 4 + col) * MatrixSize + t];
+                s[0][col] = m0 + m1 + m2;
+                s[1][col] = m1 - m2 - m3;
+            }
+
+            //
+            // Compute (A^T * m) * A and store the 2x2 output tile, clipping
+            // against the bottom and right edges of the output.
+            //
+
+            const size_t oh = (TileRowStart + t / TileColumns) * 2;
+            const size_t ow = (t % TileColumns) * 2;
+
+            for (size_t r = 0; r < 2 && oh + r < OutputHeight; r++) {
+
+                float* row = output + (oh + r) * OutputWidth + ow;
+
+                float y0 = s[r][0] + s[r][1] + s[r][2];
+                float y1 = s[r][1] - s[r][2] - s[r][3];
+
+                if (Beta != 0.0f) {
+                    y0 += Beta * row[0];
+                }
+                row[0] = y0;
+
+                if (ow + 1 < OutputWidth) {
+                    if (Beta != 0.0f) {
+                        y1 += Beta * row[1];
+                    }
+                    row[1] = y1;
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+    The work is partitioned over batches, groups and blocks of tile rows. Each
+    block is transformed, multiplied and transformed back independently.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WINOGRAD_WORK_BLOCK* WorkBlock = (MLAS_CONV_WINOGRAD_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t GroupCount = Parameters->GroupCount;
+
+    const size_t TileRows = (OutputHeight + 1) / 2;
+    const size_t TileColumns = (OutputWidth + 1) / 2;
+    const size_t TileRowsPerBlock = Parameters->u.Winograd.TileRowsPerBlock;
+    const size_t BlockCount = Parameters->u.Winograd.BlockCount;
+    const size_t MaximumTilesPerBlock = TileRowsPerBlock * TileColumns;
+
+    const size_t InputGroupSize = InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * OutputSize;
+    const size_t PackedFilterGroupSize = MLAS_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+
+    float* TransformedInput = WorkBlock->WorkingBuffer + Index * MLAS_WINOGRAD_TILE_ELEMENTS *
+        (InputChannels + FilterCount) * MaximumTilesPerBlock;
+    float* Products = TransformedInput + MLAS_WINOGRAD_TILE_ELEMENTS * InputChannels * MaximumTilesPerBlock;
+
+    //
+    // Compute the range of blocks to use for this thread.
+    //
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount,
+        Parameters->BatchCount * GroupCount * BlockCount, &WorkIndex, &WorkRemaining);
+
+    while (WorkRemaining > 0) {
+
+        const size_t BatchGroup = WorkIndex / BlockCount;
+        const size_t Block = WorkIndex % BlockCount;
+        const size_t group = BatchGroup % GroupCount;
+
+        const float* input = WorkBlock->Input + BatchGroup * InputGroupSize;
+        const float* filter = WorkBlock->PackedFilter + group * PackedFilterGroupSize;
+        const float* bias = WorkBlock->Bias != nullptr ? WorkBlock->Bias + group * FilterCount : nullptr;
+        float* output = WorkBlock->Output + BatchGroup * OutputGroupSize;
+
+        const size_t TileRowStart = Block * TileRowsPerBlock;
+        const size_t TileRowCount = std::min(TileRowsPerBlock, TileRows - TileRowStart);
+        const size_t TileCount = TileRowCount * TileColumns;
+
+        MlasConvWinogradTransformInput(Parameters, input, TransformedInput, TileRowStart, TileCount);
+
+        //
+        // Multiply the transformed filter by the transformed input for each
+        // of the 16 elements of the Winograd domain.
+        //
+
+        for (size_t k = 0; k < MLAS_WINOGRAD_TILE_ELEMENTS; k++) {
+
+            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileCount,
+                InputChannels, 1.0f, filter + k * FilterCount * InputChannels, InputChannels,
+                TransformedInput + k * InputChannels * TileCount, TileCount, 0.0f,
+                Products + k * FilterCount * TileCount, TileCount);
+        }
+
+        MlasConvWinogradTransformOutput(Parameters, Products, output, TileRowStart, TileCount);
+
+        //
+        // Apply the activation with optional bias to the output rows covered
+        // by this block.
+        //
+
+        const size_t OutputRowStart = TileRowStart * 2;
+        const size_t OutputRowCount = std::min(OutputHeight, (TileRowStart + TileRowCount) * 2) - OutputRowStart;
+
+        MlasActivation(Parameters->Activation, output + OutputRowStart * OutputWidth, bias,
+            FilterCount, OutputRowCount * OutputWidth, OutputSize);
+
+        WorkIndex++;
+        WorkRemaining--;
+    }
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd F(2x2, 3x3) convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    PackedFilter - Supplies the filter transformed by
+        MlasConvWinogradPackFilter.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.PackedFilter = PackedFilter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+    WorkBlock.TargetThreadCount = Parameters->ThreadCount;
+
+    MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
+}
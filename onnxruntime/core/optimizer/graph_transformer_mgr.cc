@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+
+#include <optional>
+
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 using namespace onnxruntime;
@@ -26,14 +29,30 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     return Status::OK();
   }
 
+  // A transformer that did not modify the graph would not modify it if applied again to the same graph.
+  // Track the number of modifications made so far and the value it had when each transformer last ran without
+  // modifying the graph, and skip the transformer until another transformer modifies the graph.
+  size_t num_modifications = 0;
+  InlinedVector<std::optional<size_t>> unmodified_at(transformers->second.size());
+
   for (unsigned step = 0; step < steps_; ++step) {
     bool graph_changed = false;
-    for (const auto& transformer : transformers->second) {
+    for (size_t i = 0; i < transformers->second.size(); ++i) {
+      const auto& transformer = transformers->second[i];
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      if (unmodified_at[i] == num_modifications)
+        continue;
+
       bool modified = false;
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+      if (modified) {
+        ++num_modifications;
+        unmodified_at[i].reset();
+      } else {
+        unmodified_at[i] = num_modifications;
+      }
       graph_changed = graph_changed || modified;
     }
     if (!graph_changed) {
@@ -194,6 +194,77 @@ class Env {
   virtual common::Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
                                            MappedMemoryPtr& mapped_memory) const = 0;
 
+  struct FileRange {
+    FileOffsetType offset;
+    size_t length;
+  };
+
+  /**
+   * Asks the OS to start reading ranges of a file into the page cache in the background, so that later reads of the
+   * ranges or accesses through MapFileIntoMemory() do not wait for the storage. This is advisory and a no-op where
+   * not supported.
+   * @param file_path The path to the file.
+   * @param ranges The ranges of the file to read ahead.
+   */
+  virtual common::Status ReadaheadFile(_In_z_ const ORTCHAR_T* file_path, gsl::span<const FileRange> ranges) const {
+    ORT_UNUSED_PARAMETER(file_path);
+    ORT_UNUSED_PARAMETER(ranges);
+    return Status::OK();
+  }
+
+  /**
+   * Gets the alignment large allocations should use so that AdviseMemoryPlacement() applies to whole pages,
+   * or 0 if no memory placement policy is enabled.
+   */
+  virtual size_t GetMemoryPlacementAlignment() const { return 0; }
+
+  /**
+   * Applies the memory placement policy of the process to a large, long-lived memory region, e.g. an arena
+   * region or memory mapped weights. It should be called before the memory is first touched.
+   * On Linux the policy is set with environment variables:
+   * - ORT_TRANSPARENT_HUGE_PAGES=1 requests transparent huge pages for the region.
+   * - ORT_NUMA_INTERLEAVE=1 interleaves the pages of the region across the NUMA nodes the process may use.
+   * This is advisory, the memory can be used whether or not it succeeds.
+   * @return The first failure to apply the policy, e.g. if the NUMA policy of the process could not be read.
+   */
+  virtual common::Status AdviseMemoryPlacement(void* address, size_t length) const {
+    ORT_UNUSED_PARAMETER(address);
+    ORT_UNUSED_PARAMETER(length);
+    return common::Status::OK();
+  }
+
+  struct PageFaultCounts {
+    uint64_t minor = 0;
+    uint64_t major = 0;
+  };
+
+  /**
+   * Gets the number of page faults of the process so far, or zeros if not supported.
+   */
+  virtual PageFaultCounts GetPageFaultCounts() const { return {}; }
+
+  struct HardwareCounters {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t llc_misses = 0;
+    uint64_t branch_misses = 0;
+    // nanoseconds the counters were enabled and actually counting. the counters only count part of the time they are
+    // enabled when the hardware is multiplexed between more counters than it has, in which case the counts over an
+    // interval are estimated by scaling them by the ratio of the two times over the interval.
+    uint64_t time_enabled = 0;
+    uint64_t time_running = 0;
+  };
+
+  /**
+   * Gets the hardware performance counters of the calling thread in user mode so far.
+   * The counters of a thread are set up on its first call.
+   * Returns false if they are not available, e.g. not supported by the platform or not permitted.
+   */
+  virtual bool GetThreadHardwareCounters(HardwareCounters& counters) const {
+    ORT_UNUSED_PARAMETER(counters);
+    return false;
+  }
+
 #ifdef _WIN32
   /// \brief Returns true if the directory exists.
   virtual bool FolderExists(const std::wstring& path) const = 0;
@@ -25,7 +25,9 @@ limitations under the License.
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/ioctl.h>
 #include <sys/mman.h>
+#include <sys/resource.h>
 #if !defined(_AIX)
 #include <sys/syscall.h>
 #endif
@@ -49,6 +51,10 @@ limitations under the License.
 #include <sys/sysctl.h>
 #endif
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#endif
+
 #include "core/common/common.h"
 #include <gsl/gsl>
 #include "core/common/logging/logging.h"
@@ -104,6 +110,134 @@ long int TempFailureRetry(TFunc retriable_operation, TFuncArgs&&... args) {
   return result;
 }
 
+#if defined(__linux__)
+// Size of the PMD-mapped transparent huge pages on x86-64 and on arm64 with 4KB base pages.
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+// from linux/mempolicy.h
+constexpr int kMpolInterleave = 3;
+constexpr unsigned long kMpolFMemsAllowed = 1 << 2;
+constexpr unsigned long kMaxNumaNodes = 1024;
+
+struct MemoryPlacementPolicy {
+  bool transparent_huge_pages{false};
+  bool numa_interleave{false};
+  // NUMA nodes the process may allocate memory from, valid if numa_interleave is set
+  std::vector<unsigned long> numa_nodes;
+  // why NUMA interleaving is disabled although it was requested, if it is
+  common::Status numa_status;
+};
+
+const MemoryPlacementPolicy& GetMemoryPlacementPolicy() {
+  static const MemoryPlacementPolicy policy = []() {
+    MemoryPlacementPolicy p;
+    const char* thp = getenv("ORT_TRANSPARENT_HUGE_PAGES");
+    p.transparent_huge_pages = thp != nullptr && strcmp(thp, "1") == 0;
+
+    const char* interleave = getenv("ORT_NUMA_INTERLEAVE");
+    if (interleave != nullptr && strcmp(interleave, "1") == 0) {
+      constexpr size_t bits_per_word = sizeof(unsigned long) * 8;
+      p.numa_nodes.resize(kMaxNumaNodes / bits_per_word);
+      int mode = 0;
+      if (syscall(SYS_get_mempolicy, &mode, p.numa_nodes.data(), kMaxNumaNodes, nullptr, kMpolFMemsAllowed) == 0) {
+        size_t num_nodes = 0;
+        for (unsigned long word : p.numa_nodes) {
+          num_nodes += static_cast<size_t>(__builtin_popcountl(word));
+        }
+        // nothing to interleave across on a single node
+        p.numa_interleave = num_nodes > 1;
+      } else {
+        // reported by AdviseMemoryPlacement() as this may run before the default logger exists
+        auto [err_no, err_msg] = GetErrnoInfo();
+        p.numa_status = common::Status(common::SYSTEM, err_no,
+                                       "get_mempolicy failed, NUMA interleaving is disabled: " + err_msg);
+      }
+    }
+
+    return p;
+  }();
+
+  return policy;
+}
+#endif
+
+#if defined(__linux__)
+// Group of hardware counters of the thread, read together so their values cover the same interval.
+class ThreadHardwareCounters {
+ public:
+  ThreadHardwareCounters() {
+    constexpr uint64_t kCounters[kNumCounters] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                  PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (size_t i = 0; i < kNumCounters; ++i) {
+      perf_event_attr attr{};
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = kCounters[i];
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      // the group is enabled once all of its counters are opened
+      attr.disabled = i == 0 ? 1 : 0;
+
+      const int group_fd = i == 0 ? -1 : fds_[0];
+      fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+      if (fds_[i] == -1) {
+        auto [err_no, err_msg] = GetErrnoInfo();
+        LOGS_DEFAULT(INFO) << "perf_event_open failed, hardware counters are not available. error code: " << err_no
+                           << " error msg: " << err_msg;
+        Close();
+        return;
+      }
+    }
+
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  ~ThreadHardwareCounters() { Close(); }
+
+  bool Read(Env::HardwareCounters& counters) const {
+    if (fds_[0] == -1) {
+      return false;
+    }
+
+    struct {
+      uint64_t nr;
+      uint64_t time_enabled;
+      uint64_t time_running;
+      uint64_t values[kNumCounters];
+    } data;
+    if (read(fds_[0], &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data.nr != kNumCounters) {
+      return false;
+    }
+
+    counters.cycles = data.values[0];
+    counters.instructions = data.values[1];
+    counters.llc_misses = data.values[2];
+    counters.branch_misses = data.values[3];
+    counters.time_enabled = data.time_enabled;
+    counters.time_running = data.time_running;
+    return true;
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadHardwareCounters);
+
+ private:
+  static constexpr size_t kNumCounters = 4;
+
+  void Close() {
+    for (int& fd : fds_) {
+      if (fd != -1) {
+        close(fd);
+        fd = -1;
+      }
+    }
+  }
+
+  int fds_[kNumCounters] = {-1, -1, -1, -1};
+};
+#endif
+
 // nftw() callback to remove a file
 int nftw_remove(
     const char* fpath, const struct stat* /*sb*/,
@@ -449,6 +583,9 @@ class PosixEnv : public Env {
       return ReportSystemError("mmap", file_path);
     }
 
+    // advisory, the mapping is usable without it
+    ORT_IGNORE_RETURN_VALUE(AdviseMemoryPlacement(mapped_base, mapped_length));
+
     mapped_memory =
         MappedMemoryPtr{reinterpret_cast<char*>(mapped_base) + offset_to_page,
                         OrtCallbackInvoker{OrtCallback{UnmapFile, new UnmapFileParam{mapped_base, mapped_length}}}};
@@ -456,6 +593,101 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  common::Status ReadaheadFile(const ORTCHAR_T* file_path, gsl::span<const FileRange> ranges) const override {
+#if defined(__linux__) || defined(__FreeBSD__)
+    ORT_RETURN_IF_NOT(file_path, "file_path == nullptr");
+
+    ScopedFileDescriptor file_descriptor{open(file_path, O_RDONLY)};
+    if (!file_descriptor.IsValid()) {
+      return ReportSystemError("open", file_path);
+    }
+
+    for (const auto& range : ranges) {
+      // posix_fadvise() returns the error number instead of setting errno
+      const int err = posix_fadvise(file_descriptor.Get(), static_cast<off_t>(range.offset),
+                                    static_cast<off_t>(range.length), POSIX_FADV_WILLNEED);
+      if (err != 0) {
+        errno = err;
+        return ReportSystemError("posix_fadvise", file_path);
+      }
+    }
+#else
+    ORT_UNUSED_PARAMETER(file_path);
+    ORT_UNUSED_PARAMETER(ranges);
+#endif
+    return Status::OK();
+  }
+
+  size_t GetMemoryPlacementAlignment() const override {
+#if defined(__linux__)
+    const auto& policy = GetMemoryPlacementPolicy();
+    if (policy.transparent_huge_pages || policy.numa_interleave) {
+      return kHugePageSize;
+    }
+#endif
+    return 0;
+  }
+
+  common::Status AdviseMemoryPlacement(void* address, size_t length) const override {
+#if defined(__linux__)
+    const auto& policy = GetMemoryPlacementPolicy();
+    if (!policy.transparent_huge_pages && !policy.numa_interleave) {
+      return policy.numa_status;
+    }
+
+    // both only apply to whole pages and smaller regions would not fill a huge page anyway
+    static const uintptr_t page_size = narrow<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(address) + page_size - 1) & ~(page_size - 1);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(address) + length) & ~(page_size - 1);
+    if (end <= begin || end - begin < kHugePageSize) {
+      return policy.numa_status;
+    }
+
+    void* const region = reinterpret_cast<void*>(begin);
+    const size_t region_length = static_cast<size_t>(end - begin);
+
+    // both are attempted, the first failure is returned
+    common::Status status = policy.numa_status;
+    if (policy.transparent_huge_pages && madvise(region, region_length, MADV_HUGEPAGE) != 0 && status.IsOK()) {
+      auto [err_no, err_msg] = GetErrnoInfo();
+      status = common::Status(common::SYSTEM, err_no, "madvise(MADV_HUGEPAGE) failed: " + err_msg);
+    }
+
+    if (policy.numa_interleave &&
+        syscall(SYS_mbind, region, region_length, kMpolInterleave, policy.numa_nodes.data(), kMaxNumaNodes, 0) != 0 &&
+        status.IsOK()) {
+      auto [err_no, err_msg] = GetErrnoInfo();
+      status = common::Status(common::SYSTEM, err_no, "mbind(MPOL_INTERLEAVE) failed: " + err_msg);
+    }
+
+    return status;
+#else
+    ORT_UNUSED_PARAMETER(address);
+    ORT_UNUSED_PARAMETER(length);
+    return common::Status::OK();
+#endif
+  }
+
+  PageFaultCounts GetPageFaultCounts() const override {
+    PageFaultCounts counts;
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+      counts.minor = static_cast<uint64_t>(usage.ru_minflt);
+      counts.major = static_cast<uint64_t>(usage.ru_majflt);
+    }
+    return counts;
+  }
+
+  bool GetThreadHardwareCounters(HardwareCounters& counters) const override {
+#if defined(__linux__)
+    thread_local const ThreadHardwareCounters thread_counters;
+    return thread_counters.Read(counters);
+#else
+    ORT_UNUSED_PARAMETER(counters);
+    return false;
+#endif
+  }
+
   static common::Status ReportSystemError(const char* operation_name, const std::string& path) {
     auto [err_no, err_msg] = GetErrnoInfo();
     std::ostringstream oss;
@@ -17,6 +17,7 @@
 
 #include "core/providers/cpu/nn/conv.h"
 
+#include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/util/math_cpuonly.h"
@@ -153,20 +154,88 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack the filter, and only when the Winograd algorithm applies to every input shape
+  if (input_idx != 1 || !use_winograd_) {
+    return Status::OK();
+  }
+
+  const auto& W_shape = tensor.Shape();
+  TensorShapeVector kernel_shape;
+  if (W_shape.NumDimensions() != 4 || conv_attrs_.group <= 0 || W_shape[0] % conv_attrs_.group != 0 ||
+      !conv_attrs_.ComputeKernelShape(W_shape, kernel_shape).IsOK()) {
+    return Status::OK();
+  }
+
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+  if (dilations.size() != kernel_shape.size() || strides.size() != kernel_shape.size()) {
+    return Status::OK();
+  }
+
+  const size_t group_count = narrow<size_t>(conv_attrs_.group);
+  const size_t input_channels = narrow<size_t>(W_shape[1]);
+  const size_t filter_count = narrow<size_t>(W_shape[0] / conv_attrs_.group);
+  if (!MlasConvWinogradIsSupported(kernel_shape.size(), input_channels, filter_count,
+                                   kernel_shape.data(), dilations.data(), strides.data())) {
+    return Status::OK();
+  }
+
+  const size_t packed_W_size = SafeInt<size_t>(sizeof(float)) *
+                               MlasConvWinogradPackFilterSize(group_count, input_channels, filter_count);
+  packed_W_ = IAllocator::MakeUniquePtr<void>(alloc, packed_W_size, true);
+  MlasConvWinogradPackFilter(group_count, input_channels, filter_count, tensor.Data<float>(),
+                             static_cast<float*>(packed_W_.get()));
+  W_shape_ = W_shape;
+  is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_W_));
+    prepacked_weights->buffer_sizes_.push_back(packed_W_size);
+  }
+
+  LOGS_DEFAULT(VERBOSE) << "Conv node '" << Node().Name() << "' uses the Winograd F(2x2, 3x3) algorithm";
+
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_W_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
-  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* W = packed_W_ ? nullptr : context->Input<Tensor>(1);
+  const TensorShape& W_shape = W ? W->Shape() : W_shape_;
   const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
   const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
 
   // kernel_shape is an optional attribute and has to be inferred from W if not provided
   TensorShapeVector kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   ConvPadVector pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -231,7 +300,8 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &activation_,
                     &WorkingBufferSize,
                     Beta,
-                    thread_pool);
+                    thread_pool,
+                    packed_W_ != nullptr);
 
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
@@ -239,7 +309,7 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
 
     MlasConv(&Parameters,
              Xdata.data(),
-             W->Data<float>(),
+             packed_W_ ? static_cast<const float*>(packed_W_.get()) : W->Data<float>(),
              Bdata,
              static_cast<float*>(working_buffer.get()),
              Ydata.data(),
@@ -17,6 +17,8 @@
 
 #include "core/providers/cpu/nn/conv_transpose.h"
 
+#include <algorithm>
+
 #include "core/mlas/inc/mlas.h"
 #include "core/common/safeint.h"
 #include "core/util/math.h"
@@ -36,6 +38,35 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     ConvTranspose<float>);
 
+namespace {
+
+// Geometry of one output phase of a ConvTranspose along one spatial dimension.
+//
+// The outputs o with (o + pad_head) % stride == r only receive contributions from the kernel taps
+// r, r + stride, r + 2 * stride, ... Those outputs can therefore be computed by a regular stride 1
+// convolution of the input with the subset of taps, reversed, and written back with a stride.
+struct ConvTransposePhase {
+  int64_t kernel;        // number of kernel taps of the phase, 0 if none
+  int64_t output_start;  // first output position of the phase
+  int64_t output_count;  // number of output positions of the phase
+  int64_t pad_head;      // padding of the equivalent convolution
+  int64_t pad_tail;
+};
+
+ConvTransposePhase ComputeConvTransposePhase(int64_t input_size, int64_t output_size, int64_t kernel,
+                                             int64_t stride, int64_t pad_head, int64_t r) {
+  ConvTransposePhase phase;
+  phase.kernel = r < kernel ? (kernel - r + stride - 1) / stride : 0;
+  const int64_t first_q = pad_head > r ? (pad_head - r + stride - 1) / stride : 0;
+  phase.output_start = first_q * stride + r - pad_head;
+  phase.output_count = phase.output_start >= output_size ? 0 : (output_size - 1 - phase.output_start) / stride + 1;
+  phase.pad_head = phase.kernel - 1 - first_q;
+  phase.pad_tail = phase.output_count + first_q - input_size;
+  return phase;
+}
+
+}  // namespace
+
 template <typename T>
 Status ConvTranspose<T>::PrePack(const Tensor& /*tensor*/, int /*input_idx*/, AllocatorPtr /*alloc*/,
                                  /*out*/ bool& is_packed,
@@ -58,6 +89,55 @@ Status ConvTranspose<float>::PrePack(const Tensor& tensor, int input_idx, Alloca
     }
     filter_shape_ = tensor.Shape();
 
+    if (CanDecomposeIntoPhases(filter_shape_)) {
+      // Reorder the {C, M/group, kH, kW} filter into one {M, C/group, jH, jW} convolution filter per phase,
+      // with the taps of each phase reversed.
+      const size_t group = onnxruntime::narrow<size_t>(conv_transpose_attrs_.group);
+      const size_t input_channels = onnxruntime::narrow<size_t>(filter_shape_[0]) / group;
+      const size_t filter_count = onnxruntime::narrow<size_t>(filter_shape_[1]);
+      const int64_t kernel_h = filter_shape_[2];
+      const int64_t kernel_w = filter_shape_[3];
+      const int64_t stride_h = conv_transpose_attrs_.strides.empty() ? 1 : conv_transpose_attrs_.strides[0];
+      const int64_t stride_w = conv_transpose_attrs_.strides.empty() ? 1 : conv_transpose_attrs_.strides[1];
+
+      size_t phase_filter_data_size = SafeInt<size_t>(filter_shape_.Size()) * sizeof(float);
+      auto* phase_filter_data = static_cast<float*>(alloc->Alloc(phase_filter_data_size));
+      phase_filter_ = BufferUniquePtr(phase_filter_data, BufferDeleter(std::move(alloc)));
+
+      const float* filter_data = tensor.Data<float>();
+      float* dst = phase_filter_data;
+      for (int64_t ry = 0; ry < std::min(stride_h, kernel_h); ++ry) {
+        const int64_t jh = (kernel_h - ry + stride_h - 1) / stride_h;
+        for (int64_t rx = 0; rx < std::min(stride_w, kernel_w); ++rx) {
+          const int64_t jw = (kernel_w - rx + stride_w - 1) / stride_w;
+          for (size_t g = 0; g < group; ++g) {
+            for (size_t f = 0; f < filter_count; ++f) {
+              for (size_t c = 0; c < input_channels; ++c) {
+                const float* src = filter_data + ((g * input_channels + c) * filter_count + f) * kernel_h * kernel_w;
+                for (int64_t y = 0; y < jh; ++y) {
+                  const int64_t ky = ry + (jh - 1 - y) * stride_h;
+                  for (int64_t x = 0; x < jw; ++x) {
+                    const int64_t kx = rx + (jw - 1 - x) * stride_w;
+                    *dst++ = src[ky * kernel_w + kx];
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+
+      bool share_prepacked_weights = (prepacked_weights != nullptr);
+      if (share_prepacked_weights) {
+        prepacked_weights->buffers_.push_back(std::move(phase_filter_));
+        prepacked_weights->buffer_sizes_.push_back(phase_filter_data_size);
+      }
+
+      use_phase_filter_ = true;
+      is_packed = true;
+      return Status::OK();
+    }
+
     const size_t K = static_cast<size_t>(filter_shape_[0]) / onnxruntime::narrow<size_t>(conv_transpose_attrs_.group);
     const size_t N = onnxruntime::narrow<size_t>(filter_shape_.SizeFromDimension(1));
     auto packed_elements_per_group = N * K;
@@ -108,7 +188,11 @@ Status ConvTranspose<float>::UseSharedPrePackedBuffers(std::vector<BufferUniqueP
 
   if (input_idx == 1) {
     used_shared_buffers = true;
-    transposed_filter_ = std::move(prepacked_buffers[0]);
+    if (use_phase_filter_) {
+      phase_filter_ = std::move(prepacked_buffers[0]);
+    } else {
+      transposed_filter_ = std::move(prepacked_buffers[0]);
+    }
   }
 
   return Status::OK();
@@ -226,13 +310,17 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
   ConvTransposeAttributes::Prepare p;
   bool has_bias = dynamic_padding ? num_inputs == 4 : num_inputs == 3;
   ORT_RETURN_IF_ERROR(conv_transpose_attrs_.PrepareForCompute(
-      context, has_bias, p, dynamic_padding, transposed_filter_ ? &filter_shape_ : nullptr));
+      context, has_bias, p, dynamic_padding, (transposed_filter_ || use_phase_filter_) ? &filter_shape_ : nullptr));
 
   // Bail out early if one of the dimensions is zero.
   if (p.Y->Shape().Size() == 0) {
     return Status::OK();
   }
 
+  if (use_phase_filter_) {
+    return DoConvTransposePhases(context, p);
+  }
+
   const int64_t input_image_size = p.input_shape.Size();
   const int64_t X_offset = p.num_input_channels / conv_transpose_attrs_.group * input_image_size;
   const int64_t Y_offset = p.Y->Shape().Size() / p.Y->Shape()[0] / conv_transpose_attrs_.group;
@@ -317,4 +405,168 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
 
   return Status::OK();
 }
+
+template <>
+bool ConvTranspose<float>::CanDecomposeIntoPhases(const TensorShape& filter_shape) const {
+  // The phases are fixed at PrePack time, so the padding must not depend on the input. The com.microsoft
+  // ConvTransposeWithDynamicPads kernel derives from this one and reads its pads from an input.
+  if (Node().OpType() != "ConvTranspose" || filter_shape.NumDimensions() != 4 ||
+      !conv_transpose_attrs_.output_shape.empty() ||
+      (conv_transpose_attrs_.auto_pad != AutoPadType::NOTSET && conv_transpose_attrs_.auto_pad != AutoPadType::VALID) ||
+      conv_transpose_attrs_.group <= 0 || filter_shape[0] % conv_transpose_attrs_.group != 0) {
+    return false;
+  }
+
+  TensorShapeVector kernel_shape;
+  if (!conv_transpose_attrs_.ComputeKernelShape(filter_shape, kernel_shape).IsOK() || kernel_shape.size() != 2) {
+    return false;
+  }
+
+  const auto& attrs = conv_transpose_attrs_;
+  if ((!attrs.strides.empty() && attrs.strides.size() != 2) ||
+      (!attrs.dilations.empty() && attrs.dilations.size() != 2) ||
+      (!attrs.pads.empty() && attrs.pads.size() != 4) ||
+      (!attrs.output_padding.empty() && attrs.output_padding.size() != 2)) {
+    return false;
+  }
+
+  for (size_t dim = 0; dim < 2; ++dim) {
+    const int64_t kernel = kernel_shape[dim];
+    const int64_t stride = attrs.strides.empty() ? 1 : attrs.strides[dim];
+    const int64_t dilation = attrs.dilations.empty() ? 1 : attrs.dilations[dim];
+    const int64_t pad_head = attrs.pads.empty() ? 0 : attrs.pads[dim];
+    const int64_t pad_tail = attrs.pads.empty() ? 0 : attrs.pads[dim + 2];
+    const int64_t adj = attrs.output_padding.empty() ? 0 : attrs.output_padding[dim];
+
+    if (dilation != 1 || stride <= 0 || kernel <= 0 || pad_head < 0 || pad_tail < 0) {
+      return false;
+    }
+
+    // Every phase must map to a convolution with non-negative padding, whatever the input size.
+    for (int64_t r = 0; r < std::min(stride, kernel); ++r) {
+      const int64_t phase_kernel = (kernel - r + stride - 1) / stride;
+      const int64_t first_q = pad_head > r ? (pad_head - r + stride - 1) / stride : 0;
+      if (first_q > phase_kernel - 1 || kernel - 1 - pad_tail + adj - r < 0) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+template <>
+Status ConvTranspose<float>::DoConvTransposePhases(OpKernelContext* context,
+                                                   const ConvTransposeAttributes::Prepare& p) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const int64_t group = conv_transpose_attrs_.group;
+  const size_t input_channels = onnxruntime::narrow<size_t>(p.num_input_channels / group);
+  const size_t filter_count = onnxruntime::narrow<size_t>(p.num_output_channels / group);
+  const int64_t input_h = p.input_shape[0];
+  const int64_t input_w = p.input_shape[1];
+  const int64_t output_h = p.Y->Shape()[2];
+  const int64_t output_w = p.Y->Shape()[3];
+  const int64_t kernel_h = p.kernel_shape[0];
+  const int64_t kernel_w = p.kernel_shape[1];
+  const int64_t stride_h = p.strides[0];
+  const int64_t stride_w = p.strides[1];
+  const int64_t output_image_size = output_h * output_w;
+  const ptrdiff_t output_planes = onnxruntime::narrow<ptrdiff_t>(p.N * p.num_output_channels);
+
+  const float* Xdata = p.X->Data<float>();
+  const float* Bdata = p.B != nullptr ? p.B->Data<float>() : nullptr;
+  float* Ydata = p.Y->MutableData<float>();
+
+  // Phases without kernel taps only receive the bias.
+  if (stride_h > kernel_h || stride_w > kernel_w) {
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, output_planes, [&](ptrdiff_t plane) {
+      const float value = Bdata != nullptr ? Bdata[plane % p.num_output_channels] : 0.0f;
+      std::fill_n(Ydata + plane * output_image_size, output_image_size, value);
+    });
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // Each phase covers at most ceil(output / stride) positions in each dimension.
+  const int64_t max_phase_image_size = ((output_h + stride_h - 1) / stride_h) * ((output_w + stride_w - 1) / stride_w);
+  auto phase_output = IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(output_planes) * max_phase_image_size);
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+
+  const float* phase_filter = static_cast<const float*>(phase_filter_.get());
+
+  for (int64_t ry = 0; ry < std::min(stride_h, kernel_h); ++ry) {
+    const auto phase_y = ComputeConvTransposePhase(input_h, output_h, kernel_h, stride_h, p.pads[0], ry);
+
+    for (int64_t rx = 0; rx < std::min(stride_w, kernel_w); ++rx) {
+      const auto phase_x = ComputeConvTransposePhase(input_w, output_w, kernel_w, stride_w, p.pads[1], rx);
+
+      const float* filter = phase_filter;
+      phase_filter += SafeInt<size_t>(group) * filter_count * input_channels * phase_y.kernel * phase_x.kernel;
+
+      if (phase_y.output_count == 0 || phase_x.output_count == 0) {
+        continue;
+      }
+
+      ORT_RETURN_IF(phase_y.pad_head < 0 || phase_y.pad_tail < 0 || phase_x.pad_head < 0 || phase_x.pad_tail < 0,
+                    "ConvTranspose phase decomposition does not apply to the padding of this input.");
+
+      const int64_t phase_input_shape[] = {input_h, input_w};
+      const int64_t phase_kernel_shape[] = {phase_y.kernel, phase_x.kernel};
+      const int64_t phase_dilations[] = {1, 1};
+      const int64_t phase_pads[] = {phase_y.pad_head, phase_x.pad_head, phase_y.pad_tail, phase_x.pad_tail};
+      const int64_t phase_strides[] = {1, 1};
+      const int64_t phase_output_shape[] = {phase_y.output_count, phase_x.output_count};
+
+      MLAS_CONV_PARAMETERS Parameters;
+      size_t WorkingBufferSize;
+      MlasConvPrepare(&Parameters,
+                      2,
+                      onnxruntime::narrow<size_t>(p.N),
+                      onnxruntime::narrow<size_t>(group),
+                      input_channels,
+                      phase_input_shape,
+                      phase_kernel_shape,
+                      phase_dilations,
+                      phase_pads,
+                      phase_strides,
+                      phase_output_shape,
+                      filter_count,
+                      &activation,
+                      &WorkingBufferSize,
+                      0.0f,
+                      thread_pool);
+
+      auto working_buffer = IAllocator::MakeUniquePtr<float>(alloc, WorkingBufferSize);
+
+      MlasConv(&Parameters,
+               Xdata,
+               filter,
+               Bdata,
+               working_buffer.get(),
+               phase_output.get(),
+               thread_pool);
+
+      // Interleave the phase into the output, one output channel plane at a time.
+      const int64_t phase_image_size = phase_y.output_count * phase_x.output_count;
+      const float* phase_data = phase_output.get();
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, output_planes, [&](ptrdiff_t plane) {
+        const float* src = phase_data + plane * phase_image_size;
+        float* dst = Ydata + plane * output_image_size + phase_y.output_start * output_w + phase_x.output_start;
+        for (int64_t y = 0; y < phase_y.output_count; ++y) {
+          for (int64_t x = 0; x < phase_x.output_count; ++x) {
+            dst[x * stride_w] = *src++;
+          }
+          dst += stride_h * output_w;
+        }
+      });
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
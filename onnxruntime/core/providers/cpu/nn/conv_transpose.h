@@ -41,11 +41,19 @@ class ConvTranspose : public OpKernel {
   Status DoConvTranspose(OpKernelContext* context, bool dynamic_padding) const;
 
  private:
+  bool CanDecomposeIntoPhases(const TensorShape& filter_shape) const;
+  Status DoConvTransposePhases(OpKernelContext* context, const ConvTransposeAttributes::Prepare& p) const;
+
   ConvTransposeAttributes conv_transpose_attrs_;
 
   // for pre-packing usage
   TensorShape filter_shape_;
   BufferUniquePtr transposed_filter_;
+
+  // Filter split by output phase (the output position modulo the stride) into regular convolution filters.
+  // See DoConvTransposePhases.
+  BufferUniquePtr phase_filter_;
+  bool use_phase_filter_{false};
 };
 
 }  // namespace onnxruntime
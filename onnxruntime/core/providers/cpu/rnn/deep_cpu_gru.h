@@ -11,11 +11,12 @@
 
 namespace onnxruntime {
 
-/// The class represents GRU operator using DeepCPU implementation for
-/// fast inference computation on CPU machines.
-class DeepCpuGruOp final : public OpKernel {
- public:
-  DeepCpuGruOp(const OpKernelInfo& info) : OpKernel(info) {
+/// Shared attribute handling and compute driver for the GRU operator and its quantized variant.
+/// The weights are provided by the derived kernel as GemmWeights so that either float or
+/// 8-bit (prepacked or not) weights can be used for the input and recurrent GEMMs.
+class GRUBase {
+ protected:
+  GRUBase(const OpKernelInfo& info) {
     // required attributes
     std::string direction;
     ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
@@ -56,6 +57,40 @@ class DeepCpuGruOp final : public OpKernel {
                 "Batchwise recurrent operations (layout == 1) are not supported. If you need support create a github issue with justification.");
   }
 
+  ~GRUBase() = default;
+
+  // Validate the inputs. W_shape and R_shape are the original (unpacked) shapes of the weights.
+  // Must be called before the weights are split per direction.
+  Status ValidateInputs(OpKernelContext& context, const TensorShape& W_shape, const TensorShape& R_shape) const;
+
+  // The inputs must have been validated with ValidateInputs.
+  // The weights for the second direction are ignored unless direction_ is kBidirectional.
+  template <typename WeightT>
+  Status ComputeImpl(OpKernelContext& context,
+                     const rnn::detail::GemmWeights<WeightT>& W_1,
+                     const rnn::detail::GemmWeights<WeightT>& W_2,
+                     const rnn::detail::GemmWeights<WeightT>& R_ZR_1,
+                     const rnn::detail::GemmWeights<WeightT>& R_H_1,
+                     const rnn::detail::GemmWeights<WeightT>& R_ZR_2,
+                     const rnn::detail::GemmWeights<WeightT>& R_H_2) const;
+
+  rnn::detail::Direction direction_;
+  int num_directions_;
+
+  int hidden_size_{};
+  float clip_;
+  int linear_before_reset_{};
+  int64_t layout_;
+
+  rnn::detail::ActivationFuncs activation_funcs_;
+};
+
+/// The class represents GRU operator using DeepCPU implementation for
+/// fast inference computation on CPU machines.
+class DeepCpuGruOp final : public OpKernel, public GRUBase {
+ public:
+  DeepCpuGruOp(const OpKernelInfo& info) : OpKernel(info), GRUBase(info) {}
+
   Status Compute(OpKernelContext* context) const override;
 
   ~DeepCpuGruOp() override = default;
@@ -73,16 +108,6 @@ class DeepCpuGruOp final : public OpKernel {
 
   bool TryPackRecurrentWeights(const Tensor& weights, AllocatorPtr& alloc);
 
-  rnn::detail::Direction direction_;
-  int num_directions_;
-
-  int hidden_size_{};
-  float clip_;
-  int linear_before_reset_{};
-  int64_t layout_;
-
-  rnn::detail::ActivationFuncs activation_funcs_;
-
   // This kernel supports either forward or bidirectional
   // This is split in half for bidirectional, but we prepack it in the same buffer
   rnn::detail::PackedWeights pre_packed_input_weights_;
@@ -107,10 +132,11 @@ class UniDirectionalGru {
                     onnxruntime::concurrency::ThreadPool* ttp,
                     const bool training_mode = false);
 
+  template <typename WeightT>
   void Compute(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths, int num_directions,
-               const rnn::detail::GemmWeights<T>& input_weights,
-               const rnn::detail::GemmWeights<T>& recurrent_weights_ZR,
-               const rnn::detail::GemmWeights<T>& recurrent_weights_H,
+               const rnn::detail::GemmWeights<WeightT>& input_weights,
+               const rnn::detail::GemmWeights<WeightT>& recurrent_weights_ZR,
+               const rnn::detail::GemmWeights<WeightT>& recurrent_weights_H,
                gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
 
   // This function overloads the above one by adding two additional reference inputs that are computed in this kernel:
@@ -126,10 +152,11 @@ class UniDirectionalGru {
   ~UniDirectionalGru() = default;
 
  private:
+  template <typename WeightT>
   void ComputeImpl(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths, int num_directions,
-                   const rnn::detail::GemmWeights<T>& input_weights,
-                   const rnn::detail::GemmWeights<T>& recurrent_weights_ZR,
-                   const rnn::detail::GemmWeights<T>& recurrent_weights_H,
+                   const rnn::detail::GemmWeights<WeightT>& input_weights,
+                   const rnn::detail::GemmWeights<WeightT>& recurrent_weights_ZR,
+                   const rnn::detail::GemmWeights<WeightT>& recurrent_weights_H,
                    gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
                    gsl::span<T>& zrh);
 
@@ -191,6 +218,18 @@ class UniDirectionalGru {
 
   void AllocateBuffers();
 
+  // Quantized operation related allocation members
+  template <typename WeightT>
+  void AllocateQuantizeBuffers(int max_sequence_length);
+
+  // Buffer shared for the quantized inputs, and the quantized Ht-1 or rt (.) Ht-1 of each sequence step
+  IAllocatorUniquePtr<uint8_t> quantized_input_or_a_ptr_;
+  gsl::span<uint8_t> quantized_input_or_a_;
+
+  // int32 accumulation buffer used when a quantized GEMM adds to existing values in zrh
+  IAllocatorUniquePtr<int32_t> quantized_C_buffer_ptr_;
+  gsl::span<int32_t> quantized_C_buffer_;
+
   onnxruntime::concurrency::ThreadPool* ttp_;
 
   const bool training_mode_ = false;
@@ -302,7 +302,7 @@ void ComputeGemm(const int M,
   gemm_params.lda = static_cast<size_t>(K);
   gemm_params.ZeroPointA = a_zero_point;
   gemm_params.B = weights.buffer_;
-  gemm_params.ldb = static_cast<size_t>(N);
+  gemm_params.ldb = weights.ldb_ != 0 ? weights.ldb_ : static_cast<size_t>(N);
   gemm_params.ZeroPointB = &b_zero_point;
   gemm_params.BIsPacked = weights.is_prepacked_;
   gemm_params.C = C_buffer;
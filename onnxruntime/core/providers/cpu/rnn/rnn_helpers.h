@@ -225,6 +225,9 @@ struct GemmWeights {
   bool is_prepacked_{false};
   const void* buffer_{nullptr};
   size_t weights_size_{0};
+  // Leading dimension of unpacked quantized weights, which are laid out as [K, N].
+  // 0 means the weights are contiguous (ldb == N). Allows a column slice of a larger weight matrix to be used.
+  size_t ldb_{0};
   QuantizationParameter* quant_para_{nullptr};
 };
 
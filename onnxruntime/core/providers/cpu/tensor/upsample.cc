@@ -81,25 +81,26 @@ void UpsampleNearest2x(int64_t batch_size,
                        int64_t input_height,
                        int64_t input_width,
                        const T* input,
-                       T* output) {
+                       T* output,
+                       concurrency::ThreadPool* tp) {
   const int64_t output_height = input_height * 2;
   const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
-        for (int64_t x = 0; x < input_width; ++x) {
-          const T v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * num_channels * input_height),
+      static_cast<double>(output_width * 2),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          // Each input row produces two identical output rows.
+          const T* Xrow = input + i * input_width;
+          T* Yrow = output + i * 2 * output_width;
+          for (int64_t x = 0; x < input_width; ++x) {
+            const T v = Xrow[x];
+            Yrow[x * 2 + 0] = v;
+            Yrow[x * 2 + 1] = v;
+          }
+          std::copy_n(Yrow, output_width, Yrow + output_width);
         }
-      }
-
-      input += input_height * input_width;
-      output += output_height * output_width;
-    }
-  }
+      });
 }
 
 static std::vector<int64_t> UpsampleNearestSetupRank1InputMapping(
@@ -191,7 +192,8 @@ static Status UpsampleNearestImpl(const T* input,
                                   bool extrapolation_enabled,
                                   const T extrapolation_value,
                                   const GetOriginalCoordinateFunc& get_original_coordinate,
-                                  const GetNearestPixelFunc& get_nearest_pixel) {
+                                  const GetNearestPixelFunc& get_nearest_pixel,
+                                  concurrency::ThreadPool* tp) {
   int64_t n_dim = static_cast<int64_t>(input_shape.NumDimensions());
 
   std::vector<int64_t> input_dim_counters(narrow<size_t>(n_dim));
@@ -201,9 +203,6 @@ static Status UpsampleNearestImpl(const T* input,
     input_dim_factor[narrow<size_t>(dim_idx)] = input_dim_factor[SafeInt<size_t>(dim_idx) + 1] * input_shape[SafeInt<size_t>(dim_idx) + 1];
   }
 
-  int64_t output_idx = 0;
-  int64_t input_idx = 0;
-
   if (n_dim == 1) {
     std::vector<int64_t> input_mapping = UpsampleNearestSetupRank1InputMapping(input_shape[0],
                                                                                output_shape[0],
@@ -225,78 +224,43 @@ static Status UpsampleNearestImpl(const T* input,
       UpsampleNearestSetupInputMappings(n_dim, input_shape, output_shape, input_dim_factor, scales, roi,
                                         extrapolation_enabled, get_original_coordinate, get_nearest_pixel);
 
-  if (n_dim == 2) {
-    const std::vector<int64_t>& input_mapping_0 = input_mappings[0];
-    const std::vector<int64_t>& input_mapping_1 = input_mappings[1];
-
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      int64_t input_idx_0 = input_mapping_0[narrow<size_t>(output_dim0_inx)];
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        int64_t input_idx_1 = input_idx_0 + input_mapping_1[narrow<size_t>(output_dim1_inx)];
-        output[output_idx++] = (input_idx_1 < 0) ? extrapolation_value : input[input_idx_1];
-      }
-    }
-    return Status::OK();
-  }
-
-  if (n_dim == 3) {
-    const std::vector<int64_t>& input_mapping_0 = input_mappings[0];
-    const std::vector<int64_t>& input_mapping_1 = input_mappings[1];
-    const std::vector<int64_t>& input_mapping_2 = input_mappings[2];
-
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      int64_t input_idx_0 = input_mapping_0[narrow<size_t>(output_dim0_inx)];
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        int64_t input_idx_1 = input_idx_0 + input_mapping_1[narrow<size_t>(output_dim1_inx)];
-        for (int64_t output_dim2_inx = 0; output_dim2_inx < output_shape[2]; output_dim2_inx++) {
-          int64_t input_idx_2 = input_idx_1 + input_mapping_2[narrow<size_t>(output_dim2_inx)];
-          output[output_idx++] = (input_idx_2 < 0) ? extrapolation_value : input[input_idx_2];
+  // Every output row (innermost dimension) only depends on its own coordinates in the outer dimensions, so the
+  // rows are partitioned across the thread pool. A negative input index marks an extrapolated element.
+  const size_t inner_dim = narrow<size_t>(n_dim - 1);
+  const int64_t output_row_size = output_shape[inner_dim];
+  const std::vector<int64_t>& inner_mapping = input_mappings[inner_dim];
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(output_shape.SizeToDimension(inner_dim)),
+      static_cast<double>(output_row_size * 2),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        InlinedVector<int64_t> output_dim_counter(inner_dim);
+        for (int64_t dim_idx = static_cast<int64_t>(inner_dim) - 1, row = first; dim_idx >= 0; dim_idx--) {
+          output_dim_counter[narrow<size_t>(dim_idx)] = row % output_shape[narrow<size_t>(dim_idx)];
+          row /= output_shape[narrow<size_t>(dim_idx)];
         }
-      }
-    }
-    return Status::OK();
-  }
 
-  if (n_dim == 4) {
-    const std::vector<int64_t>& input_mapping_0 = input_mappings[0];
-    const std::vector<int64_t>& input_mapping_1 = input_mappings[1];
-    const std::vector<int64_t>& input_mapping_2 = input_mappings[2];
-    const std::vector<int64_t>& input_mapping_3 = input_mappings[3];
-
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      int64_t input_idx_0 = input_mapping_0[narrow<size_t>(output_dim0_inx)];
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        int64_t input_idx_1 = input_idx_0 + input_mapping_1[narrow<size_t>(output_dim1_inx)];
-        for (int64_t output_dim2_inx = 0; output_dim2_inx < output_shape[2]; output_dim2_inx++) {
-          int64_t input_idx_2 = input_idx_1 + input_mapping_2[narrow<size_t>(output_dim2_inx)];
-          for (int64_t output_dim3_inx = 0; output_dim3_inx < output_shape[3]; output_dim3_inx++) {
-            int64_t input_idx_3 = input_idx_2 + input_mapping_3[narrow<size_t>(output_dim3_inx)];
-            output[output_idx++] = (input_idx_3 < 0) ? static_cast<T>(extrapolation_value) : input[narrow<size_t>(input_idx_3)];
+        T* output_row = output + first * output_row_size;
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          int64_t input_row_idx = 0;
+          for (size_t dim_idx = 0; dim_idx < inner_dim; dim_idx++) {
+            input_row_idx += input_mappings[dim_idx][narrow<size_t>(output_dim_counter[dim_idx])];
           }
-        }
-      }
-    }
-    return Status::OK();
-  }
-
-  std::vector<int64_t> output_dim_counter(onnxruntime::narrow<size_t>(n_dim));
-  for (int64_t dim_idx = 0; dim_idx < n_dim; dim_idx++) {
-    input_idx += input_mappings[narrow<size_t>(dim_idx)][0 /* output_dim_counter[narrow<size_t>(dim_idx)] */];
-  }
 
-  for (int64_t output_size = output_shape.Size(); output_idx < output_size; output_idx++) {
-    output[narrow<size_t>(output_idx)] = (input_idx < 0) ? extrapolation_value : input[narrow<size_t>(input_idx)];
+          for (int64_t output_dim_inx = 0; output_dim_inx < output_row_size; output_dim_inx++) {
+            const int64_t input_idx = input_row_idx + inner_mapping[narrow<size_t>(output_dim_inx)];
+            output_row[output_dim_inx] = (input_idx < 0) ? extrapolation_value : input[input_idx];
+          }
+          output_row += output_row_size;
 
-    for (int64_t dim_idx = n_dim - 1; dim_idx >= 0; dim_idx--) {
-      input_idx -= input_mappings[narrow<size_t>(dim_idx)][narrow<size_t>(output_dim_counter[narrow<size_t>(dim_idx)])];
-      if (++output_dim_counter[narrow<size_t>(dim_idx)] < output_shape[narrow<size_t>(dim_idx)]) {
-        input_idx += input_mappings[narrow<size_t>(dim_idx)][narrow<size_t>(output_dim_counter[narrow<size_t>(dim_idx)])];
-        break;
-      }
-      output_dim_counter[narrow<size_t>(dim_idx)] = 0;
-      input_idx += input_mappings[narrow<size_t>(dim_idx)][0 /* output_dim_counter[narrow<size_t>(dim_idx)] */];
-    }
-  }
+          for (int64_t dim_idx = static_cast<int64_t>(inner_dim) - 1; dim_idx >= 0; dim_idx--) {
+            if (++output_dim_counter[narrow<size_t>(dim_idx)] < output_shape[narrow<size_t>(dim_idx)]) {
+              break;
+            }
+            output_dim_counter[narrow<size_t>(dim_idx)] = 0;
+          }
+        }
+      });
 
   return Status::OK();
 }
@@ -337,19 +301,20 @@ static Status UpsampleNearest(const T* input,
                               T extrapolation_value,
                               bool use_nearest2x_optimization,
                               const GetOriginalCoordinateFunc& get_original_coordinate,
-                              const GetNearestPixelFunc& get_nearest_pixel) {
+                              const GetNearestPixelFunc& get_nearest_pixel,
+                              concurrency::ThreadPool* tp) {
   ORT_RETURN_IF_ERROR(ValidateUpsampleInput(input, output, input_shape, output_shape, is_resize));
 
   // special case with fast path
   if (use_nearest2x_optimization && input_shape.NumDimensions() == 4 &&
       scales[0] == 1 && scales[1] == 1 && scales[2] == 2 && scales[3] == 2) {
-    UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output);
+    UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output, tp);
     return Status::OK();
   }
 
   return UpsampleNearestImpl(input, output, input_shape, output_shape, scales, roi,
                              extrapolation_enabled, extrapolation_value,
-                             get_original_coordinate, get_nearest_pixel);
+                             get_original_coordinate, get_nearest_pixel, tp);
 }
 
 /*
@@ -854,54 +819,50 @@ void UpsampleTrilinear(int64_t batch_size,
                                              depth_scale, height_scale, width_scale, roi,
                                              alloc, get_original_coordinate);
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, static_cast<std::ptrdiff_t>(num_channels),
-        [&](std::ptrdiff_t c) {
-          const T* Xdata = XdataBase + (n * num_channels + c) * (input_depth * input_height * input_width);
-          T* Ydata = YdataBase + (n * num_channels + c) * (output_depth * output_height * output_width);
-          for (int64_t z = 0; z < output_depth; ++z) {
-            for (int64_t y = 0; y < output_height; ++y) {
-              for (int64_t x = 0; x < output_width; ++x) {
-                // when use_extrapolation is set and original index of x or y is out of the dim range
-                // then use extrapolation_value as the output value.
-                if (use_extrapolation &&
-                    ((p.z_original[narrow<size_t>(z)] < 0 || p.z_original[narrow<size_t>(z)] > static_cast<float>(input_depth - 1)) ||
-                     (p.y_original[narrow<size_t>(y)] < 0 || p.y_original[narrow<size_t>(y)] > static_cast<float>(input_height - 1)) ||
-                     (p.x_original[narrow<size_t>(x)] < 0 || p.x_original[narrow<size_t>(x)] > static_cast<float>(input_width - 1)))) {
-                  Ydata[output_width * output_height * z + output_width * y + x] =
-                      static_cast<T>(extrapolation_value);
-                  continue;
-                }
-
-                // subscript ordering in the variable - (xyz)
-                T X111 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X211 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-                T X121 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X221 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-
-                T X112 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X212 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-                T X122 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X222 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * num_channels),
+      [&](std::ptrdiff_t nc) {
+        const T* Xdata = XdataBase + nc * (input_depth * input_height * input_width);
+        T* Ydata = YdataBase + nc * (output_depth * output_height * output_width);
+        for (int64_t z = 0; z < output_depth; ++z) {
+          for (int64_t y = 0; y < output_height; ++y) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              // when use_extrapolation is set and original index of x or y is out of the dim range
+              // then use extrapolation_value as the output value.
+              if (use_extrapolation &&
+                  ((p.z_original[narrow<size_t>(z)] < 0 || p.z_original[narrow<size_t>(z)] > static_cast<float>(input_depth - 1)) ||
+                   (p.y_original[narrow<size_t>(y)] < 0 || p.y_original[narrow<size_t>(y)] > static_cast<float>(input_height - 1)) ||
+                   (p.x_original[narrow<size_t>(x)] < 0 || p.x_original[narrow<size_t>(x)] > static_cast<float>(input_width - 1)))) {
                 Ydata[output_width * output_height * z + output_width * y + x] =
-                    static_cast<T>(p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X111 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X211 +
-                                   p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X121 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X221 +
-
-                                   p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X112 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X212 +
-                                   p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X122 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X222);
+                    static_cast<T>(extrapolation_value);
+                continue;
               }
+
+              // subscript ordering in the variable - (xyz)
+              T X111 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X211 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+              T X121 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X221 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+
+              T X112 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X212 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+              T X122 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X222 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+
+              Ydata[output_width * output_height * z + output_width * y + x] =
+                  static_cast<T>(p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X111 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X211 +
+                                 p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X121 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X221 +
+
+                                 p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X112 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X212 +
+                                 p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X122 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X222);
             }
           }
-          Xdata += input_depth * input_height * input_width;
-          Ydata += output_depth * output_width * output_height;
-        });
-  }
+        }
+      });
 }
 
 // Calculates cubic coeff based on Robert Keys approach
@@ -918,74 +879,29 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
-
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
-
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
-  }
-  cache[grid_start_pos] = result;
-
-  return result;
-}
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
-template <typename T>
-void ResizeBiCubic(int64_t batch_size,
-                   int64_t num_channels,
-                   int64_t input_height,
-                   int64_t input_width,
-                   int64_t output_height,
-                   int64_t output_width,
-                   float height_scale,
-                   float width_scale,
-                   float cubic_coeff_a,
-                   bool use_extrapolation,
-                   float extrapolation_value,
-                   bool exclude_outside,
-                   gsl::span<const float> roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
+// Computes the bicubic interpolation tables for an [H, W] image. For each output row and column, the 4 input
+// positions of the grid are clamped to the input (the edge values are replicated) and their weights are
+// renormalized when exclude_outside is set.
+static BicubicParams SetupUpsampleBiCubic(int64_t input_height,
+                                          int64_t input_width,
+                                          int64_t output_height,
+                                          int64_t output_width,
+                                          float height_scale,
+                                          float width_scale,
+                                          float cubic_coeff_a,
+                                          bool exclude_outside,
+                                          gsl::span<const float> roi,
+                                          const GetOriginalCoordinateFunc& get_original_coordinate) {
+  BicubicParams p;
 
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
+  p.y_original.reserve(narrow<size_t>(output_height));
+  p.x_original.reserve(narrow<size_t>(output_width));
+  p.input_width_mul_y.resize(CubicModeGridLength * narrow<size_t>(output_height));
+  p.coeff_y.resize(CubicModeGridLength * narrow<size_t>(output_height));
+  p.coeff_y_sum.resize(narrow<size_t>(output_height));
+  p.in_x.resize(CubicModeGridLength * narrow<size_t>(output_width));
+  p.coeff_x.resize(CubicModeGridLength * narrow<size_t>(output_width));
 
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
   auto roi_y_start = roi.size() / 2 - 2;
   auto roi_y_end = roi.size() - 2;
   auto roi_x_start = roi.size() / 2 - 1;
@@ -998,12 +914,25 @@ void ResizeBiCubic(int64_t batch_size,
                                                              static_cast<float>(output_height),
                                                              static_cast<float>(input_height),
                                                              roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+    p.y_original.emplace_back(in_y);
+
+    auto y_int = static_cast<int64_t>(std::floor(in_y));
+    const auto coeffs = GetCubicCoeffs(in_y - y_int, cubic_coeff_a);
+    float coeff_sum = exclude_outside ? 0.0f : 1.0f;
+
+    for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
+      const size_t idx = narrow<size_t>(i * output_height + y);
+      float coeff = coeffs[narrow<size_t>(i)];
+      if (exclude_outside) {
+        // When true, the weight of sampling locations outside the grid will be set to 0
+        // and the weight will be renormalized so that their sum is 1.0
+        coeff = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : coeff;
+        coeff_sum += coeff;
+      }
+      p.coeff_y[idx] = coeff;
+      p.input_width_mul_y[idx] = std::max(static_cast<int64_t>(0), std::min(y_val, input_height - 1)) * input_width;
     }
+    p.coeff_y_sum[narrow<size_t>(y)] = coeff_sum;
   }
 
   // generate coefficients in x direction
@@ -1014,101 +943,106 @@ void ResizeBiCubic(int64_t batch_size,
                                                             static_cast<float>(output_width),
                                                             static_cast<float>(input_width),
                                                             roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+    p.x_original.emplace_back(in_x);
+
+    auto x_int = static_cast<int64_t>(std::floor(in_x));
+    const auto coeffs = GetCubicCoeffs(in_x - x_int, cubic_coeff_a);
+    std::array<float, CubicModeGridLength> coeff_holder;
+    float coeff_sum = exclude_outside ? 0.0f : 1.0f;
+
+    for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
+      float coeff = coeffs[narrow<size_t>(i)];
+      if (exclude_outside) {
+        coeff = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : coeff;
+        coeff_sum += coeff;
+      }
+      coeff_holder[narrow<size_t>(i)] = coeff;
+      p.in_x[narrow<size_t>(i * output_width + x)] = std::max(static_cast<int64_t>(0), std::min(x_val, input_width - 1));
     }
-  }
 
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
+    for (size_t i = 0; i < CubicModeGridLength; i++) {
+      p.coeff_x[i * narrow<size_t>(output_width) + narrow<size_t>(x)] = coeff_holder[i] / coeff_sum;
+    }
+  }
 
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
+  return p;
+}
 
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
+template <typename T>
+void ResizeBiCubic(int64_t batch_size,
+                   int64_t num_channels,
+                   int64_t input_height,
+                   int64_t input_width,
+                   int64_t output_height,
+                   int64_t output_width,
+                   const BicubicParams& p,
+                   bool use_extrapolation,
+                   float extrapolation_value,
+                   const T* XdataBase,
+                   T* YdataBase,
+                   concurrency::ThreadPool* tp) {
+  const float* coeff_x[CubicModeGridLength];
+  const int64_t* in_x[CubicModeGridLength];
+  for (size_t i = 0; i < CubicModeGridLength; i++) {
+    coeff_x[i] = p.coeff_x.data() + i * narrow<size_t>(output_width);
+    in_x[i] = p.in_x.data() + i * narrow<size_t>(output_width);
+  }
 
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
-          }
-        }
+  // Each output row is computed as the weighted sum of the cubic interpolations in the x dimension of its
+  // 4 input rows. The loops over the output row only index the contiguous tables.
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * num_channels * output_height),
+      static_cast<double>(output_width * CubicModeGridLength * CubicModeGridLength * 2),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> row_result(narrow<size_t>(output_width));
 
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t y = row % output_height;
+          const int64_t image = row / output_height;
+          const T* Xdata = XdataBase + image * input_height * input_width;
+          T* Ydata = YdataBase + image * output_height * output_width + y * output_width;
 
           // when use_extrapolation is set and original index is out of the dim range
           // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
+          const float in_y = p.y_original[narrow<size_t>(y)];
+          if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
+            std::fill_n(Ydata, output_width, static_cast<T>(extrapolation_value));
             continue;
           }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
+          std::fill(row_result.begin(), row_result.end(), 0.0f);
+          const float coeff_y_sum = p.coeff_y_sum[narrow<size_t>(y)];
+
+          for (size_t i = 0; i < CubicModeGridLength; i++) {
+            const size_t y_idx = i * narrow<size_t>(output_height) + narrow<size_t>(y);
+            const T* Xrow = Xdata + p.input_width_mul_y[y_idx];
+            const float coeff_y = p.coeff_y[y_idx];
+
+            for (int64_t x = 0; x < output_width; ++x) {
+              float x_interpolation_result = 0;
+              x_interpolation_result += coeff_x[0][x] * Xrow[in_x[0][x]];
+              x_interpolation_result += coeff_x[1][x] * Xrow[in_x[1][x]];
+              x_interpolation_result += coeff_x[2][x] * Xrow[in_x[2][x]];
+              x_interpolation_result += coeff_x[3][x] * Xrow[in_x[3][x]];
+              row_result[narrow<size_t>(x)] += x_interpolation_result * coeff_y / coeff_y_sum;
             }
           }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
+          for (int64_t x = 0; x < output_width; ++x) {
+            Ydata[x] = static_cast<T>(row_result[narrow<size_t>(x)]);
           }
 
-          Ydata[y * output_width + x] = static_cast<T>(result);
+          if (use_extrapolation) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              const float in_x_original = p.x_original[narrow<size_t>(x)];
+              if (in_x_original < 0 || in_x_original > static_cast<float>(input_width - 1)) {
+                Ydata[x] = static_cast<T>(extrapolation_value);
+              }
+            }
+          }
         }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+      });
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1150,7 +1084,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
     case UpsampleMode::NN:
       return UpsampleNearest<T>(X->Data<T>(), Y->MutableData<T>(), X->Shape(), Y->Shape(),
                                 scales, roi, is_resize_, use_extrapolation_, static_cast<T>(extrapolation_value_),
-                                use_nearest2x_optimization_, get_original_coordinate_, get_nearest_pixel_);
+                                use_nearest2x_optimization_, get_original_coordinate_, get_nearest_pixel_,
+                                context->GetOperatorThreadPool());
     case UpsampleMode::LINEAR: {
       // Supports 'bilinear' and 'trilinear' sampling only
 
@@ -1218,11 +1153,13 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                       X, Y->MutableData<T>(), alloc, get_original_coordinate_,
                                       output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
           } else {
+            auto p = bilinear_tables_.Get(dims, output_dims, scales, roi, [&]() {
+              return SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                           height_scale, width_scale, roi, alloc, get_original_coordinate_, true);
+            });
             UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                             height_scale, width_scale, roi,
-                             use_extrapolation_, extrapolation_value_, X->Data<T>(),
-                             Y->MutableData<T>(), alloc, get_original_coordinate_,
-                             output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                             *p, use_extrapolation_, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
+                             context->GetOperatorThreadPool());
           }
         } else {
           if (use_extrapolation_) {
@@ -1235,16 +1172,23 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
               if (!is_2D &&
                   (Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_UINT8 ||
                    Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_INT8)) {
+                auto p = bilinear_integer_tables_.Get(dims, output_dims, scales, roi, [&]() {
+                  return SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
+                                                      height_scale, width_scale, roi, alloc,
+                                                      get_original_coordinate_, false);
+                });
                 NhwcUpsampleBilinearInteger<T, true>(
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
+                    *p, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
               } else {
+                auto p = bilinear_tables_.Get(dims, output_dims, scales, roi, [&]() {
+                  return SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                               height_scale, width_scale, roi, alloc, get_original_coordinate_, false);
+                });
                 NhwcUpsampleBilinear<T, true>(
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
+                    *p, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
               }
             }
@@ -1258,16 +1202,23 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
               if (!is_2D &&
                   (Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_UINT8 ||
                    Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_INT8)) {
+                auto p = bilinear_integer_tables_.Get(dims, output_dims, scales, roi, [&]() {
+                  return SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
+                                                      height_scale, width_scale, roi, alloc,
+                                                      get_original_coordinate_, false);
+                });
                 NhwcUpsampleBilinearInteger<T, false>(
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
+                    *p, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
               } else {
+                auto p = bilinear_tables_.Get(dims, output_dims, scales, roi, [&]() {
+                  return SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                               height_scale, width_scale, roi, alloc, get_original_coordinate_, false);
+                });
                 NhwcUpsampleBilinear<T, false>(
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
+                    *p, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
               }
             }
@@ -1301,7 +1252,7 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                             is_3D ? scales[0] : scales[2], is_3D ? scales[1] : scales[3],
                             is_3D ? scales[2] : scales[4], roi, use_extrapolation_, extrapolation_value_,
                             X->Data<T>(), Y->MutableData<T>(), alloc, get_original_coordinate_,
-                            output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                            output_depth * output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
         }
         return Status::OK();
       } else {
@@ -1349,10 +1300,14 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                  output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
         }
       } else {
+        auto p = bicubic_tables_.Get(dims, output_dims, scales, roi, [&]() {
+          return SetupUpsampleBiCubic(input_height, input_width, output_height, output_width,
+                                      height_scale, width_scale, cubic_coeff_a_, exclude_outside_, roi,
+                                      get_original_coordinate_);
+        });
         ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                      height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
-                      extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+                      *p, use_extrapolation_, extrapolation_value_, X->Data<float>(), Y->MutableData<float>(),
+                      context->GetOperatorThreadPool());
       }
       return Status::OK();
     }
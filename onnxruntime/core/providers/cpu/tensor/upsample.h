@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <vector>
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
@@ -58,6 +60,56 @@ struct BilinearParamsInteger {
   int32_t* dy2_scale_10{nullptr};
 };
 
+// Per output row and column, the 4 input positions of the bicubic grid (clamped to the input) and their weights.
+// The tables are laid out tap major ([4][output_size]) so that the inner loops over the output are contiguous.
+struct BicubicParams {
+  std::vector<float> x_original;
+  std::vector<float> y_original;
+
+  // input_width * clamped input row of each tap
+  std::vector<int64_t> input_width_mul_y;
+  // clamped input column of each tap
+  std::vector<int64_t> in_x;
+
+  std::vector<float> coeff_y;
+  std::vector<float> coeff_y_sum;
+  // already divided by the sum of the weights of the column
+  std::vector<float> coeff_x;
+};
+
+// Interpolation tables of the most recent call. They only depend on the input and output shapes, the scales and
+// the roi, which usually don't change from one run to the next, so they are reused while those match.
+template <typename Params>
+class InterpolationTableCache {
+ public:
+  template <typename SetupFn>
+  std::shared_ptr<const Params> Get(gsl::span<const int64_t> input_dims, gsl::span<const int64_t> output_dims,
+                                    gsl::span<const float> scales, gsl::span<const float> roi,
+                                    const SetupFn& setup) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (params_ == nullptr ||
+        !std::equal(input_dims.begin(), input_dims.end(), input_dims_.begin(), input_dims_.end()) ||
+        !std::equal(output_dims.begin(), output_dims.end(), output_dims_.begin(), output_dims_.end()) ||
+        !std::equal(scales.begin(), scales.end(), scales_.begin(), scales_.end()) ||
+        !std::equal(roi.begin(), roi.end(), roi_.begin(), roi_.end())) {
+      params_ = std::make_shared<const Params>(setup());
+      input_dims_.assign(input_dims.begin(), input_dims.end());
+      output_dims_.assign(output_dims.begin(), output_dims.end());
+      scales_.assign(scales.begin(), scales.end());
+      roi_.assign(roi.begin(), roi.end());
+    }
+    return params_;
+  }
+
+ private:
+  std::mutex mutex_;
+  TensorShapeVector input_dims_;
+  TensorShapeVector output_dims_;
+  InlinedVector<float> scales_;
+  InlinedVector<float> roi_;
+  std::shared_ptr<const Params> params_;
+};
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
@@ -68,6 +120,11 @@ class Upsample : public UpsampleBase, public OpKernel {
 
   Status BaseCompute(OpKernelContext* context, gsl::span<const float> roi, gsl::span<const float> scales,
                      gsl::span<const int64_t> output_dims) const;
+
+ private:
+  mutable InterpolationTableCache<BilinearParams> bilinear_tables_;
+  mutable InterpolationTableCache<BilinearParamsInteger> bilinear_integer_tables_;
+  mutable InterpolationTableCache<BicubicParams> bicubic_tables_;
 };
 
 BilinearParams SetupUpsampleBilinear(const int32_t input_height,
@@ -81,6 +138,67 @@ BilinearParams SetupUpsampleBilinear(const int32_t input_height,
                                      const GetOriginalCoordinateFunc& get_original_coordinate,
                                      const bool is_nchw);
 
+template <typename T>
+void UpsampleBilinear(const int32_t batch_size,
+                      const int32_t num_channels,
+                      const int32_t input_height,
+                      const int32_t input_width,
+                      const int32_t output_height,
+                      const int32_t output_width,
+                      const BilinearParams& p,
+                      const bool use_extrapolation,
+                      const float extrapolation_value,
+                      const T* const XdataBase,
+                      T* const YdataBase,
+                      concurrency::ThreadPool* tp) {
+  // Partition over the output rows of all the images so that there is enough parallelism for small batches
+  // with few channels.
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size) * num_channels * output_height,
+      static_cast<double>(output_width * 8),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int32_t y = static_cast<int32_t>(i % output_height);
+          const std::ptrdiff_t image = i / output_height;
+          const T* const Xdata = XdataBase + image * (input_height * input_width);
+          T* const Ydata = YdataBase + image * (output_height * output_width) + y * output_width;
+
+          // when use_extrapolation is set and original index of x or y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation &&
+              (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1))) {
+            std::fill_n(Ydata, output_width, static_cast<T>(extrapolation_value));
+            continue;
+          }
+
+          const T* const Xrow1 = Xdata + p.input_width_mul_y1[y];
+          const T* const Xrow2 = Xdata + p.input_width_mul_y2[y];
+          const float dy1 = p.dy1[y];
+          const float dy2 = p.dy2[y];
+
+          for (int32_t x = 0; x < output_width; ++x) {
+            T X11 = Xrow1[p.in_x1[x]];
+            T X21 = Xrow1[p.in_x2[x]];
+            T X12 = Xrow2[p.in_x1[x]];
+            T X22 = Xrow2[p.in_x2[x]];
+
+            Ydata[x] = static_cast<T>(p.dx2[x] * dy2 * X11 +
+                                      p.dx1[x] * dy2 * X21 +
+                                      p.dx2[x] * dy1 * X12 +
+                                      p.dx1[x] * dy1 * X22);
+          }
+
+          if (use_extrapolation) {
+            for (int32_t x = 0; x < output_width; ++x) {
+              if (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)) {
+                Ydata[x] = static_cast<T>(extrapolation_value);
+              }
+            }
+          }
+        }
+      });
+}
+
 template <typename T>
 void UpsampleBilinear(const int32_t batch_size,
                       const int32_t num_channels,
@@ -101,38 +219,8 @@ void UpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
-  for (int32_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, num_channels,
-        [&](std::ptrdiff_t c) {
-          const T* const Xdata =
-              XdataBase + (n * num_channels + static_cast<int32_t>(c)) * (input_height * input_width);
-          T* const Ydata = YdataBase + (n * num_channels + static_cast<int32_t>(c)) * (output_height * output_width);
-          for (int32_t y = 0; y < output_height; ++y) {
-            for (int32_t x = 0; x < output_width; ++x) {
-              const int32_t output_offset = output_width * y + x;
-              // when use_extrapolation is set and original index of x or y is out of the dim range
-              // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                   (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[output_offset] = static_cast<T>(extrapolation_value);
-                continue;
-              }
-
-              T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
-              T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
-              T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
-              T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
-
-              Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                    p.dx1[x] * p.dy2[y] * X21 +
-                                                    p.dx2[x] * p.dy1[y] * X12 +
-                                                    p.dx1[x] * p.dy1[y] * X22);
-            }
-          }
-        });
-  }
+  UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width, p,
+                   use_extrapolation, extrapolation_value, XdataBase, YdataBase, tp);
 }
 
 template <typename T, bool UseExtrapolation>
@@ -142,18 +230,11 @@ void NhwcUpsampleBilinear(const int32_t batch_size,
                           const int32_t input_width,
                           const int32_t output_height,
                           const int32_t output_width,
-                          const float height_scale,
-                          const float width_scale,
-                          gsl::span<const float> roi,
+                          const BilinearParams& p,
                           const float extrapolation_value,
                           const T* const XdataBase,
                           T* const YdataBase,
-                          AllocatorPtr& alloc,
-                          const GetOriginalCoordinateFunc& get_original_coordinate,
                           concurrency::ThreadPool* tp) {
-  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
-                                           height_scale, width_scale, roi,
-                                           alloc, get_original_coordinate, false);
   for (int32_t n = 0; n < batch_size; ++n) {
     const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
     T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
@@ -221,6 +302,30 @@ void NhwcUpsampleBilinear(const int32_t batch_size,
   }
 }
 
+template <typename T, bool UseExtrapolation>
+void NhwcUpsampleBilinear(const int32_t batch_size,
+                          const int32_t num_channels,
+                          const int32_t input_height,
+                          const int32_t input_width,
+                          const int32_t output_height,
+                          const int32_t output_width,
+                          const float height_scale,
+                          const float width_scale,
+                          gsl::span<const float> roi,
+                          const float extrapolation_value,
+                          const T* const XdataBase,
+                          T* const YdataBase,
+                          AllocatorPtr& alloc,
+                          const GetOriginalCoordinateFunc& get_original_coordinate,
+                          concurrency::ThreadPool* tp) {
+  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                           height_scale, width_scale, roi,
+                                           alloc, get_original_coordinate, false);
+  NhwcUpsampleBilinear<T, UseExtrapolation>(batch_size, num_channels, input_height, input_width,
+                                            output_height, output_width, p, extrapolation_value,
+                                            XdataBase, YdataBase, tp);
+}
+
 BilinearParamsInteger SetupUpsampleBilinearInteger(const int32_t input_height,
                                                    const int32_t input_width,
                                                    const int32_t output_height,
@@ -239,18 +344,11 @@ void NhwcUpsampleBilinearInteger(const int32_t batch_size,
                                  const int32_t input_width,
                                  const int32_t output_height,
                                  const int32_t output_width,
-                                 const float height_scale,
-                                 const float width_scale,
-                                 gsl::span<const float> roi,
+                                 const BilinearParamsInteger& p,
                                  const float extrapolation_value,
                                  const T* const XdataBase,
                                  T* const YdataBase,
-                                 AllocatorPtr& alloc,
-                                 const GetOriginalCoordinateFunc& get_original_coordinate,
                                  concurrency::ThreadPool* tp) {
-  BilinearParamsInteger p = SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
-                                                         height_scale, width_scale, roi,
-                                                         alloc, get_original_coordinate, false);
   for (int32_t n = 0; n < batch_size; ++n) {
     const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
     T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
@@ -320,6 +418,30 @@ void NhwcUpsampleBilinearInteger(const int32_t batch_size,
   }
 }
 
+template <typename T, bool UseExtrapolation>
+void NhwcUpsampleBilinearInteger(const int32_t batch_size,
+                                 const int32_t num_channels,
+                                 const int32_t input_height,
+                                 const int32_t input_width,
+                                 const int32_t output_height,
+                                 const int32_t output_width,
+                                 const float height_scale,
+                                 const float width_scale,
+                                 gsl::span<const float> roi,
+                                 const float extrapolation_value,
+                                 const T* const XdataBase,
+                                 T* const YdataBase,
+                                 AllocatorPtr& alloc,
+                                 const GetOriginalCoordinateFunc& get_original_coordinate,
+                                 concurrency::ThreadPool* tp) {
+  BilinearParamsInteger p = SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
+                                                         height_scale, width_scale, roi,
+                                                         alloc, get_original_coordinate, false);
+  NhwcUpsampleBilinearInteger<T, UseExtrapolation>(batch_size, num_channels, input_height, input_width,
+                                                   output_height, output_width, p, extrapolation_value,
+                                                   XdataBase, YdataBase, tp);
+}
+
 }  // namespace onnxruntime
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
@@ -4,6 +4,7 @@
 #include "core/session/environment.h"
 #include "core/session/allocator_adapters.h"
 #include "core/framework/allocator_utils.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/graph/constants.h"
 #include "core/graph/op.h"
 
@@ -186,6 +187,10 @@ Status Environment::UnregisterAllocator(const OrtMemoryInfo& mem_info) {
   return Status::OK();
 }
 
+Environment::Environment() : shared_initializer_store_(std::make_unique<SharedInitializerStore>()) {}
+
+Environment::~Environment() = default;
+
 Status Environment::Initialize(std::unique_ptr<logging::LoggingManager> logging_manager,
                                const OrtThreadingOptions* tp_options,
                                bool create_global_thread_pools) {
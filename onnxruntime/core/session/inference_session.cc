@@ -4,7 +4,12 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <list>
 #include <string>
@@ -29,6 +34,7 @@
 #include "core/framework/kernel_type_str_resolver.h"
 #include "core/framework/kernel_type_str_resolver_utils.h"
 #include "core/framework/mldata_type_utils.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_type_and_shape.h"
@@ -129,6 +135,33 @@ inline std::basic_string<T> GetCurrentTimeString() {
   return std::basic_string<T>(time_str);
 }
 
+// Reads the run sampling rate and the flush interval of the session profiler from the session config.
+// The outputs are only set if both values are valid.
+Status GetProfilerOptions(const ConfigOptions& config_options, size_t& sampling_rate, int64_t& flush_interval_ms) {
+  const std::string sampling_rate_str =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingSamplingRate, "1");
+  size_t parsed_sampling_rate = 0;
+  if (!TryParseStringWithClassicLocale(sampling_rate_str, parsed_sampling_rate) || parsed_sampling_rate == 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                           kOrtSessionOptionsConfigProfilingSamplingRate, ": '", sampling_rate_str,
+                           "'. It must be a positive integer.");
+  }
+
+  const std::string flush_interval_ms_str =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingFlushIntervalMs, "0");
+  int64_t parsed_flush_interval_ms = 0;
+  if (!TryParseStringWithClassicLocale(flush_interval_ms_str, parsed_flush_interval_ms) ||
+      parsed_flush_interval_ms < 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                           kOrtSessionOptionsConfigProfilingFlushIntervalMs, ": '", flush_interval_ms_str,
+                           "'. It must be a non-negative integer.");
+  }
+
+  sampling_rate = parsed_sampling_rate;
+  flush_interval_ms = parsed_flush_interval_ms;
+  return Status::OK();
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 
 static bool HasControlflowNodes(const Graph& graph) {
@@ -497,6 +530,17 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   }
 
   session_profiler_.Initialize(session_logger_);
+  // invalid profiler options are ignored here and reported by Initialize()
+  size_t profiling_sampling_rate = 1;
+  int64_t profiling_flush_interval_ms = 0;
+  if (GetProfilerOptions(session_options_.config_options, profiling_sampling_rate, profiling_flush_interval_ms)
+          .IsOK()) {
+    session_profiler_.SetSamplingRate(profiling_sampling_rate);
+    if (profiling_flush_interval_ms > 0) {
+      session_profiler_.SetStreaming(std::chrono::milliseconds(profiling_flush_interval_ms));
+    }
+  }
+
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
@@ -899,7 +943,9 @@ common::Status InferenceSession::RegisterGraphTransformer(
                           "Graph transformers must be registered before the session is initialized.");
   }
 
-  return graph_transformer_mgr_.Register(std::move(p_graph_transformer), level);
+  ORT_RETURN_IF_ERROR(graph_transformer_mgr_.Register(std::move(p_graph_transformer), level));
+  has_registered_graph_transformers_ = true;
+  return Status::OK();
 }
 
 common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& filepath) const {
@@ -946,6 +992,152 @@ common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& fi
   return Status::OK();
 }
 
+common::Status InferenceSession::LoadOptimizedModelFromCache() {
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigOptimizedModelCacheDir, "");
+  if (cache_dir.empty()) {
+    return Status::OK();
+  }
+
+  const bool only_cpu_ep = execution_providers_.NumProviders() == 1 &&
+                           execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
+  const auto& initializers = model_->MainGraph().GetAllInitializedTensors();
+  bool has_external_data = std::any_of(initializers.cbegin(), initializers.cend(),
+                                       [](const auto& entry) { return utils::HasExternalData(*entry.second); });
+#if !defined(DISABLE_EXTERNAL_INITIALIZERS)
+  has_external_data = has_external_data || !session_options_.external_initializers.empty() ||
+                      !session_options_.external_initializer_files_mmap.empty();
+#endif
+
+  // registered transformers and custom ops can change the optimized graph in ways the fingerprint can't capture
+  const bool has_custom_optimizations = has_registered_graph_transformers_ || !custom_registries_.empty();
+
+  if (!ort_format_model_bytes_.empty() || model_location_.empty() || !only_cpu_ep || has_external_data ||
+      !session_options_.optimized_model_filepath.empty() || has_custom_optimizations) {
+    LOGS(*session_logger_, INFO) << "The optimized model cache is not used for this session. It requires an ONNX "
+                                    "model without external data loaded from a file, only the CPU execution provider, "
+                                    "no optimized_model_filepath, and no registered graph transformers or custom ops.";
+    return Status::OK();
+  }
+
+  // the fingerprint covers the model file and everything that affects the optimized graph
+  std::string fingerprint_data;
+  {
+    std::ifstream model_file(std::filesystem::path(model_location_), std::ios::binary);
+    ORT_RETURN_IF_NOT(model_file, "Failed to open model file for the optimized model cache: ",
+                      ToUTF8String(model_location_));
+
+    constexpr size_t kChunkSize = 16 * 1024 * 1024;
+    std::vector<char> chunk(kChunkSize);
+    while (model_file) {
+      model_file.read(chunk.data(), kChunkSize);
+      const auto num_read = static_cast<int>(model_file.gcount());
+      if (num_read > 0) {
+        uint32_t chunk_hash[4];
+        MurmurHash3::x86_128(chunk.data(), num_read, 0, chunk_hash);
+        fingerprint_data.append(reinterpret_cast<const char*>(chunk_hash), sizeof(chunk_hash));
+      }
+    }
+    ORT_RETURN_IF_NOT(model_file.eof(), "Failed to read model file for the optimized model cache: ",
+                      ToUTF8String(model_location_));
+  }
+
+  std::ostringstream settings;
+  settings << ORT_VERSION << ';' << kOrtModelVersion << ';' << static_cast<int>(session_options_.graph_optimization_level);
+
+  std::map<std::string, std::string> config_entries(session_options_.config_options.configurations.cbegin(),
+                                                    session_options_.config_options.configurations.cend());
+  config_entries.erase(kOrtSessionOptionsConfigOptimizedModelCacheDir);
+  for (const auto& [key, value] : config_entries) {
+    settings << ';' << key << '=' << value;
+  }
+
+  for (const auto& dim_override : session_options_.free_dimension_overrides) {
+    settings << ";dim:" << dim_override.dim_identifier << ':' << static_cast<int>(dim_override.dim_identifier_type)
+             << '=' << dim_override.dim_value;
+  }
+
+  std::set<std::string> disabled_optimizers(optimizers_to_disable_.cbegin(), optimizers_to_disable_.cend());
+  for (const auto& optimizer : disabled_optimizers) {
+    settings << ";disable:" << optimizer;
+  }
+
+  for (const auto& ep_type : execution_providers_.GetIds()) {
+    settings << ";ep:" << ep_type;
+  }
+
+  fingerprint_data += settings.str();
+
+  uint32_t fingerprint[4];
+  MurmurHash3::x86_128(fingerprint_data.data(), static_cast<int>(fingerprint_data.size()), 0, fingerprint);
+
+  std::ostringstream cache_file_name;
+  cache_file_name << std::hex << std::setfill('0');
+  for (auto word : fingerprint) {
+    cache_file_name << std::setw(8) << word;
+  }
+  cache_file_name << ".ort";
+
+  const std::filesystem::path cache_path = std::filesystem::path(ToPathString(cache_dir)) / cache_file_name.str();
+
+  std::error_code ec;
+  if (!std::filesystem::exists(cache_path, ec)) {
+    LOGS(*session_logger_, INFO) << "Optimized model cache miss. The optimized model will be saved to "
+                                 << ToUTF8String(cache_path.native());
+    optimized_model_cache_path_ = cache_path;
+    return Status::OK();
+  }
+
+  LOGS(*session_logger_, INFO) << "Optimized model cache hit. Loading the optimized model from "
+                               << ToUTF8String(cache_path.native());
+
+  const PathString onnx_model_location = model_location_;
+  const auto reset_model = [this]() {
+    model_.reset();
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    ort_format_model_mapped_bytes_.reset();
+    is_model_loaded_ = false;
+  };
+
+  reset_model();
+  auto status = LoadOrtModel(cache_path.native());
+  if (!status.IsOK()) {
+    // fall back to the ONNX model if the cache entry can't be used, e.g. it was written by a different release
+    LOGS(*session_logger_, WARNING) << "Failed to load the optimized model from " << ToUTF8String(cache_path.native()) << ": "
+                                    << status.ErrorMessage() << ". Loading the ONNX model instead.";
+    reset_model();
+    ORT_RETURN_IF_ERROR(LoadOnnxModel(onnx_model_location));
+    optimized_model_cache_path_ = cache_path;
+  }
+
+  return Status::OK();
+}
+
+void InferenceSession::SaveOptimizedModelToCache() const {
+  std::error_code ec;
+  std::filesystem::create_directories(optimized_model_cache_path_.parent_path(), ec);
+
+  // write to a temporary file first so that concurrent sessions never load a partially written cache entry
+  auto temp_path = optimized_model_cache_path_;
+  temp_path += ORT_TSTR(".") + ToPathString(std::to_string(Env::Default().GetSelfPid())) + ORT_TSTR(".") +
+               ToPathString(std::to_string(session_id_)) + ORT_TSTR(".tmp");
+
+  auto status = SaveToOrtFormat(temp_path);
+  if (status.IsOK()) {
+    std::filesystem::rename(temp_path, optimized_model_cache_path_, ec);
+    if (ec) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ec.message());
+    }
+  }
+
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to add the optimized model to the cache at "
+                                    << ToUTF8String(optimized_model_cache_path_.native()) << ": " << status.ErrorMessage();
+    std::filesystem::remove(temp_path, ec);
+  }
+}
+
 common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std::shared_ptr<Model>&)> loader,
                                                 const std::string& event_name) {
   Status status = Status::OK();
@@ -1378,10 +1570,41 @@ static Status LoadOrtModelBytes(const PathString& model_uri,
   return Status::OK();
 }
 
+// Memory map the model file so the initializers can use the bytes in place. The mapping is copy-on-write, so the
+// pages of the file are shared with other processes that map or read the same file until they are written to.
+static Status MapOrtModelBytes(const PathString& model_uri,
+                               gsl::span<const uint8_t>& bytes,
+                               Env::MappedMemoryPtr& mapped_bytes) {
+  size_t num_bytes = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_uri.c_str(), num_bytes));
+  ORT_RETURN_IF(num_bytes == 0, "Load model from ", ToUTF8String(model_uri), " failed. The file is empty.");
+
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(model_uri.c_str(), 0, num_bytes, mapped_bytes));
+
+  bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_bytes.get()), num_bytes);
+
+  return Status::OK();
+}
+
 Status InferenceSession::LoadOrtModel(const PathString& model_uri) {
   return LoadOrtModelWithLoader(
       [&]() {
         model_location_ = model_uri;
+
+        const bool map_model_file =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers,
+                                                               "0") == "1";
+        if (map_model_file) {
+          auto status = MapOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_mapped_bytes_);
+          if (status.IsOK()) {
+            return Status::OK();
+          }
+
+          LOGS(*session_logger_, WARNING) << "Failed to memory map the ORT format model, reading it instead. "
+                                          << status.ErrorMessage();
+          ort_format_model_mapped_bytes_.reset();
+        }
+
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
         return Status::OK();
@@ -1486,8 +1709,8 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   ORT_RETURN_IF(nullptr == fbs_model, "Missing Model. Invalid ORT format model.");
 
   // if we're using the bytes directly because kOrtSessionOptionsConfigUseORTModelBytesDirectly was set and the user
-  // provided an existing buffer of bytes when creating the InferenceSession, ort_format_model_bytes_data_holder_
-  // will be empty.
+  // provided an existing buffer of bytes when creating the InferenceSession, or because the model file was memory
+  // mapped, ort_format_model_bytes_data_holder_ will be empty.
   // if that is the case we also allow creating initializers that directly use those bytes.
   const auto& config_options = session_options_.config_options;
   using_ort_model_bytes_for_initializers_ =
@@ -1719,17 +1942,13 @@ common::Status InferenceSession::Initialize() {
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
     }
 
-    // Verify that there are no external initializers in the graph if external data is disabled.
-    onnxruntime::Graph& graph = model_->MainGraph();
-#ifdef DISABLE_EXTERNAL_INITIALIZERS
-    const InitializedTensorSet& initializers = graph.GetAllInitializedTensors();
-    for (const auto& it : initializers) {
-      if (utils::HasExternalData(*it.second)) {
-        return common::Status(common::ONNXRUNTIME, common::FAIL,
-                              "Initializer tensors with external data is not allowed.");
-      }
+    {
+      // the profiler was configured with the valid options when the session was constructed
+      size_t profiling_sampling_rate = 1;
+      int64_t profiling_flush_interval_ms = 0;
+      ORT_RETURN_IF_ERROR_SESSIONID_(GetProfilerOptions(session_options_.config_options, profiling_sampling_rate,
+                                                        profiling_flush_interval_ms));
     }
-#endif
 
     // Register default CPUExecutionProvider if user didn't provide it through the Register() calls.
     // RegisterExecutionProvider locks the session_mutex_ so we can't be holding it when we call that
@@ -1746,6 +1965,24 @@ common::Status InferenceSession::Initialize() {
     // This check is placed here because it serves as a common place for all language bindings.
     ORT_RETURN_IF_ERROR_SESSIONID_(HasInvalidCombinationOfExecutionProviders());
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // this may replace model_, so it needs to happen before any reference to the graph is taken. the session mutex
+    // must not be held as loading a model acquires it.
+    ORT_RETURN_IF_ERROR_SESSIONID_(LoadOptimizedModelFromCache());
+#endif
+
+    // Verify that there are no external initializers in the graph if external data is disabled.
+    onnxruntime::Graph& graph = model_->MainGraph();
+#ifdef DISABLE_EXTERNAL_INITIALIZERS
+    const InitializedTensorSet& initializers = graph.GetAllInitializedTensors();
+    for (const auto& it : initializers) {
+      if (utils::HasExternalData(*it.second)) {
+        return common::Status(common::ONNXRUNTIME, common::FAIL,
+                              "Initializer tensors with external data is not allowed.");
+      }
+    }
+#endif
+
     // re-acquire mutex
     std::lock_guard<std::mutex> l(session_mutex_);
 
@@ -1788,6 +2025,12 @@ common::Status InferenceSession::Initialize() {
       session_state_->UpdateAllocatorsWithEnvAllocators(environment_.GetRegisteredSharedAllocators());
     }
 
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShareInitializersAcrossSessions,
+                                                           "0") == "1") {
+      LOGS(*session_logger_, INFO) << "This session will share constant initializers with other sessions.";
+      session_state_->SetSharedInitializerStore(&environment_.GetSharedInitializerStore());
+    }
+
     for (auto& ep : execution_providers_) {
       auto tuning_ctx = ep->GetTuningContext();
       if (nullptr != tuning_ctx) {
@@ -2046,6 +2289,11 @@ common::Status InferenceSession::Initialize() {
 
       // Update temporary copies of metadata, input- and output definitions to the same state as the resolved graph
       ORT_RETURN_IF_ERROR_SESSIONID_(SaveModelMetadata(*model_));
+
+      // the initializers are still in the graph at this point. they are removed when finalizing the session state.
+      if (!optimized_model_cache_path_.empty()) {
+        SaveOptimizedModelToCache();
+      }
 #else   // !defined(ORT_MINIMAL_BUILD)
       ORT_RETURN_IF_ERROR_SESSIONID_(
           ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -2127,6 +2375,7 @@ common::Status InferenceSession::Initialize() {
     if (!using_ort_model_bytes_for_initializers_) {
       ort_format_model_bytes_ = gsl::span<const uint8_t>();
       std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+      ort_format_model_mapped_bytes_.reset();
     }
 
     // once the model is saved, we may remove unnecessary attributes for inference
@@ -2246,140 +2495,151 @@ static common::Status CheckTypes(MLDataType actual, MLDataType expected, const s
                          DataTypeImpl::ToString(expected), "))");
 }
 
-common::Status InferenceSession::ValidateInputsOutputs(gsl::span<const std::string> names,
-                                                       gsl::span<const OrtValue> feeds_fetches,
-                                                       const InputOutputDefMetaMap& input_output_meta_map,
-                                                       ArgType arg_type) const {
-  ORT_ENFORCE(arg_type == ArgType::kInput || arg_type == ArgType::kOutput, "Valid values kInput, kOutput");
-
+common::Status InferenceSession::ValidateInputOutput(const std::string& name,
+                                                     const OrtValue& input_output_ml_value,
+                                                     const InputOutputDefMetaData& meta,
+                                                     ArgType arg_type) const {
   const bool is_inputs = arg_type == ArgType::kInput;
 
   const char* const input_output_moniker = is_inputs ? "input" : "output";
-  const char* const feed_fetches_moniker = is_inputs ? "feed" : "fetch";
 
 #if !defined(DISABLE_SPARSE_TENSORS)
-  auto is_sparse_initializer = [this](const std::string& name) -> bool {
+  auto is_sparse_initializer = [this](const std::string& initializer_name) -> bool {
     int idx = -1;
-    if (session_state_->GetOrtValueNameIdxMap().GetIdx(name, idx).IsOK()) {
+    if (session_state_->GetOrtValueNameIdxMap().GetIdx(initializer_name, idx).IsOK()) {
       return session_state_->IsSparseInitializer(idx);
     }
     return false;
   };
 #endif
 
-  if (names.size() != feeds_fetches.size()) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, feed_fetches_moniker, " names has ", names.size(),
-                           " elements, but ", feed_fetches_moniker, " has ", feeds_fetches.size(), " elements.");
+  // For outputs the user may supply an unallocated placeholder.
+  if (!is_inputs && !input_output_ml_value.IsAllocated()) {
+    return Status::OK();
   }
 
-  for (size_t i = 0; i < feeds_fetches.size(); ++i) {
-    const auto& name = names[i];
+  auto expected_type = meta.ml_data_type;
 
-    auto iter = input_output_meta_map.find(name);
-    if (input_output_meta_map.end() == iter) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid ", input_output_moniker, " name: ", name);
-    }
-
-    const auto& input_output_ml_value = feeds_fetches[i];
-
-    // For outputs the user may supply an unallocated placeholder.
-    if (!is_inputs && !input_output_ml_value.IsAllocated()) {
-      continue;
-    }
-
-    auto expected_type = iter->second.ml_data_type;
-
-    if (input_output_ml_value.IsTensor()) {
-      if (!expected_type->IsTensorType()
+  if (input_output_ml_value.IsTensor()) {
+    if (!expected_type->IsTensorType()
 #if !defined(DISABLE_OPTIONAL_TYPE)
-          && !utils::IsOptionalTensor(expected_type)
+        && !utils::IsOptionalTensor(expected_type)
 #endif
-      ) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, input_output_moniker, " with name: '", name,
-                               "' expected to be of type: ", static_cast<int>(expected_type->type_), " but received a tensor");
-      }
+    ) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, input_output_moniker, " with name: '", name,
+                             "' expected to be of type: ", static_cast<int>(expected_type->type_), " but received a tensor");
+    }
 
-      // check for type
+    // check for type
 #if !defined(DISABLE_OPTIONAL_TYPE)
-      auto expected_element_type = expected_type->IsTensorType()
-                                       ? expected_type
-                                             ->AsTensorType()
-                                             ->GetElementType()
-                                       : utils::GetElementTypeFromOptionalTensor(expected_type);
+    auto expected_element_type = expected_type->IsTensorType()
+                                     ? expected_type
+                                           ->AsTensorType()
+                                           ->GetElementType()
+                                     : utils::GetElementTypeFromOptionalTensor(expected_type);
 #else
-      auto expected_element_type = expected_type->AsTensorType()->GetElementType();
+    auto expected_element_type = expected_type->AsTensorType()->GetElementType();
 #endif
 
-      const auto& input_output_tensor = input_output_ml_value.Get<Tensor>();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_output_tensor.DataType(),
-                                                expected_element_type, "tensor", input_output_moniker));
+    const auto& input_output_tensor = input_output_ml_value.Get<Tensor>();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_output_tensor.DataType(),
+                                              expected_element_type, "tensor", input_output_moniker));
+
+    // check for shape
+    const auto& opt_shape = meta.tensor_shape;
+    if (opt_shape.has_value() && !opt_shape->GetDims().empty()) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(name, input_output_tensor.Shape(),
+                                                 *opt_shape, input_output_moniker));
+    }
+  } else if (input_output_ml_value.IsSparseTensor()) {
+#if !defined(DISABLE_SPARSE_TENSORS)
 
-      // check for shape
-      const auto& opt_shape = iter->second.tensor_shape;
+    const SparseTensor& sparse_tensor = input_output_ml_value.Get<SparseTensor>();
+    if (expected_type->IsSparseTensorType()) {
+      auto expected_element_type = expected_type->AsSparseTensorType()->GetElementType();
+      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(sparse_tensor.DataType(), expected_element_type,
+                                                "sparse_tensor", input_output_moniker));
+      // Check shape
+      const auto& opt_shape = meta.tensor_shape;
       if (opt_shape.has_value() && !opt_shape->GetDims().empty()) {
-        ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(name, input_output_tensor.Shape(),
+        ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(name, sparse_tensor.DenseShape(),
                                                    *opt_shape, input_output_moniker));
       }
-    } else if (input_output_ml_value.IsSparseTensor()) {
-#if !defined(DISABLE_SPARSE_TENSORS)
-
-      const SparseTensor& sparse_tensor = input_output_ml_value.Get<SparseTensor>();
-      if (expected_type->IsSparseTensorType()) {
-        auto expected_element_type = expected_type->AsSparseTensorType()->GetElementType();
-        ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(sparse_tensor.DataType(), expected_element_type,
-                                                  "sparse_tensor", input_output_moniker));
-        // Check shape
-        const auto& opt_shape = iter->second.tensor_shape;
-        if (opt_shape.has_value() && !opt_shape->GetDims().empty()) {
-          ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(name, sparse_tensor.DenseShape(),
-                                                     *opt_shape, input_output_moniker));
-        }
-      } else if (is_sparse_initializer(name) &&
-                 expected_type->IsTensorType()) {
-        // If this metadata came from a sparse initializer converted to dense, then still validate it.
-        auto expected_element_type = expected_type->AsTensorType()->GetElementType();
-        ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(sparse_tensor.DataType(), expected_element_type,
-                                                  "sparse_tensor", input_output_moniker));
-        // Check shape
-        const auto& opt_shape = iter->second.tensor_shape;
-        if (opt_shape.has_value() && !opt_shape->GetDims().empty()) {
-          ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(name, sparse_tensor.DenseShape(),
-                                                     *opt_shape, input_output_moniker));
-        }
-      } else {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, input_output_moniker, " with name: '", name,
-                               "' expected to be of type: ", static_cast<int>(expected_type->type_), " but received a sparse tensor");
+    } else if (is_sparse_initializer(name) &&
+               expected_type->IsTensorType()) {
+      // If this metadata came from a sparse initializer converted to dense, then still validate it.
+      auto expected_element_type = expected_type->AsTensorType()->GetElementType();
+      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(sparse_tensor.DataType(), expected_element_type,
+                                                "sparse_tensor", input_output_moniker));
+      // Check shape
+      const auto& opt_shape = meta.tensor_shape;
+      if (opt_shape.has_value() && !opt_shape->GetDims().empty()) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(name, sparse_tensor.DenseShape(),
+                                                   *opt_shape, input_output_moniker));
       }
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, input_output_moniker, " with name: '", name,
+                             "' expected to be of type: ", static_cast<int>(expected_type->type_), " but received a sparse tensor");
+    }
 #else
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, input_output_moniker, " with name ", name,
-                             " is a sparse tensor, which is not supported in this build.");
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, input_output_moniker, " with name ", name,
+                           " is a sparse tensor, which is not supported in this build.");
 #endif
-    } else if (input_output_ml_value.IsTensorSequence()) {
-      if (!expected_type->IsTensorSequenceType()
+  } else if (input_output_ml_value.IsTensorSequence()) {
+    if (!expected_type->IsTensorSequenceType()
 #if !defined(DISABLE_OPTIONAL_TYPE)
-          && !utils::IsOptionalSeqTensor(expected_type)
+        && !utils::IsOptionalSeqTensor(expected_type)
 #endif
-      ) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, input_output_moniker, " with name: '", name,
-                               "' expected to be of type: ", static_cast<int>(expected_type->type_), " but received a tensor sequence");
-      }
+    ) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, input_output_moniker, " with name: '", name,
+                             "' expected to be of type: ", static_cast<int>(expected_type->type_), " but received a tensor sequence");
+    }
 
 #if !defined(DISABLE_OPTIONAL_TYPE)
-      auto expected_element_type = expected_type->IsTensorSequenceType()
-                                       ? expected_type
-                                             ->AsSequenceTensorType()
-                                             ->GetElementType()
-                                       : utils::GetElementTypeFromOptionalSeqTensor(expected_type);
+    auto expected_element_type = expected_type->IsTensorSequenceType()
+                                     ? expected_type
+                                           ->AsSequenceTensorType()
+                                           ->GetElementType()
+                                     : utils::GetElementTypeFromOptionalSeqTensor(expected_type);
 #else
-      auto expected_element_type = expected_type->AsSequenceTensorType()->GetElementType();
+    auto expected_element_type = expected_type->AsSequenceTensorType()->GetElementType();
 #endif
 
-      auto input_output_element_type = input_output_ml_value.Get<TensorSeq>().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_output_element_type, expected_element_type, "seq", input_output_moniker));
-    } else {
-      auto input_output_type = input_output_ml_value.Type();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_output_type, expected_type, "", input_output_moniker));
+    auto input_output_element_type = input_output_ml_value.Get<TensorSeq>().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_output_element_type, expected_element_type, "seq", input_output_moniker));
+  } else {
+    auto input_output_type = input_output_ml_value.Type();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_output_type, expected_type, "", input_output_moniker));
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::ValidateInputsOutputs(gsl::span<const std::string> names,
+                                                       gsl::span<const OrtValue> feeds_fetches,
+                                                       const InputOutputDefMetaMap& input_output_meta_map,
+                                                       ArgType arg_type) const {
+  ORT_ENFORCE(arg_type == ArgType::kInput || arg_type == ArgType::kOutput, "Valid values kInput, kOutput");
+
+  const bool is_inputs = arg_type == ArgType::kInput;
+
+  const char* const input_output_moniker = is_inputs ? "input" : "output";
+  const char* const feed_fetches_moniker = is_inputs ? "feed" : "fetch";
+
+  if (names.size() != feeds_fetches.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, feed_fetches_moniker, " names has ", names.size(),
+                           " elements, but ", feed_fetches_moniker, " has ", feeds_fetches.size(), " elements.");
+  }
+
+  for (size_t i = 0; i < feeds_fetches.size(); ++i) {
+    const auto& name = names[i];
+
+    auto iter = input_output_meta_map.find(name);
+    if (input_output_meta_map.end() == iter) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid ", input_output_moniker, " name: ", name);
     }
+
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputOutput(name, feeds_fetches[i], iter->second, arg_type));
   }
 
   return Status::OK();
@@ -2533,6 +2793,15 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info, nullptr);
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 PreparedRun* prepared_run) {
+  profiling::Profiler::RunScope profiler_run_scope(session_profiler_);
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
@@ -2587,8 +2856,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
       // log evaluation start to trace logging provider
       env.GetTelemetryProvider().LogEvaluationStart();
 
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      if (prepared_run != nullptr) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidatePreparedRun(*prepared_run, feeds, p_fetches));
+      } else {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      }
 
       // shrink certain default memory arenas if the user has requested for it
       const std::string& shrink_memory_arenas =
@@ -2598,8 +2871,19 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
       }
 
-      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-      FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+      // a prepared run already holds the mapping of the names to OrtValue indices,
+      // only the device copy info from its previous execution needs to be cleared.
+      std::optional<FeedsFetchesManager> owned_feeds_fetches_manager;
+      if (prepared_run != nullptr) {
+        prepared_run->feeds_fetches_manager_.ResetDeviceCopyInfo();
+      } else {
+        owned_feeds_fetches_manager.emplace(
+            FeedsFetchesInfo(feed_names, output_names, session_state_->GetOrtValueNameIdxMap()));
+      }
+
+      FeedsFetchesManager& feeds_fetches_manager = prepared_run != nullptr
+                                                       ? prepared_run->feeds_fetches_manager_
+                                                       : *owned_feeds_fetches_manager;
 
       if (p_fetches_device_info) {
         // populate the target device info. ignored if pre-allocated fetches are provided
@@ -2736,11 +3020,35 @@ Status InferenceSession::Run(const RunOptions& run_options,
       cached_execution_provider_for_graph_replay_.AllowGraphCaptureOnRun(graph_annotation_id) &&
       !cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
     LOGS(*session_logger_, INFO) << "Start another run for necessary memory allocation or graph capture.";
-    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
+    ORT_RETURN_IF_ERROR(RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                                prepared_run));
   }
   return retval;
 }
 
+// Hand the produced values to the caller for the entries of fetches that were not pre-allocated.
+static void SetUnallocatedFetches(const std::vector<OrtValue>& fetch_vec, gsl::span<OrtValue*> fetches) {
+  const size_t num_fetches = fetches.size();
+
+  // We do it in two loops to make sure copy __ctors does not throw
+  InlinedVector<std::unique_ptr<OrtValue>> fetch_unique_ptrs;
+  fetch_unique_ptrs.reserve(num_fetches);
+  for (size_t i = 0; i != num_fetches; ++i) {
+    if (fetches[i] == nullptr) {
+      fetch_unique_ptrs.emplace_back(std::make_unique<OrtValue>(fetch_vec[i]));
+    } else {
+      fetch_unique_ptrs.emplace_back();
+    }
+  }
+
+  for (size_t i = 0; i != num_fetches; ++i) {
+    if (fetches[i] == nullptr) {
+      ORT_ENFORCE(fetch_unique_ptrs[i] != nullptr);
+      fetches[i] = fetch_unique_ptrs[i].release();
+    }
+  }
+}
+
 Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const char* const> feed_names,
                              gsl::span<const OrtValue* const> feeds,
@@ -2792,23 +3100,137 @@ Status InferenceSession::Run(const RunOptions& run_options,
   if (!status.IsOK())
     return status;
 
-  // We do it in two loops to make sure copy __ctors does not throw
-  InlinedVector<std::unique_ptr<OrtValue>> fetch_unique_ptrs;
-  fetch_unique_ptrs.reserve(num_fetches);
-  for (size_t i = 0; i != num_fetches; ++i) {
-    if (fetches[i] == nullptr) {
-      fetch_unique_ptrs.emplace_back(std::make_unique<OrtValue>(fetch_vec[i]));
-    } else {
-      fetch_unique_ptrs.emplace_back();
+  SetUnallocatedFetches(fetch_vec, fetches);
+  return Status::OK();
+}
+
+Status InferenceSession::PrepareRun(gsl::span<const std::string> feed_names,
+                                    gsl::span<const std::string> output_names,
+                                    std::unique_ptr<PreparedRun>& prepared_run) const {
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  if (output_names.empty()) {
+    return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "At least one output should be requested.");
+  }
+
+  InlinedVector<const InputOutputDefMetaData*> feed_meta_data;
+  feed_meta_data.reserve(feed_names.size());
+  for (const auto& name : feed_names) {
+    auto iter = input_def_map_.find(name);
+    if (input_def_map_.end() == iter) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid input name: ", name);
     }
+    feed_meta_data.push_back(&iter->second);
   }
 
-  for (size_t i = 0; i != num_fetches; ++i) {
-    if (fetches[i] == nullptr) {
-      ORT_ENFORCE(fetch_unique_ptrs[i] != nullptr);
-      fetches[i] = fetch_unique_ptrs[i].release();
+  InlinedVector<const InputOutputDefMetaData*> output_meta_data;
+  output_meta_data.reserve(output_names.size());
+  for (const auto& name : output_names) {
+    auto iter = output_def_map_.find(name);
+    if (output_def_map_.end() == iter) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid output name: ", name);
     }
+    output_meta_data.push_back(&iter->second);
   }
+
+  FeedsFetchesInfo info;
+  info.feed_names.assign(feed_names.begin(), feed_names.end());
+  info.output_names.assign(output_names.begin(), output_names.end());
+  ORT_RETURN_IF_ERROR_SESSIONID_(info.SetMLValueIdxs(session_state_->GetOrtValueNameIdxMap()));
+
+  // PreparedRun has a private constructor so std::make_unique can't be used
+  prepared_run.reset(new PreparedRun(*this, std::move(info)));
+  prepared_run->feed_meta_data_ = std::move(feed_meta_data);
+  prepared_run->output_meta_data_ = std::move(output_meta_data);
+  return Status::OK();
+}
+
+Status InferenceSession::ValidatePreparedRun(const PreparedRun& prepared_run,
+                                             gsl::span<const OrtValue> feeds,
+                                             const std::vector<OrtValue>* p_fetches) const {
+  if (prepared_run.session_ != this) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The prepared run was created by a different session.");
+  }
+
+  const auto feed_names = prepared_run.GetFeedNames();
+  if (feeds.size() != feed_names.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "feed names has ", feed_names.size(),
+                           " elements, but feed has ", feeds.size(), " elements.");
+  }
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputOutput(feed_names[i], feeds[i], *prepared_run.feed_meta_data_[i],
+                                                       ArgType::kInput));
+  }
+
+  if (p_fetches == nullptr || p_fetches->empty()) {
+    return Status::OK();
+  }
+
+  const auto output_names = prepared_run.GetOutputNames();
+  if (p_fetches->size() != output_names.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fetch names has ", output_names.size(),
+                           " elements, but fetch has ", p_fetches->size(), " elements.");
+  }
+
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputOutput(output_names[i], (*p_fetches)[i],
+                                                       *prepared_run.output_meta_data_[i], ArgType::kOutput));
+  }
+
+  return Status::OK();
+}
+
+Status InferenceSession::Run(const RunOptions& run_options, PreparedRun& prepared_run,
+                             gsl::span<const OrtValue> feeds, std::vector<OrtValue>* p_fetches) {
+  // the feeds/fetches manager of the prepared run is updated during execution so it can't be shared
+  if (prepared_run.in_use_.exchange(true)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The prepared run is being used by another Run call.");
+  }
+  auto release_prepared_run = gsl::finally([&prepared_run]() { prepared_run.in_use_.store(false); });
+
+  return RunImpl(run_options, prepared_run.GetFeedNames(), feeds, prepared_run.GetOutputNames(), p_fetches,
+                 nullptr, &prepared_run);
+}
+
+Status InferenceSession::Run(const RunOptions& run_options, PreparedRun& prepared_run,
+                             gsl::span<const OrtValue* const> feeds, gsl::span<OrtValue*> fetches) {
+  if (feeds.size() != prepared_run.GetFeedNames().size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Expected ", prepared_run.GetFeedNames().size(),
+                           " inputs but ", feeds.size(), " were provided.");
+  }
+
+  if (fetches.size() != prepared_run.GetOutputNames().size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Expected ", prepared_run.GetOutputNames().size(),
+                           " outputs but ", fetches.size(), " were provided.");
+  }
+
+  InlinedVector<OrtValue> feed_vec;
+  feed_vec.reserve(feeds.size());
+  for (size_t i = 0; i != feeds.size(); ++i) {
+    if (!feeds[i]) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             MakeString("NULL input supplied for input ", prepared_run.GetFeedNames()[i]).c_str());
+    }
+    feed_vec.emplace_back(*feeds[i]);
+  }
+
+  std::vector<OrtValue> fetch_vec;
+  fetch_vec.reserve(fetches.size());
+  for (size_t i = 0; i != fetches.size(); ++i) {
+    if (fetches[i] != nullptr) {
+      fetch_vec.emplace_back(*fetches[i]);
+    } else {
+      fetch_vec.emplace_back();
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(Run(run_options, prepared_run, feed_vec, &fetch_vec));
+
+  SetUnallocatedFetches(fetch_vec, fetches);
   return Status::OK();
 }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <optional>
 #include <string>
@@ -29,6 +30,7 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
 #include <mutex>
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
@@ -352,6 +354,60 @@ class InferenceSession {
                                         RunAsyncCallbackFn callback,
                                         void* user_data = nullptr);
 
+  /**
+   * Feed and fetch names of a Run call that were resolved ahead of time by PrepareRun.
+   * Running with a PreparedRun skips the per-call name lookups and the setup of the feed/fetch mapping.
+   * An instance belongs to the session that created it and must not be used by multiple threads at the same time.
+   */
+  class PreparedRun {
+   public:
+    gsl::span<const std::string> GetFeedNames() const {
+      return feeds_fetches_manager_.GetFeedsFetchesInfo().feed_names;
+    }
+
+    gsl::span<const std::string> GetOutputNames() const {
+      return feeds_fetches_manager_.GetFeedsFetchesInfo().output_names;
+    }
+
+   private:
+    friend class InferenceSession;
+
+    PreparedRun(const InferenceSession& session, FeedsFetchesInfo&& info)
+        : session_(&session), feeds_fetches_manager_(std::move(info)) {}
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PreparedRun);
+
+    const InferenceSession* session_;
+    FeedsFetchesManager feeds_fetches_manager_;
+    InlinedVector<const InputOutputDefMetaData*> feed_meta_data_;
+    InlinedVector<const InputOutputDefMetaData*> output_meta_data_;
+    std::atomic<bool> in_use_{false};
+  };
+
+  /**
+   * Validates the feed and output names against the model and resolves them once for repeated Run calls.
+   * @param feed_names names of the inputs that will be provided, in order.
+   * @param output_names names of the outputs to produce, in order.
+   * @param prepared_run receives the prepared run on success.
+   * @return OK if success.
+   */
+  [[nodiscard]] common::Status PrepareRun(gsl::span<const std::string> feed_names,
+                                          gsl::span<const std::string> output_names,
+                                          std::unique_ptr<PreparedRun>& prepared_run) const;
+
+  /**
+   * Run with feeds and fetches given in the order of the names passed to PrepareRun.
+   * The feeds are still checked for type and shape on every call.
+   */
+  [[nodiscard]] common::Status Run(const RunOptions& run_options, PreparedRun& prepared_run,
+                                   gsl::span<const OrtValue> feeds, std::vector<OrtValue>* p_fetches);
+
+  /**
+   * Same as above, with entries of fetches that are nullptr set to newly allocated OrtValue instances.
+   */
+  [[nodiscard]] common::Status Run(const RunOptions& run_options, PreparedRun& prepared_run,
+                                   gsl::span<const OrtValue* const> feeds, gsl::span<OrtValue*> fetches);
+
   /**
    * Run a pre-loaded and pre-intialized model.
    * Multiple threads are allowed to run this function; hence its thread-safe.
@@ -632,6 +688,14 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const std::filesystem::path& filepath) const;
+
+  // Replace the loaded ONNX model with the optimized model from the cache configured by
+  // kOrtSessionOptionsConfigOptimizedModelCacheDir if there is a matching entry. Otherwise set
+  // optimized_model_cache_path_ so the optimized model is added to the cache during initialization.
+  common::Status LoadOptimizedModelFromCache();
+
+  // Add the optimized model to the cache. Failures are logged and don't fail the session initialization.
+  void SaveOptimizedModelToCache() const;
 #endif
 
   /**
@@ -674,11 +738,28 @@ class InferenceSession {
   [[nodiscard]] common::Status ValidateOutputs(gsl::span<const std::string> output_names,
                                                const std::vector<OrtValue>* p_fetches) const;
 
+  [[nodiscard]] common::Status ValidateInputOutput(const std::string& name,
+                                                   const OrtValue& input_output_ml_value,
+                                                   const InputOutputDefMetaData& meta,
+                                                   ArgType arg_type) const;
+
   [[nodiscard]] common::Status ValidateInputsOutputs(gsl::span<const std::string> feed_fetches_names,
                                                      gsl::span<const OrtValue> feeds_fetches,
                                                      const InputOutputDefMetaMap& input_output_meta_map,
                                                      ArgType arg_type) const;
 
+  [[nodiscard]] common::Status ValidatePreparedRun(const PreparedRun& prepared_run,
+                                                   gsl::span<const OrtValue> feeds,
+                                                   const std::vector<OrtValue>* p_fetches) const;
+
+  // Shared implementation of the Run overloads. When prepared_run is provided the feed and output names
+  // have already been validated and mapped, and feed_names/output_names must be the ones it holds.
+  [[nodiscard]] common::Status RunImpl(const RunOptions& run_options,
+                                       gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                       gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                       const std::vector<OrtDevice>* p_fetches_device_info,
+                                       PreparedRun* prepared_run);
+
   [[nodiscard]] common::Status WaitForNotification(Notification* p_executor_done, int64_t timeout_in_ms);
 
   template <typename T>
@@ -717,6 +798,14 @@ class InferenceSession {
   onnxruntime::GraphTransformerManager graph_transformer_mgr_;
 
   InlinedHashSet<gsl::not_null<const ONNX_NAMESPACE::OpSchema*>> saved_runtime_optimization_produced_node_op_schemas_;
+
+  // path of the optimized model cache entry to create during initialization. empty if the cache is not used or the
+  // model was loaded from the cache.
+  std::filesystem::path optimized_model_cache_path_;
+
+  // whether graph transformers were registered through RegisterGraphTransformer(). the optimized model cache can't
+  // tell what they do, so it is not used.
+  bool has_registered_graph_transformers_ = false;
 #endif
   // Any GraphTransformer/RewriteRule name in this set will not be enabled.
   InlinedHashSet<std::string> optimizers_to_disable_;
@@ -862,6 +951,11 @@ class InferenceSession {
   // "session.use_ort_model_bytes_directly" to "1", this will be empty
   std::vector<uint8_t> ort_format_model_bytes_data_holder_;
 
+  // In case the session is started with a model_uri and "session.use_ort_model_bytes_for_initializers" is set to
+  // "1", this holds the memory mapped model file instead, so that initializers can use it in place until the
+  // InferenceSession goes away.
+  Env::MappedMemoryPtr ort_format_model_mapped_bytes_;
+
   bool using_ort_model_bytes_for_initializers_{false};
 
   // Container to store pre-packed weights to share between sessions.
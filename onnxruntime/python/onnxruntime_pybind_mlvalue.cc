@@ -9,6 +9,8 @@
 #define PY_ARRAY_UNIQUE_SYMBOL onnxruntime_python_ARRAY_API
 #include "python/numpy_helper.h"
 
+#include <cstring>
+
 #include "core/graph/graph.h"
 #include "core/framework/tensor_shape.h"
 #include "core/framework/tensor.h"
@@ -532,6 +534,58 @@ class OrtPybindSingleUseAllocator : public IAllocator {
 
 using OrtPybindSingleUseAllocatorPtr = std::shared_ptr<OrtPybindSingleUseAllocator>;
 
+// Encodes a numpy unicode string, UCS-4 padded with zeros up to num_chars, as UTF-8 without going through a Python
+// str object. Returns false if it contains a code point UTF-8 can't encode, like lone surrogates.
+static bool Ucs4ToUtf8(const char* src, size_t num_chars, std::string& dst) {
+  // measure the encoded string first so it is written with a single allocation
+  size_t length = 0;
+  size_t utf8_size = 0;
+  uint32_t code_point = 0;
+  for (; length < num_chars; ++length) {
+    std::memcpy(&code_point, src + length * 4, 4);
+    if (code_point == 0) {
+      break;
+    }
+    if (code_point < 0x80) {
+      utf8_size += 1;
+    } else if (code_point < 0x800) {
+      utf8_size += 2;
+    } else if (code_point < 0x10000) {
+      if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+        return false;
+      }
+      utf8_size += 3;
+    } else if (code_point < 0x110000) {
+      utf8_size += 4;
+    } else {
+      return false;
+    }
+  }
+
+  dst.resize(utf8_size);
+  char* out = dst.data();
+  for (size_t i = 0; i < length; ++i) {
+    std::memcpy(&code_point, src + i * 4, 4);
+    if (code_point < 0x80) {
+      *out++ = static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+      *out++ = static_cast<char>(0xC0 | (code_point >> 6));
+      *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+      *out++ = static_cast<char>(0xE0 | (code_point >> 12));
+      *out++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+      *out++ = static_cast<char>(0xF0 | (code_point >> 18));
+      *out++ = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+      *out++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      *out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+  }
+
+  return true;
+}
+
 // Expects p_tensor properly created
 // Does not manage darray life-cycle
 
@@ -547,15 +601,10 @@ static void CopyDataToTensor(PyArrayObject* darray, int npy_type, Tensor& tensor
     const char* src = reinterpret_cast<const char*>(PyArray_DATA(darray));
     for (int i = 0; i < total_items; i++, src += item_size) {
       // Python unicode strings are assumed to be USC-4. Strings are stored as UTF-8.
-      PyObject* pStr = PyUnicode_FromKindAndData(PyUnicode_4BYTE_KIND, src, num_chars);
-      UniqueDecRefPtr<PyObject> strGuard(pStr, DecRefFn<PyObject>());
-      const char* str = PyUnicode_AsUTF8(pStr);
-      if (str == NULL) {
+      // Size is equal to the longest string size, numpy stores
+      // strings in a single array.
+      if (!Ucs4ToUtf8(src, static_cast<size_t>(num_chars), dst[i])) {
         dst[i].clear();
-      } else {
-        // Size is equal to the longest string size, numpy stores
-        // strings in a single array.
-        dst[i] = str;
       }
     }
   } else if (npy_type == NPY_STRING || npy_type == NPY_VOID) {
@@ -582,9 +631,19 @@ static void CopyDataToTensor(PyArrayObject* darray, int npy_type, Tensor& tensor
       // Python unicode strings are assumed to be USC-4. Strings are stored as UTF-8.
       PyObject* item = PyArray_GETITEM(darray, src);
       UniqueDecRefPtr<PyObject> itemGuard(item, DecRefFn<PyObject>());
-      PyObject* pStr = PyObject_Str(item);
-      UniqueDecRefPtr<PyObject> strGuard(pStr, DecRefFn<PyObject>());
-      dst[i] = py::reinterpret_borrow<py::str>(pStr);
+      if (PyUnicode_Check(item)) {
+        // Use the UTF-8 representation cached by the str object rather than encoding it to a temporary bytes object.
+        Py_ssize_t size = 0;
+        const char* utf8 = PyUnicode_AsUTF8AndSize(item, &size);
+        if (utf8 == nullptr) {
+          throw py::error_already_set();
+        }
+        dst[i].assign(utf8, static_cast<size_t>(size));
+      } else {
+        PyObject* pStr = PyObject_Str(item);
+        UniqueDecRefPtr<PyObject> strGuard(pStr, DecRefFn<PyObject>());
+        dst[i] = py::reinterpret_borrow<py::str>(pStr);
+      }
     }
   } else {
     void* buffer = tensor.MutableDataRaw();
@@ -10,6 +10,7 @@ from .operators.embed_layernorm import EmbedLayerNormalizationQuant
 from .operators.gather import GatherQuant, QDQGather
 from .operators.gavgpool import QGlobalAveragePool
 from .operators.gemm import QDQGemm, QLinearGemm
+from .operators.gru import GRUQuant
 from .operators.lstm import LSTMQuant
 from .operators.matmul import MatMulInteger, QDQMatMul, QLinearMatMul
 from .operators.maxpool import QDQMaxPool, QMaxPool
@@ -34,6 +35,7 @@ IntegerOpsRegistry = {
     "MatMul": MatMulInteger,
     "Attention": AttentionQuant,
     "LSTM": LSTMQuant,
+    "GRU": GRUQuant,
 }
 IntegerOpsRegistry.update(CommonOpsRegistry)
 
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Y[b] = base_output[b] + scale * A[b] x lora_a[i] x lora_b[i], computed with the adapter of each row
+std::vector<float> ComputeReference(const std::vector<float>& a, const std::vector<float>& base_output,
+                                    const std::vector<float>& lora_a, const std::vector<float>& lora_b,
+                                    const std::vector<int32_t>& adapter_indices,
+                                    int64_t rows_per_batch, int64_t k, int64_t rank, int64_t n, float scale) {
+  std::vector<float> y = base_output;
+  for (size_t b = 0; b < adapter_indices.size(); ++b) {
+    const int32_t index = adapter_indices[b];
+    if (index < 0) {
+      continue;
+    }
+
+    for (int64_t row = static_cast<int64_t>(b) * rows_per_batch; row < static_cast<int64_t>(b + 1) * rows_per_batch; ++row) {
+      std::vector<float> intermediate(static_cast<size_t>(rank), 0.0f);
+      for (int64_t r = 0; r < rank; ++r) {
+        for (int64_t i = 0; i < k; ++i) {
+          intermediate[r] += a[row * k + i] * lora_a[(index * k + i) * rank + r];
+        }
+      }
+      for (int64_t j = 0; j < n; ++j) {
+        float sum = 0.0f;
+        for (int64_t r = 0; r < rank; ++r) {
+          sum += intermediate[r] * lora_b[(index * rank + r) * n + j];
+        }
+        y[row * n + j] += scale * sum;
+      }
+    }
+  }
+  return y;
+}
+
+void RunMultiLoraMatMulTest(const std::vector<int32_t>& adapter_indices, int64_t sequence_length,
+                            int64_t num_adapters, int64_t k, int64_t rank, int64_t n, float scale) {
+  const int64_t batch_size = static_cast<int64_t>(adapter_indices.size());
+
+  RandomValueGenerator random{};
+  const std::vector<int64_t> a_dims{batch_size, sequence_length, k};
+  const std::vector<int64_t> base_output_dims{batch_size, sequence_length, n};
+  const std::vector<int64_t> lora_a_dims{num_adapters, k, rank};
+  const std::vector<int64_t> lora_b_dims{num_adapters, rank, n};
+  const auto a = random.Uniform<float>(a_dims, -1.0f, 1.0f);
+  const auto base_output = random.Uniform<float>(base_output_dims, -1.0f, 1.0f);
+  const auto lora_a = random.Uniform<float>(lora_a_dims, -1.0f, 1.0f);
+  const auto lora_b = random.Uniform<float>(lora_b_dims, -1.0f, 1.0f);
+
+  OpTester test("MultiLoraMatMul", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<float>("scale", scale);
+  test.AddInput<float>("A", a_dims, a);
+  test.AddInput<float>("base_output", base_output_dims, base_output);
+  test.AddInput<float>("lora_a", lora_a_dims, lora_a, true);
+  test.AddInput<float>("lora_b", lora_b_dims, lora_b, true);
+  test.AddInput<int32_t>("adapter_indices", {batch_size}, adapter_indices);
+  test.AddOutput<float>("Y", base_output_dims,
+                        ComputeReference(a, base_output, lora_a, lora_b, adapter_indices,
+                                         sequence_length, k, rank, n, scale));
+  test.SetOutputTolerance(1e-4f);
+  test.Run();
+}
+
+}  // namespace
+
+TEST(MultiLoraMatMulTest, SingleAdapter) {
+  RunMultiLoraMatMulTest({0, 0, 0}, 2, 1, 8, 4, 6, 1.0f);
+}
+
+TEST(MultiLoraMatMulTest, MixedAdapters) {
+  // segments of different lengths, with rows using the base model only in between
+  RunMultiLoraMatMulTest({2, 2, 0, -1, 1, 1, 1, -1, 2}, 3, 3, 16, 8, 12, 0.5f);
+  RunMultiLoraMatMulTest({1, 0, 1, 0}, 1, 2, 33, 2, 17, 2.0f);
+}
+
+TEST(MultiLoraMatMulTest, NoAdapter) {
+  RunMultiLoraMatMulTest({-1, -1}, 4, 2, 8, 4, 8, 1.0f);
+}
+
+TEST(MultiLoraMatMulTest, InvalidAdapterIndex) {
+  OpTester test("MultiLoraMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<float>("base_output", {2, 1}, {0.0f, 0.0f});
+  test.AddInput<float>("lora_a", {1, 2, 1}, {1.0f, 1.0f});
+  test.AddInput<float>("lora_b", {1, 1, 1}, {1.0f});
+  test.AddInput<int32_t>("adapter_indices", {2}, {0, 1});
+  test.AddOutput<float>("Y", {2, 1}, {3.0f, 7.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is out of range");
+}
+
+TEST(MultiLoraMatMulTest, MismatchedLeadingDims) {
+  // base_output has as many rows as A but they are split differently between the batch entries
+  OpTester test("MultiLoraMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 3, 1}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<float>("base_output", {3, 2, 1}, {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+  test.AddInput<float>("lora_a", {1, 1, 1}, {1.0f});
+  test.AddInput<float>("lora_b", {1, 1, 1}, {1.0f});
+  test.AddInput<int32_t>("adapter_indices", {2}, {0, 0});
+  test.AddOutput<float>("Y", {3, 2, 1}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "does not match A shape");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,260 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/util/qmath.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/util/include/default_providers.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Quantize and dequantize data in channel_count equally sized chunks
+template <typename QType>
+static std::vector<float> ApplyQDQ(const std::vector<float>& data, size_t channel_count, bool per_channel = false) {
+  std::vector<float> result(data.size());
+  size_t size_per_channel = data.size() / channel_count;
+
+  for (size_t channel_idx = 0; channel_idx < channel_count; channel_idx++) {
+    QType zp = 0;
+    float scale = 1.0f;
+    const float* data_buf = data.data() + size_per_channel * channel_idx;
+    if (per_channel) {
+      GetQuantizationParameter<QType, true, true>(data_buf, size_per_channel, scale, zp, nullptr);
+    } else {
+      GetQuantizationParameter<QType, true, false>(data_buf, size_per_channel, scale, zp, nullptr);
+    }
+
+    std::vector<QType> quant_data(size_per_channel);
+    MlasQuantizeLinear(data_buf, quant_data.data(), size_per_channel, scale, zp);
+
+    std::transform(quant_data.begin(), quant_data.end(), result.begin() + size_per_channel * channel_idx,
+                   [&zp, &scale](QType q) {
+                     return (static_cast<int32_t>(q) - zp) * scale;
+                   });
+  }
+
+  return result;
+}
+
+// Quantize w ([num_direction, row, col]) and transpose it to [num_direction, col, row]
+template <typename QType>
+static void QuantizeWeight(std::vector<QType>& w_quant, std::vector<float>& scale, std::vector<QType>& zp,
+                           const std::vector<float>& w, size_t num_direction, size_t row, size_t col,
+                           bool per_channel) {
+  std::vector<QType> w_quant_tmp(w.size());
+
+  size_t quant_param_size = per_channel ? num_direction * row : num_direction;
+  size_t quant_span = per_channel ? col : row * col;
+  scale.resize(quant_param_size);
+  zp.resize(quant_param_size);
+
+  for (size_t quant_param_idx = 0; quant_param_idx < quant_param_size; quant_param_idx++) {
+    const float* w_buf = w.data() + quant_param_idx * quant_span;
+    if (per_channel) {
+      GetQuantizationParameter<QType, true, true>(w_buf, quant_span, scale[quant_param_idx], zp[quant_param_idx], nullptr);
+    } else {
+      GetQuantizationParameter<QType, true, false>(w_buf, quant_span, scale[quant_param_idx], zp[quant_param_idx], nullptr);
+    }
+
+    MlasQuantizeLinear(w_buf, w_quant_tmp.data() + quant_param_idx * quant_span, quant_span,
+                       scale[quant_param_idx], zp[quant_param_idx]);
+  }
+
+  w_quant.resize(w.size());
+  for (size_t dir_idx = 0; dir_idx < num_direction; dir_idx++) {
+    const QType* w_quant_tmp_buf = w_quant_tmp.data() + dir_idx * row * col;
+    QType* w_quant_buf = w_quant.data() + dir_idx * row * col;
+    for (size_t c = 0; c < col; c++) {
+      for (size_t r = 0; r < row; r++) {
+        *w_quant_buf++ = *(w_quant_tmp_buf + r * col + c);
+      }
+    }
+  }
+}
+
+// Run the float GRU with quantized-dequantized inputs. With a sequence length of 1 and linear_before_reset
+// the quantized GRU quantizes exactly X and initial_h, so the results should match closely. Otherwise it also
+// quantizes the hidden states of the later steps or the reset hidden state, which the reference does not.
+template <typename QType>
+static void ComputeRefOutput(std::vector<float>& Y_data, std::vector<float>& Y_h_data,
+                             int64_t seq_length, int64_t input_size, int64_t batch_size, int64_t hidden_size,
+                             int64_t linear_before_reset,
+                             const std::vector<float>& X_data,
+                             const std::vector<float>& W_data,
+                             const std::vector<float>& R_data,
+                             const std::vector<float>* B_data,
+                             const std::vector<float>& initial_h_data,
+                             const std::string& direction,
+                             bool per_channel) {
+  OpTester test("GRU", 7 /*opset_version*/, onnxruntime::kOnnxDomain /*domain*/, false /*verify_output*/);
+
+  test.AddAttribute("direction", direction);
+  test.AddAttribute("hidden_size", hidden_size);
+  test.AddAttribute<int64_t>("linear_before_reset", linear_before_reset);
+
+  int64_t num_directions = (direction == "bidirectional") ? 2 : 1;
+  const size_t weight_channels = per_channel ? narrow<size_t>(num_directions * 3 * hidden_size)
+                                             : narrow<size_t>(num_directions);
+
+  test.AddInput<float>("X", {seq_length, batch_size, input_size}, ApplyQDQ<uint8_t>(X_data, 1));
+  test.AddInput<float>("W", {num_directions, 3 * hidden_size, input_size},
+                       ApplyQDQ<QType>(W_data, weight_channels, per_channel));
+  test.AddInput<float>("R", {num_directions, 3 * hidden_size, hidden_size},
+                       ApplyQDQ<QType>(R_data, weight_channels, per_channel));
+
+  if (B_data) {
+    test.AddInput<float>("B", {num_directions, 6 * hidden_size}, *B_data);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+
+  test.AddOptionalInputEdge<int>();
+  test.AddInput<float>("initial_h", {num_directions, batch_size, hidden_size},
+                       ApplyQDQ<uint8_t>(initial_h_data, narrow<size_t>(num_directions)));
+
+  Y_data.resize(narrow<size_t>(seq_length * num_directions * batch_size * hidden_size));
+  test.AddOutput<float>("Y", {seq_length, num_directions, batch_size, hidden_size}, Y_data);
+
+  Y_h_data.resize(narrow<size_t>(num_directions * batch_size * hidden_size));
+  test.AddOutput<float>("Y_h", {num_directions, batch_size, hidden_size}, Y_h_data);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+
+  std::vector<OrtValue> outputs = test.GetFetches();
+
+  const float* y_buffer = outputs[0].Get<Tensor>().Data<float>();
+  std::copy(y_buffer, y_buffer + Y_data.size(), Y_data.begin());
+
+  const float* y_h_buffer = outputs[1].Get<Tensor>().Data<float>();
+  std::copy(y_h_buffer, y_h_buffer + Y_h_data.size(), Y_h_data.begin());
+}
+
+template <typename QType>
+static void RunQuantGRU(int64_t input_size, int64_t batch_size, int64_t hidden_size,
+                        bool has_bias, bool is_initializer_W, bool is_initializer_R, bool per_channel,
+                        const std::string& direction, int64_t seq_len = 1, int64_t linear_before_reset = 1) {
+  OpTester test("DynamicQuantizeGRU", 1 /*opset_version*/, onnxruntime::kMSDomain /*domain*/);
+
+  int64_t num_directions = (direction == "bidirectional") ? 2 : 1;
+
+  test.AddAttribute("direction", direction);
+  test.AddAttribute("hidden_size", hidden_size);
+  test.AddAttribute<int64_t>("linear_before_reset", linear_before_reset);
+
+  RandomValueGenerator rand_gen;
+
+  std::vector<int64_t> X_dims = {seq_len, batch_size, input_size};
+  std::vector<float> X_data = rand_gen.Gaussian<float>(X_dims, 0.0f, 0.25f);
+  test.AddInput<float>("X", X_dims, X_data);
+
+  std::vector<float> W_data = rand_gen.Gaussian<float>(std::vector<int64_t>{num_directions, 3 * hidden_size, input_size},
+                                                       0.0f, 0.25f);
+  std::vector<float> w_scale;
+  std::vector<QType> w_zp;
+  std::vector<QType> w_quant;
+  QuantizeWeight(w_quant, w_scale, w_zp, W_data, narrow<size_t>(num_directions), narrow<size_t>(3 * hidden_size),
+                 narrow<size_t>(input_size), per_channel);
+  test.AddInput<QType>("W", {num_directions, input_size, 3 * hidden_size}, w_quant, is_initializer_W);
+
+  std::vector<float> R_data = rand_gen.Gaussian<float>(std::vector<int64_t>{num_directions, 3 * hidden_size, hidden_size},
+                                                       0.0f, 0.25f);
+  std::vector<float> r_scale;
+  std::vector<QType> r_zp;
+  std::vector<QType> r_quant;
+  QuantizeWeight(r_quant, r_scale, r_zp, R_data, narrow<size_t>(num_directions), narrow<size_t>(3 * hidden_size),
+                 narrow<size_t>(hidden_size), per_channel);
+  test.AddInput<QType>("R", {num_directions, hidden_size, 3 * hidden_size}, r_quant, is_initializer_R);
+
+  std::vector<float> B_data;
+  if (has_bias) {
+    std::vector<int64_t> B_dims = {num_directions, 6 * hidden_size};
+    B_data = rand_gen.Gaussian<float>(B_dims, 0.0f, 0.25f);
+    test.AddInput<float>("B", B_dims, B_data);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+
+  // sequence_lens
+  test.AddOptionalInputEdge<int>();
+
+  std::vector<int64_t> initial_h_dims = {num_directions, batch_size, hidden_size};
+  std::vector<float> initial_h_data = rand_gen.Gaussian<float>(initial_h_dims, 0.0f, 0.25f);
+  test.AddInput<float>("initial_h", initial_h_dims, initial_h_data);
+
+  std::vector<int64_t> per_tensor_dims = {num_directions};
+  std::vector<int64_t> per_channel_dims = {num_directions, 3 * hidden_size};
+  test.AddInput<float>("W_scale", per_channel ? per_channel_dims : per_tensor_dims, w_scale);
+  test.AddInput<QType>("W_zero_point", per_channel ? per_channel_dims : per_tensor_dims, w_zp);
+  test.AddInput<float>("R_scale", per_channel ? per_channel_dims : per_tensor_dims, r_scale);
+  test.AddInput<QType>("R_zero_point", per_channel ? per_channel_dims : per_tensor_dims, r_zp);
+
+  std::vector<float> Y_data;
+  std::vector<float> Y_h_data;
+  ComputeRefOutput<QType>(Y_data, Y_h_data, seq_len, input_size, batch_size, hidden_size, linear_before_reset,
+                          X_data, W_data, R_data, has_bias ? &B_data : nullptr, initial_h_data,
+                          direction, per_channel);
+
+  test.AddOutput<float>("Y", {seq_len, num_directions, batch_size, hidden_size}, Y_data);
+  test.AddOutput<float>("Y_h", {num_directions, batch_size, hidden_size}, Y_h_data);
+
+  // the hidden states quantized by the kernel but not by the reference add the error of their quantization
+  if (seq_len > 1 || linear_before_reset == 0) {
+    test.SetOutputAbsErr("Y", 0.02f);
+    test.SetOutputAbsErr("Y_h", 0.02f);
+  }
+
+  test.Run();
+}
+
+template <typename QType>
+static void RunQuantGRU(int64_t input_size, int64_t batch_size, int64_t hidden_size, bool per_channel = false) {
+  for (bool has_bias : {false, true}) {
+    for (bool prepack : {false, true}) {
+      for (const char* direction : {"forward", "reverse", "bidirectional"}) {
+        RunQuantGRU<QType>(input_size, batch_size, hidden_size, has_bias, prepack, prepack, per_channel, direction);
+      }
+    }
+  }
+}
+
+TEST(DynamicQuantGRUTest, SmallSize) {
+  RunQuantGRU<int8_t>(2, 1, 16);
+  RunQuantGRU<int8_t>(2, 1, 16, true /*per_channel*/);
+  RunQuantGRU<uint8_t>(2, 1, 16);
+}
+
+TEST(DynamicQuantGRUTest, SequenceAndReset) {
+  for (int64_t linear_before_reset : {0, 1}) {
+    for (const char* direction : {"forward", "reverse", "bidirectional"}) {
+      for (int64_t seq_len : {1, 3}) {
+        if (seq_len == 1 && linear_before_reset == 1) {
+          continue;  // covered by SmallSize
+        }
+        RunQuantGRU<int8_t>(4, 2, 16, true /*has_bias*/, false, false, false /*per_channel*/, direction,
+                            seq_len, linear_before_reset);
+        RunQuantGRU<int8_t>(4, 2, 16, true /*has_bias*/, true, true, true /*per_channel*/, direction,
+                            seq_len, linear_before_reset);
+        RunQuantGRU<uint8_t>(4, 2, 16, false /*has_bias*/, true, true, false /*per_channel*/, direction,
+                             seq_len, linear_before_reset);
+      }
+    }
+  }
+}
+
+TEST(DynamicQuantGRUTest, LargeSize) {
+  RunQuantGRU<int8_t>(12, 3, 278);
+  RunQuantGRU<int8_t>(12, 3, 278, true /*per_channel*/);
+  RunQuantGRU<uint8_t>(12, 3, 278);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -359,6 +359,13 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckReusedBuffer(const std::string& name, const std::string& reused_name) {
+    int id, reused_id;
+    index(name, id);
+    index(reused_name, reused_id);
+    EXPECT_EQ(plan_->allocation_plan[id].reused_buffer, reused_id) << "Error in reused buffer for " << name;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // TODO: add the checker for new implementation of release plan
     //// create set and check equality
@@ -716,6 +723,80 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+#if !defined(ENABLE_TRAINING)
+// Test that a freed buffer larger than the required size is reused, within a bounded size ratio.
+TEST_F(PlannerTest, ReuseLargerBufferTest) {
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  AddNormalNode(X1, X2);  // X2: temporary
+  AddNormalNode(X2, X3);  // X3: temporary
+  AddNormalNode(X3, X4);  // X4: temporary, smaller than X2 (reuse X2)
+  AddNormalNode(X4, X5);  // X5 output
+
+  Shape shape1w{50, 100};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{50, 60};
+  auto shape2 = &shape2w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape1}, {X4, shape2}, {X5, shape2}});
+
+  CreatePlan();
+
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckReusedBuffer(X4, X2);
+}
+
+// Test that a freed buffer much larger than the required size is not reused.
+TEST_F(PlannerTest, NoReuseOfMuchLargerBufferTest) {
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  AddNormalNode(X1, X2);
+  AddNormalNode(X2, X3);
+  AddNormalNode(X3, X4);
+  AddNormalNode(X4, X5);
+
+  Shape shape1w{50, 100};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{50, 10};
+  auto shape2 = &shape2w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape1}, {X4, shape2}, {X5, shape2}});
+
+  CreatePlan();
+
+  CheckAllocKind(X4, AllocKind::kAllocate);
+}
+
+// Test that a larger buffer is reused when the symbolic dimensions match, and not when they differ.
+TEST_F(PlannerTest, ReuseLargerBufferSymbolicTest) {
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6"), X7("X7");
+
+  AddNormalNode(X1, X2);  // X2: temporary
+  AddNormalNode(X2, X3);  // X3: temporary
+  AddNormalNode(X3, X4);  // X4: [N, 64], fits in X2 for any N (reuse X2)
+  AddNormalNode(X4, X5);  // X5: [M, 64], size unrelated to the freed buffers
+  AddNormalNode(X5, X6);  // X6: [N, 64]
+  AddNormalNode(X6, X7);  // X7 output
+
+  Shape shape1w{"N", "C"};
+  shape1w.value.mutable_dim(1)->set_dim_value(100);
+  auto shape1 = &shape1w.value;
+  Shape shape2w{"N", "C"};
+  shape2w.value.mutable_dim(1)->set_dim_value(64);
+  auto shape2 = &shape2w.value;
+  Shape shape3w{"M", "C"};
+  shape3w.value.mutable_dim(1)->set_dim_value(64);
+  auto shape3 = &shape3w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape1}, {X4, shape2}, {X5, shape3}, {X6, shape2}, {X7, shape2}});
+
+  CreatePlan();
+
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckReusedBuffer(X4, X2);
+  CheckAllocKind(X5, AllocKind::kAllocate);
+}
+#endif  // !defined(ENABLE_TRAINING)
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <filesystem>
 #include <functional>
 #include <iterator>
 #include <thread>
@@ -496,6 +497,116 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, TestOptimizedModelCache) {
+  const string test_model = "testdata/transform/abs-id-max.onnx";
+  const std::filesystem::path cache_dir = "optimized_model_cache_test";
+  std::filesystem::remove_all(cache_dir);
+
+  auto cache_entries = [&cache_dir]() {
+    std::vector<std::filesystem::path> entries;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir)) {
+      entries.push_back(entry.path());
+    }
+    return entries;
+  };
+
+  auto read_file = [](const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  };
+
+  // the cache hits and misses are logged at INFO level
+  auto capturing_sink = new CapturingSink();
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(capturing_sink), logging::Severity::kINFO, false,
+      LoggingManager::InstanceType::Temporal);
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+  auto count_log_messages = [capturing_sink](const std::string& text) {
+    const auto& messages = capturing_sink->Messages();
+    return std::count_if(messages.begin(), messages.end(),
+                         [&text](const std::string& message) { return message.find(text) != std::string::npos; });
+  };
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestOptimizedModelCache";
+  so.graph_optimization_level = TransformerLevel::Level1;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigOptimizedModelCacheDir,
+                                                    cache_dir.string().c_str()));
+
+  // the first session optimizes the model and adds it to the cache
+  {
+    InferenceSessionWrapper session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+  }
+  ASSERT_EQ(count_log_messages("Optimized model cache miss"), 1);
+  ASSERT_EQ(count_log_messages("Optimized model cache hit"), 0);
+
+  const auto entries = cache_entries();
+  ASSERT_EQ(entries.size(), 1u);
+  const auto cache_entry = entries[0];
+  const auto cache_entry_write_time = std::filesystem::last_write_time(cache_entry);
+  const auto cache_entry_contents = read_file(cache_entry);
+
+  // the second session loads the optimized model from the cache
+  {
+    InferenceSessionWrapper session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+
+    std::vector<int64_t> dims = {2, 3, 4};
+    std::vector<float> values(24, -1.0f);
+    OrtValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, values, &ml_value);
+    NameMLValMap feeds{{"A", ml_value}};
+    std::vector<std::string> output_names{"D"};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    EXPECT_EQ(fetches[0].Get<Tensor>().Data<float>()[0], 1.0f);
+  }
+  ASSERT_EQ(count_log_messages("Optimized model cache miss"), 1);
+  ASSERT_EQ(count_log_messages("Optimized model cache hit"), 1);
+
+  // the entry was not rewritten
+  ASSERT_TRUE(cache_entries() == entries);
+  ASSERT_TRUE(std::filesystem::last_write_time(cache_entry) == cache_entry_write_time);
+  ASSERT_EQ(read_file(cache_entry), cache_entry_contents);
+
+  // a session with a registered transformer doesn't use the cache, as what the transformer does is unknown
+  {
+    InferenceSessionWrapper session_object{so, *env};
+    auto dummy_transformer_unique_ptr = std::make_unique<DummyGraphTransformer>("DummyTransformer");
+    const auto* dummy_transformer = dummy_transformer_unique_ptr.get();
+    ASSERT_STATUS_OK(session_object.RegisterGraphTransformer(std::move(dummy_transformer_unique_ptr),
+                                                             TransformerLevel::Level1));
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+    ASSERT_TRUE(dummy_transformer->IsTransformerInvoked());
+  }
+  ASSERT_EQ(count_log_messages("The optimized model cache is not used"), 1);
+  ASSERT_EQ(count_log_messages("Optimized model cache hit"), 1);
+  ASSERT_TRUE(cache_entries() == entries);
+
+  // different session options need a different cache entry
+  so.graph_optimization_level = TransformerLevel::Default;
+  {
+    InferenceSessionWrapper session_object{so, *env};
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    ASSERT_GT(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+  }
+  ASSERT_EQ(count_log_messages("Optimized model cache miss"), 2);
+  ASSERT_EQ(cache_entries().size(), 2u);
+
+  std::filesystem::remove_all(cache_dir);
+}
+
 #ifdef ORT_RUN_EXTERNAL_ONNX_TESTS
 static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   if (f_arg.size() != s_arg.size()) {
@@ -667,6 +778,8 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
 
   bool has_kernel_info = false;
   for (size_t i = 1; i < size - 1; ++i) {
+    // only recorded with kOrtSessionOptionsConfigProfilingHardwareCounters
+    ASSERT_TRUE(lines[i].find("hardware_counters") == string::npos);
     for (auto& s : tags) {
       ASSERT_TRUE(lines[i].find(s) != string::npos);
       has_kernel_info = has_kernel_info || lines[i].find("Kernel") != string::npos &&
@@ -680,6 +793,49 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
 #endif
 }
 
+TEST(InferenceSessionTests, CheckRunProfilerWithHardwareCounters) {
+  Env::HardwareCounters counters;
+  if (!Env::Default().GetThreadHardwareCounters(counters)) {
+    GTEST_SKIP() << "Hardware counters are not available, perf_event_open may not be permitted.";
+  }
+
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_hardware_counters_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilingHardwareCounters, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  // the kernels run on this thread, whose counters are available
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  bool has_kernel_counters = false;
+  bool has_total_counters = false;
+  while (std::getline(profile, line)) {
+    if (line.find("_kernel_time") != string::npos && line.find("\"hardware_counters\"") != string::npos) {
+      for (const char* counter : {"cycles", "instructions", "llc_misses", "branch_misses"}) {
+        ASSERT_TRUE(line.find(counter) != string::npos) << counter << " is missing from " << line;
+      }
+      has_kernel_counters = true;
+    }
+    has_total_counters = has_total_counters || line.find("Mul_hardware_counters_") != string::npos;
+  }
+
+  ASSERT_TRUE(has_kernel_counters);
+  ASSERT_TRUE(has_total_counters);
+}
+
 TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions2) {
   SessionOptions so;
 
@@ -784,6 +940,143 @@ TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
     count++;
   }
 }
+
+TEST(InferenceSessionTests, CheckRunProfilerStreamingWithSampling) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_streaming_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilingSamplingRate, "2"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilingFlushIntervalMs, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  constexpr int num_runs = 4;
+  for (int i = 0; i < num_runs; ++i) {
+    RunModel(session_object, run_options);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  std::vector<std::string> lines;
+
+  while (std::getline(profile, line)) {
+    lines.push_back(line);
+  }
+
+  auto size = lines.size();
+  ASSERT_TRUE(size > 2);
+  ASSERT_TRUE(lines[0].find("[") != string::npos);
+  ASSERT_TRUE(lines[size - 1].find("]") != string::npos);
+
+  // initialization events are always recorded, runs are sampled
+  int num_model_loading_events = 0;
+  int num_model_run_events = 0;
+  std::vector<std::string> tags = {"pid", "dur", "ts", "ph", "X", "name", "args"};
+  for (size_t i = 1; i < size - 1; ++i) {
+    for (auto& s : tags) {
+      ASSERT_TRUE(lines[i].find(s) != string::npos);
+    }
+    num_model_loading_events += lines[i].find("model_loading_uri") != string::npos;
+    num_model_run_events += lines[i].find("\"model_run\"") != string::npos;
+  }
+
+  ASSERT_EQ(num_model_loading_events, 1);
+  ASSERT_EQ(num_model_run_events, num_runs / 2);
+}
+
+// The nodes of the runs that are not sampled are not recorded either when the parallel executor runs them on other
+// threads than the one calling Run.
+TEST(InferenceSessionTests, CheckRunProfilerSamplingParallel) {
+  constexpr int num_branches = 4;
+  constexpr int num_runs = 4;
+
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}};
+  Model model("profiler_sampling", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(6);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_float);
+  std::vector<NodeArg*> branch_outputs;
+  for (int b = 0; b < num_branches; ++b) {
+    auto& output = graph.GetOrCreateNodeArg("relu_" + std::to_string(b), &tensor_float);
+    graph.AddNode("relu_" + std::to_string(b), "Relu", "", {&x}, {&output});
+    branch_outputs.push_back(&output);
+  }
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("sum", "Sum", "", branch_outputs, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized_model;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized_model));
+
+  SessionOptions so;
+  so.session_logid = "CheckRunProfiler";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = num_branches;
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_sampling_parallel_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilingSamplingRate, "2"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  std::stringstream model_stream(serialized_model);
+  ASSERT_STATUS_OK(session_object.Load(model_stream));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {6},
+                       {-3.0f, -2.0f, -1.0f, 1.0f, 2.0f, 3.0f}, &x_value);
+  NameMLValMap feeds{{"X", x_value}};
+  std::vector<std::string> output_names{"Y"};
+  for (int i = 0; i < num_runs; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+  }
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  int num_kernel_events = 0;
+  int num_model_run_events = 0;
+  while (std::getline(profile, line)) {
+    num_kernel_events += line.find("_kernel_time") != string::npos;
+    num_model_run_events += line.find("\"model_run\"") != string::npos;
+  }
+
+  ASSERT_EQ(num_model_run_events, num_runs / 2);
+  ASSERT_EQ(num_kernel_events, (num_runs / 2) * (num_branches + 1));
+}
+
+TEST(InferenceSessionTests, CheckRunProfilerInvalidOptions) {
+  for (const auto& [key, value] : {std::pair{kOrtSessionOptionsConfigProfilingSamplingRate, "0"},
+                                   std::pair{kOrtSessionOptionsConfigProfilingSamplingRate, "-1"},
+                                   std::pair{kOrtSessionOptionsConfigProfilingFlushIntervalMs, "-1"},
+                                   std::pair{kOrtSessionOptionsConfigProfilingFlushIntervalMs, "10ms"}}) {
+    SessionOptions so;
+    so.session_logid = "CheckRunProfiler";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(key, value));
+
+    InferenceSession session_object(so, GetEnvironment());
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    const auto status = session_object.Initialize();
+    ASSERT_EQ(status.Code(), common::INVALID_ARGUMENT) << key << "=" << value << ": " << status.ErrorMessage();
+    ASSERT_THAT(status.ErrorMessage(), testing::HasSubstr(key));
+  }
+}
 #endif  // __wasm__
 
 TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
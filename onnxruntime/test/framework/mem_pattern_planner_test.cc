@@ -30,10 +30,54 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
 
   pattern = planner.GenerateMemPattern();
 
-  EXPECT_EQ(pattern.PeakSize(), 1024u + 256u + 512u + 1024u + 512u);
-  EXPECT_EQ(pattern.GetBlock(4)->offset_, 1024u + 256u + 512u + 1024u);
-  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
-  EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
+  // placing the blocks in trace order needs 1024 + 256 + 512 + 1024 + 512 bytes.
+  // placing the largest blocks first reaches the lower bound of 0, 2, 3 and 4 alive at the same time.
+  EXPECT_EQ(pattern.PeakSize(), 1024u + 512u + 1024u + 512u);
+  EXPECT_EQ(pattern.LowerBoundSize(), 1024u + 512u + 1024u + 512u);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(3)->offset_, 1024u);
+  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 1024u + 1024u);
+  EXPECT_EQ(pattern.GetBlock(4)->offset_, 1024u + 1024u + 512u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 1024u + 1024u + 512u);
+  EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u + 600u);
+}
+
+TEST(MemPatternPlannerTest, BlocksWithOverlappingLifetimesDoNotOverlap) {
+  constexpr bool using_counters = false;
+  MemPatternPlanner planner{using_counters};
+
+  // a chain of values where each one is released after the next one is produced, with a few long lived values
+  constexpr int num_values = 200;
+  for (int i = 0; i < num_values; ++i) {
+    planner.TraceAllocation(i, 64 * static_cast<size_t>(1 + (i * 7) % 13));
+    if (i > 0 && (i - 1) % 17 != 0) {
+      planner.TraceFree(i - 1);
+    }
+  }
+
+  auto pattern = planner.GenerateMemPattern();
+  EXPECT_GE(pattern.PeakSize(), pattern.LowerBoundSize());
+
+  // replay the trace to check every pair of blocks that are alive at the same time
+  for (int i = 0; i < num_values; ++i) {
+    const auto* block_i = pattern.GetBlock(i);
+    ASSERT_NE(block_i, nullptr);
+    EXPECT_LE(block_i->offset_ + block_i->size_, pattern.PeakSize());
+
+    for (int j = i + 1; j < num_values; ++j) {
+      // i is alive when j is allocated if it is never released or j is the value right after it
+      const bool overlapping_lifetimes = (i % 17 == 0) || (j == i + 1);
+      if (!overlapping_lifetimes) {
+        continue;
+      }
+
+      const auto* block_j = pattern.GetBlock(j);
+      EXPECT_TRUE(block_i->offset_ + block_i->size_ <= block_j->offset_ ||
+                  block_j->offset_ + block_j->size_ <= block_i->offset_)
+          << "blocks of " << i << " and " << j << " overlap";
+    }
+  }
 }
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,10 +3,18 @@
 
 #include "core/framework/data_types.h"
 #include "core/framework/op_kernel.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/inference_session_wrapper.h"
 #include "test_utils.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
 #include "gtest/gtest.h"
 
 using namespace ONNX_NAMESPACE;
@@ -145,5 +153,267 @@ TEST_P(ParallelExecutorThreadPoolTest, TestNullInterOpThreadPool) {
 
 INSTANTIATE_TEST_SUITE_P(ParallelExecutorThreadPoolTests, ParallelExecutorThreadPoolTest,
                          testing::Values(1, 0));
+
+// Y = Sum(branches), each branch doubling X as many times as its depth
+// The tensors have a single dimension of 2, or a symbolic dimension if symbolic_dims is set.
+static void CreateBranchesModel(const std::vector<int>& depths, std::string& serialized_model,
+                                bool symbolic_dims = false) {
+  onnxruntime::Model model("wide_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* dim = float_tensor.mutable_tensor_type()->mutable_shape()->add_dim();
+  if (symbolic_dims) {
+    dim->set_dim_param("N");
+  } else {
+    dim->set_dim_value(2);
+  }
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  std::vector<NodeArg*> branch_outputs;
+  for (size_t branch = 0; branch < depths.size(); ++branch) {
+    NodeArg* previous = &x;
+    for (int i = 0; i < depths[branch]; ++i) {
+      const std::string name = "branch_" + std::to_string(branch) + "_" + std::to_string(i);
+      auto& output = graph.GetOrCreateNodeArg(name, &float_tensor);
+      graph.AddNode(name, "Add", "", {previous, previous}, {&output});
+      previous = &output;
+    }
+    branch_outputs.push_back(previous);
+  }
+
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("sum", "Sum", "", branch_outputs, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  model.ToProto().SerializeToString(&serialized_model);
+}
+
+class DataflowExecutionTest : public testing::TestWithParam<std::tuple<bool, int>> {
+};
+
+TEST_P(DataflowExecutionTest, WideGraph) {
+  const auto [enable_dataflow, thread_pool_size] = GetParam();
+  constexpr int num_branches = 16;
+  constexpr int depth = 3;
+
+  std::string serialized_model;
+  CreateBranchesModel(std::vector<int>(num_branches, depth), serialized_model);
+
+  SessionOptions so;
+  so.session_logid = "DataflowExecutionTest";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.graph_optimization_level = TransformerLevel::Default;
+  so.inter_op_param.thread_pool_size = thread_pool_size;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsEnableDataflowExecution,
+                                                    enable_dataflow ? "1" : "0"));
+
+  InferenceSessionWrapper session{so, GetEnvironment()};
+  std::stringstream model_stream(serialized_model);
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  const auto* plan = session.GetSessionState().GetExecutionPlan();
+  if (!enable_dataflow) {
+    ASSERT_TRUE(plan->dataflow_nodes.empty());
+  } else {
+    ASSERT_EQ(plan->dataflow_nodes.size(), static_cast<size_t>(num_branches * depth + 1));
+    ASSERT_EQ(plan->dataflow_roots.size(), static_cast<size_t>(num_branches));
+  }
+
+  OrtValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {2}, {1.0f, -2.0f}, &x);
+  NameMLValMap feeds{{"X", x}};
+  const std::vector<std::string> output_names{"Y"};
+
+  // run several times, so that the nodes complete in different orders
+  for (int run = 0; run < 10; ++run) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, output_names, &fetches));
+    ASSERT_EQ(fetches.size(), 1u);
+    const auto y = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    constexpr float scale = static_cast<float>(num_branches * (1 << depth));
+    ASSERT_EQ(y[0], scale * 1.0f);
+    ASSERT_EQ(y[1], scale * -2.0f);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(DataflowExecutionTests, DataflowExecutionTest,
+                         testing::Combine(testing::Bool(), testing::Values(1, 4)));
+
+#ifdef ORT_ENABLE_STREAM
+TEST(DataflowExecutionTest, NotUsedWithPartitionConfig) {
+  std::string serialized_model;
+  CreateBranchesModel({1, 1}, serialized_model);
+
+  // each branch on its own logic stream
+  const std::string partition_config_file = "dataflow_partition_config.json";
+  {
+    std::ofstream config(partition_config_file);
+    config << R"({"type":"DeviceBasedPartitioner","streams":[["branch_0_0","sum"],["branch_1_0"]],)"
+           << R"("devices":["0","0"]})";
+  }
+
+  SessionOptions so;
+  so.session_logid = "DataflowExecutionTest";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsEnableDataflowExecution, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kNodePartitionConfigFile, partition_config_file.c_str()));
+
+  InferenceSessionWrapper session{so, GetEnvironment()};
+  std::stringstream model_stream(serialized_model);
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  const auto* plan = session.GetSessionState().GetExecutionPlan();
+  EXPECT_TRUE(plan->dataflow_nodes.empty());
+  EXPECT_EQ(plan->execution_plan.size(), 2u);
+
+  std::remove(partition_config_file.c_str());
+}
+#endif
+
+static const SequentialExecutionPlan* InitializeBranchesModel(InferenceSessionWrapper& session,
+                                                              const std::vector<int>& depths,
+                                                              bool symbolic_dims = false) {
+  std::string serialized_model;
+  CreateBranchesModel(depths, serialized_model, symbolic_dims);
+  std::stringstream model_stream(serialized_model);
+  EXPECT_STATUS_OK(session.Load(model_stream));
+  EXPECT_STATUS_OK(session.Initialize());
+  return session.GetSessionState().GetExecutionPlan();
+}
+
+static const SequentialExecutionPlan::DataflowNode& GetDataflowNode(const InferenceSessionWrapper& session,
+                                                                    const SequentialExecutionPlan& plan,
+                                                                    const std::string& node_name) {
+  const auto& graph = session.GetSessionState().GetGraphViewer();
+  auto it = std::find_if(plan.dataflow_nodes.begin(), plan.dataflow_nodes.end(),
+                         [&](const SequentialExecutionPlan::DataflowNode& dataflow_node) {
+                           return graph.GetNode(dataflow_node.node_index)->Name() == node_name;
+                         });
+  EXPECT_NE(it, plan.dataflow_nodes.end()) << node_name;
+  return *it;
+}
+
+TEST(DataflowExecutionTest, CriticalPathPriority) {
+  SessionOptions so;
+  so.session_logid = "DataflowExecutionTest";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsEnableDataflowExecution, "1"));
+  so.inter_op_param.thread_pool_size = 2;
+  so.intra_op_param.thread_pool_size = 2;
+  InferenceSessionWrapper session{so, GetEnvironment()};
+
+  // the short branch comes first in execution order, but the long branch is on the critical path
+  const auto* plan = InitializeBranchesModel(session, {1, 4});
+  ASSERT_EQ(plan->dataflow_roots.size(), 2u);
+
+  const auto& short_branch = GetDataflowNode(session, *plan, "branch_0_0");
+  const auto& long_branch = GetDataflowNode(session, *plan, "branch_1_0");
+  const auto& sum = GetDataflowNode(session, *plan, "sum");
+  EXPECT_EQ(&plan->dataflow_nodes[plan->dataflow_roots[0]], &long_branch);
+  EXPECT_GT(long_branch.critical_path_cost, short_branch.critical_path_cost);
+  EXPECT_GT(short_branch.critical_path_cost, sum.critical_path_cost);
+
+  EXPECT_FALSE(short_branch.use_intra_op_thread_pool);
+  EXPECT_TRUE(long_branch.use_intra_op_thread_pool);
+  EXPECT_TRUE(GetDataflowNode(session, *plan, "branch_1_3").use_intra_op_thread_pool);
+  EXPECT_TRUE(sum.use_intra_op_thread_pool);
+}
+
+TEST(DataflowExecutionTest, CriticalPathKeepsIntraOpThreads) {
+  SessionOptions so;
+  so.session_logid = "DataflowExecutionTest";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsEnableDataflowExecution, "1"));
+
+  // without an inter-op thread pool the branches don't run concurrently, so no node loses its intra-op threads
+  so.inter_op_param.thread_pool_size = 1;
+  so.intra_op_param.thread_pool_size = 2;
+  {
+    InferenceSessionWrapper session{so, GetEnvironment()};
+    const auto* plan = InitializeBranchesModel(session, {1, 4});
+    ASSERT_EQ(session.GetSessionState().GetInterOpThreadPool(), nullptr);
+    for (const auto& dataflow_node : plan->dataflow_nodes) {
+      EXPECT_TRUE(dataflow_node.use_intra_op_thread_pool);
+    }
+  }
+
+  // the node of the short branch would take longer than the long branch on a single thread instead of 8
+  so.inter_op_param.thread_pool_size = 2;
+  so.intra_op_param.thread_pool_size = 8;
+  {
+    InferenceSessionWrapper session{so, GetEnvironment()};
+    const auto* plan = InitializeBranchesModel(session, {1, 4});
+    EXPECT_TRUE(GetDataflowNode(session, *plan, "branch_0_0").use_intra_op_thread_pool);
+  }
+}
+
+TEST(DataflowExecutionTest, CriticalPathWithSymbolicDims) {
+  SessionOptions so;
+  so.session_logid = "DataflowExecutionTest";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsEnableDataflowExecution, "1"));
+  InferenceSessionWrapper session{so, GetEnvironment()};
+
+  // the estimates still order the long branch first, but without known shapes no node loses its intra-op threads
+  const auto* plan = InitializeBranchesModel(session, {1, 4}, /*symbolic_dims*/ true);
+  const auto& short_branch = GetDataflowNode(session, *plan, "branch_0_0");
+  const auto& long_branch = GetDataflowNode(session, *plan, "branch_1_0");
+  EXPECT_EQ(&plan->dataflow_nodes[plan->dataflow_roots[0]], &long_branch);
+  EXPECT_GT(long_branch.critical_path_cost, short_branch.critical_path_cost);
+  for (const auto& dataflow_node : plan->dataflow_nodes) {
+    EXPECT_TRUE(dataflow_node.use_intra_op_thread_pool);
+  }
+}
+
+TEST(DataflowExecutionTest, CriticalPathFromProfile) {
+  // kernel times of a previous run, in which the node of the short branch was the slowest
+  const std::string profile_file = "dataflow_node_cost_profile.json";
+  {
+    std::ofstream profile(profile_file);
+    profile << "[\n";
+    profile << R"({"cat" : "Session", "pid" : 1, "tid" : 1, "dur" : 5000, "ts" : 0, "ph" : "X", )"
+            << R"("name" : "model_run", "args" : {}},)" << "\n";
+    profile << R"({"cat" : "Node", "pid" : 1, "tid" : 1, "dur" : 1000, "ts" : 0, "ph" : "X", )"
+            << R"("name" : "branch_0_0_kernel_time", "args" : {"op_name" : "Add"}},)" << "\n";
+    for (int i = 0; i < 4; ++i) {
+      profile << R"({"cat" : "Node", "pid" : 1, "tid" : 1, "dur" : 10, "ts" : 0, "ph" : "X", "name" : "branch_1_)"
+              << i << R"(_kernel_time", "args" : {"op_name" : "Add"}},)" << "\n";
+    }
+    profile << R"({"cat" : "Node", "pid" : 1, "tid" : 1, "dur" : 10, "ts" : 0, "ph" : "X", )"
+            << R"("name" : "sum_kernel_time", "args" : {"op_name" : "Sum"}})" << "\n";
+    profile << "]\n";
+  }
+
+  SessionOptions so;
+  so.session_logid = "DataflowExecutionTest";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsEnableDataflowExecution, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsNodeCostProfileFile,
+                                                    profile_file.c_str()));
+  so.inter_op_param.thread_pool_size = 2;
+  so.intra_op_param.thread_pool_size = 2;
+  InferenceSessionWrapper session{so, GetEnvironment()};
+
+  const auto* plan = InitializeBranchesModel(session, {1, 4});
+  const auto& short_branch = GetDataflowNode(session, *plan, "branch_0_0");
+  const auto& long_branch = GetDataflowNode(session, *plan, "branch_1_0");
+  EXPECT_EQ(&plan->dataflow_nodes[plan->dataflow_roots[0]], &short_branch);
+  EXPECT_DOUBLE_EQ(short_branch.critical_path_cost, 1010.0);
+  EXPECT_DOUBLE_EQ(long_branch.critical_path_cost, 50.0);
+  EXPECT_TRUE(short_branch.use_intra_op_thread_pool);
+  EXPECT_FALSE(long_branch.use_intra_op_thread_pool);
+
+  std::remove(profile_file.c_str());
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include <iostream>
+#include <sstream>
+#include <thread>
 #include <absl/base/config.h>
 
 #include "asserts.h"
@@ -17,13 +19,17 @@
 #include "core/graph/model.h"
 #include "core/graph/model_saving_options.h"
 #include "core/graph/op.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/optimizer/initializer.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/thread_utils.h"
 #include "gtest/gtest.h"
+#include "test/framework/test_utils.h"
 #include "test/test_environment.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/file_util.h"
+#include "test/util/include/inference_session_wrapper.h"
 #include "core/optimizer/layout_transformation/layout_transformation.h"
 
 using namespace ONNX_NAMESPACE;
@@ -226,7 +232,8 @@ class SessionStateTestP : public testing::TestWithParam<TestParam> {};
 TEST_P(SessionStateTestP, TestInitializerProcessing) {
   const TestParam& param = GetParam();
   OrtThreadPoolParams to;
-  to.thread_pool_size = to.thread_pool_size;
+  // a single thread deserializes the initializers sequentially, the default uses all cores
+  to.thread_pool_size = param.thread_count;
   auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
 
   std::basic_ostringstream<ORTCHAR_T> oss;
@@ -238,6 +245,12 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
   Graph& graph = model->MainGraph();
   // take a copy as this gets cleared during session state initialization
   InitializedTensorSet initializers = graph.GetAllInitializedTensors();
+  std::unordered_map<std::string, std::vector<uint8_t>> initializer_bytes;
+  for (const auto& entry : initializers) {
+    Initializer initializer(*entry.second, oss.str());
+    const auto bytes = initializer.DataAsByteSpan();
+    initializer_bytes[entry.first].assign(bytes.begin(), bytes.end());
+  }
 
   ExecutionProviders execution_providers;
   CPUExecutionProviderInfo epi{false};
@@ -283,6 +296,14 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
   ASSERT_EQ(initializers.size(), initialized_tensors.size())
       << "SessionState should have an entry for all initializers in Graph.";
 
+  for (const auto& [name, bytes] : initializer_bytes) {
+    int idx;
+    ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx(name, idx));
+    const auto& tensor = initialized_tensors.at(idx).Get<Tensor>();
+    ASSERT_EQ(tensor.SizeInBytes(), bytes.size()) << name;
+    EXPECT_EQ(memcmp(tensor.DataRaw(), bytes.data(), bytes.size()), 0) << "Wrong data for initializer " << name;
+  }
+
   if (param.ir_version < 4) {
     ASSERT_EQ(initialized_tensors.size(), const_initialized_tensors.size())
         << "All initializers should be considered constant if IR version < 4.";
@@ -304,6 +325,145 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
   }
 }
 
+TEST(SessionStateTest, SharedInitializerStore) {
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  const TensorShape shape({1024});
+
+  auto create_value = [&](float fill) {
+    OrtValue value;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), shape, cpu_allocator, value);
+    auto data = value.GetMutable<Tensor>()->MutableDataAsSpan<float>();
+    std::fill(data.begin(), data.end(), fill);
+    return value;
+  };
+
+  OrtValue a = create_value(1.f);
+  OrtValue b = create_value(1.f);
+  OrtValue c = create_value(2.f);
+  ASSERT_TRUE(SharedInitializerStore::CanShare(a));
+
+  // tensors that are small or don't own their buffer are not shared
+  OrtValue small;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({4}), cpu_allocator, small);
+  ASSERT_FALSE(SharedInitializerStore::CanShare(small));
+  OrtValue not_owned;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), shape, a.GetMutable<Tensor>()->MutableDataRaw(),
+                       cpu_allocator->Info(), not_owned);
+  ASSERT_FALSE(SharedInitializerStore::CanShare(not_owned));
+
+  SharedInitializerStore store;
+  SharedInitializerStore::Key key_a, key_b, key_c;
+  bool reused = true;
+
+  OrtValue shared_a = store.Acquire(a, key_a, reused);
+  ASSERT_FALSE(reused);
+  ASSERT_EQ(shared_a.Get<Tensor>().DataRaw(), a.Get<Tensor>().DataRaw());
+
+  // same content as a
+  OrtValue shared_b = store.Acquire(b, key_b, reused);
+  ASSERT_TRUE(reused);
+  ASSERT_EQ(shared_b.Get<Tensor>().DataRaw(), a.Get<Tensor>().DataRaw());
+
+  OrtValue shared_c = store.Acquire(c, key_c, reused);
+  ASSERT_FALSE(reused);
+  ASSERT_EQ(store.GetNumberOfEntries(), 2u);
+
+  store.Release(key_a);
+  ASSERT_EQ(store.GetNumberOfEntries(), 2u);
+  store.Release(key_b);
+  ASSERT_EQ(store.GetNumberOfEntries(), 1u);
+  store.Release(key_c);
+  ASSERT_EQ(store.GetNumberOfEntries(), 0u);
+}
+
+// Two sessions of models with the same constant initializer share its buffer, which is released from the store of the
+// environment when the last of them is destroyed.
+TEST(SessionStateTest, SharedInitializersAcrossSessions) {
+  constexpr int64_t size = 512;
+  static_assert(static_cast<size_t>(size) * sizeof(float) >= SharedInitializerStore::kMinTensorSizeInBytes);
+
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}};
+  Model model("shared_initializers", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(size);
+
+  ONNX_NAMESPACE::TensorProto weight;
+  weight.set_name("W");
+  weight.set_data_type(TensorProto_DataType_FLOAT);
+  weight.add_dims(size);
+  for (int64_t i = 0; i < size; ++i) {
+    weight.add_float_data(static_cast<float>(i));
+  }
+  graph.AddInitializedTensor(weight);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_type);
+  auto& w = graph.GetOrCreateNodeArg("W", &tensor_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_type);
+  graph.AddNode("add", "Add", "", {&x, &w}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized_model;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized_model));
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShareInitializersAcrossSessions, "1"));
+
+  auto create_session = [&]() {
+    auto session = std::make_unique<InferenceSessionWrapper>(so, GetEnvironment());
+    std::stringstream model_stream(serialized_model);
+    ORT_THROW_IF_ERROR(session->Load(model_stream));
+    ORT_THROW_IF_ERROR(session->Initialize());
+    return session;
+  };
+
+  auto get_weight_data = [](const InferenceSessionWrapper& session) -> const void* {
+    const auto& session_state = session.GetSessionState();
+    int idx = -1;
+    ORT_THROW_IF_ERROR(session_state.GetOrtValueNameIdxMap().GetIdx("W", idx));
+    const auto& initializers = session_state.GetInitializedTensors();
+    auto it = initializers.find(idx);
+    ORT_ENFORCE(it != initializers.end(), "W is not an initializer of the session state");
+    return it->second.Get<Tensor>().DataRaw();
+  };
+
+  const auto& store = GetEnvironment().GetSharedInitializerStore();
+  const size_t num_entries = store.GetNumberOfEntries();
+
+  auto session_1 = create_session();
+  ASSERT_EQ(store.GetNumberOfEntries(), num_entries + 1);
+  ASSERT_EQ(session_1->GetSessionState().GetSharedInitializerBytes(), 0u);
+
+  auto session_2 = create_session();
+  ASSERT_EQ(store.GetNumberOfEntries(), num_entries + 1);
+  ASSERT_EQ(session_2->GetSessionState().GetSharedInitializerBytes(), static_cast<size_t>(size) * sizeof(float));
+  ASSERT_EQ(get_weight_data(*session_1), get_weight_data(*session_2));
+
+  // the shared buffer stays valid for the remaining session
+  const void* weight_data = get_weight_data(*session_2);
+  session_1.reset();
+  ASSERT_EQ(store.GetNumberOfEntries(), num_entries + 1);
+  ASSERT_EQ(get_weight_data(*session_2), weight_data);
+
+  std::vector<float> x_values(size, 1.f);
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {size}, x_values, &x_value);
+  NameMLValMap feeds{{"X", x_value}};
+  std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_2->Run(RunOptions{}, feeds, output_names, &fetches));
+  const auto y_values = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  for (int64_t i = 0; i < size; ++i) {
+    ASSERT_EQ(y_values[i], static_cast<float>(i + 1));
+  }
+
+  session_2.reset();
+  ASSERT_EQ(store.GetNumberOfEntries(), num_entries);
+}
+
 // Test that we allocate memory for an initializer from non-arena memory even if we provide an arena-based allocator
 // if the relevant session option config flag is set
 TEST(SessionStateTest, TestInitializerMemoryAllocatedUsingNonArenaMemory) {
@@ -804,6 +964,158 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test1) {
   ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 1);
 }
 
+// Deferred pre-packing = pre-pack on the first execution of the node, once, and keep the initializer
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, DeferredPrePacking) {
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDeferPrepacking] = "1";
+
+  Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              DefaultLoggingManager().DefaultLogger());
+
+  CreateSimpleGraph(model.MainGraph());
+  PlaceAllNodesToCPUEP(model.MainGraph());
+  SessionState session_state(model.MainGraph(),
+                             execution_providers,
+                             tp.get(),
+                             nullptr, /*inter_op_thread_pool*/
+                             dtm,
+                             edlm,
+                             DefaultLoggingManager().DefaultLogger(),
+                             profiler,
+                             sess_options);
+
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                      kernel_registry_manager));
+
+  const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+
+  // Nothing is pre-packed during session initialization
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(0));
+  ASSERT_EQ(kernel->prepack_calls_count, 0);
+
+  ASSERT_STATUS_OK(session_state.PrepackDeferredNodeConstantInputs(0));
+  ASSERT_STATUS_OK(session_state.PrepackDeferredNodeConstantInputs(0));
+
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+  ASSERT_EQ(kernel->prepack_calls_count, 1);
+  ASSERT_EQ(session_state.GetConstantInitializedTensors().size(), static_cast<size_t>(1));
+}
+
+// Deferred pre-packing through InferenceSession::Run. Two independent MatMul nodes with constant weights are
+// pre-packed by the first runs, which are started concurrently so that they race to pre-pack the same nodes.
+class DeferredPrePackingRunTest : public testing::TestWithParam<ExecutionMode> {};
+
+TEST_P(DeferredPrePackingRunTest, PrePackOnFirstRun) {
+  constexpr int64_t K = 16;
+  constexpr int64_t N = 8;
+  constexpr int kNumThreads = 4;
+  if (MlasGemmPackBSize(N, K) == 0) {
+    GTEST_SKIP() << "MLAS does not pre-pack MatMul weights on this platform.";
+  }
+
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}};
+  Model model("deferred_prepacking", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto x_type;
+  x_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(K);
+  TypeProto y_type;
+  y_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  y_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  y_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(N);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &x_type);
+  for (int i = 0; i < 2; ++i) {
+    const std::string suffix = std::to_string(i);
+    // B_i is filled with i + 1 so Y_i = (i + 1) * sum of the row of X
+    ONNX_NAMESPACE::TensorProto weight;
+    weight.set_name("B" + suffix);
+    weight.set_data_type(TensorProto_DataType_FLOAT);
+    weight.add_dims(K);
+    weight.add_dims(N);
+    for (int64_t j = 0; j < K * N; ++j) {
+      weight.add_float_data(static_cast<float>(i + 1));
+    }
+    graph.AddInitializedTensor(weight);
+
+    auto& b = graph.GetOrCreateNodeArg("B" + suffix, nullptr);
+    auto& y = graph.GetOrCreateNodeArg("Y" + suffix, &y_type);
+    graph.AddNode("matmul_" + suffix, "MatMul", "", {&x, &b}, {&y});
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized_model;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized_model));
+
+  SessionOptions so;
+  so.execution_mode = GetParam();
+  so.inter_op_param.thread_pool_size = 2;
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDeferPrepacking, "1"));
+
+  InferenceSessionWrapper session{so, GetEnvironment()};
+  std::stringstream model_stream(serialized_model);
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  const auto& session_state = session.GetSessionState();
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(0));
+
+  std::vector<float> x_values(2 * K);
+  for (int64_t j = 0; j < 2 * K; ++j) {
+    x_values[j] = static_cast<float>(j / K + 1);
+  }
+
+  auto run = [&]() -> Status {
+    OrtValue x_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {2, K}, x_values, &x_value);
+    NameMLValMap feeds{{"X", x_value}};
+    std::vector<std::string> output_names{"Y0", "Y1"};
+    std::vector<OrtValue> fetches;
+    ORT_RETURN_IF_ERROR(session.Run(RunOptions{}, feeds, output_names, &fetches));
+    ORT_RETURN_IF_NOT(fetches.size() == 2, "Unexpected number of outputs");
+    for (int i = 0; i < 2; ++i) {
+      const auto y = fetches[i].Get<Tensor>().DataAsSpan<float>();
+      ORT_RETURN_IF_NOT(y.size() == static_cast<size_t>(2 * N), "Unexpected output size");
+      for (int64_t j = 0; j < 2 * N; ++j) {
+        const float expected = static_cast<float>((i + 1) * (j / N + 1) * K);
+        ORT_RETURN_IF_NOT(y[j] == expected, "Y", i, "[", j, "] is ", y[j], ", expected ", expected);
+      }
+    }
+    return Status::OK();
+  };
+
+  std::vector<Status> statuses(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() { statuses[t] = run(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& status : statuses) {
+    ASSERT_STATUS_OK(status);
+  }
+
+  // each weight is pre-packed once, by whichever run reached its node first
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(2));
+
+  ASSERT_STATUS_OK(run());
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(2));
+}
+
+INSTANTIATE_TEST_SUITE_P(SessionStateTests, DeferredPrePackingRunTest,
+                         testing::Values(ExecutionMode::ORT_SEQUENTIAL, ExecutionMode::ORT_PARALLEL));
+
 // Pre-packing enabled + shared initializers + no pre-packed weights container = no pre-packed weights caching
 TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test2) {
   SessionOptions sess_options;
@@ -284,6 +284,43 @@ TEST(TensorProtoUtilsTest, UnpackTensorWithExternalData) {
   TestUnpackExternalTensor<bool>(TensorProto_DataType_BOOL, model_path);
 }
 
+TEST(TensorProtoUtilsTest, ReadaheadExternalData) {
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  FILE* fp;
+  CreateTestFile(fp, filename);
+  ScopedFileDeleter file_deleter(filename);
+  const std::vector<float> data(64, 1.f);
+  ASSERT_EQ(data.size(), fwrite(data.data(), sizeof(float), data.size(), fp));
+  ASSERT_EQ(0, fclose(fp));
+
+  // two adjacent tensors and one further away, listed out of file order
+  std::vector<TensorProto> tensor_protos(3);
+  const int64_t offsets[] = {128, 0, 16};
+  for (size_t i = 0; i < tensor_protos.size(); ++i) {
+    tensor_protos[i].add_dims(4);
+    tensor_protos[i].set_data_type(TensorProto_DataType_FLOAT);
+    ExternalDataInfo::SetExternalLocationToProto(filename, offsets[i], 4 * sizeof(float), tensor_protos[i]);
+  }
+
+  std::vector<const TensorProto*> tensor_proto_ptrs;
+  for (const auto& tensor_proto : tensor_protos) {
+    tensor_proto_ptrs.push_back(&tensor_proto);
+  }
+
+  ExternalDataReadaheadStats stats;
+  ASSERT_STATUS_OK(utils::ReadaheadExternalData(Env::Default(), std::filesystem::path(), tensor_proto_ptrs, 0, stats));
+  EXPECT_EQ(stats.num_files, size_t(1));
+  EXPECT_EQ(stats.num_ranges, size_t(2));
+  EXPECT_EQ(stats.num_bytes, size_t(48));
+
+  // the gap between the ranges is small enough to be read too
+  stats = {};
+  ASSERT_STATUS_OK(utils::ReadaheadExternalData(Env::Default(), std::filesystem::path(), tensor_proto_ptrs, 96, stats));
+  EXPECT_EQ(stats.num_files, size_t(1));
+  EXPECT_EQ(stats.num_ranges, size_t(1));
+  EXPECT_EQ(stats.num_bytes, size_t(144));
+}
+
 template <typename T>
 static NodeProto CreateConstantNode(const std::string& attrib_name, AttributeProto_AttributeType type,
                                     std::function<void(AttributeProto&)> add_data) {
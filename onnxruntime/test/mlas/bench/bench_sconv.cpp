@@ -6,6 +6,7 @@
 
 #include <stdexcept>
 #include <numeric>
+#include <string>
 
 static std::vector<std::string> BuildArgNamesForConv(size_t rank) {
   std::vector<std::string> names = {"Rank", "N", "G", "Cpg", "Fpg"};
@@ -38,8 +39,9 @@ static const std::vector<std::string>& ArgNamesForConv(size_t rank) {
   return rank_to_args_name[rank];
 }
 
-// dummy for some strange build error when using Bench capture
-void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
+// algorithm is "" to let MlasConvPrepare choose, or "winograd" to force the Winograd algorithm on
+// a prepacked filter, so that the algorithms can be compared on the same shapes.
+void SCONV_NCHW(benchmark::State& state, const char* algorithm) {
   const int64_t rank = state.range(0);                       // Rank
   const int64_t batch_size = state.range(1);                 // N
   const int64_t groups = state.range(2);                     // G
@@ -91,6 +93,15 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
   std::vector<int64_t> y_shape = {batch_size, GF};
   y_shape.insert(y_shape.end(), output_shape.begin(), output_shape.end());
 
+  const bool use_winograd = std::string(algorithm) == "winograd";
+  if (use_winograd && !MlasConvWinogradIsSupported(static_cast<size_t>(rank),
+                                                   static_cast<size_t>(input_channels_per_group),
+                                                   static_cast<size_t>(output_channels_per_group),
+                                                   kernel_shape.data(), dilations.data(), strides.data())) {
+    state.SkipWithError("Winograd is not supported for this convolution");
+    return;
+  }
+
   MLAS_ACTIVATION activation;
   activation.ActivationKind = MlasIdentityActivation;
   MLAS_CONV_PARAMETERS Parameters;
@@ -110,10 +121,22 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
                   &activation,
                   &WorkingBufferSize,
                   0.0f,
-                  nullptr);
+                  nullptr,
+                  use_winograd);
 
   auto X = RandomVectorUniform(x_shape, -2.0, 2.0);
   auto F = RandomVectorUniform(f_shape, -1.0, 1.0);
+  if (use_winograd) {
+    std::vector<float> packed_filter(MlasConvWinogradPackFilterSize(static_cast<size_t>(groups),
+                                                                    static_cast<size_t>(input_channels_per_group),
+                                                                    static_cast<size_t>(output_channels_per_group)));
+    MlasConvWinogradPackFilter(static_cast<size_t>(groups),
+                               static_cast<size_t>(input_channels_per_group),
+                               static_cast<size_t>(output_channels_per_group),
+                               F.data(),
+                               packed_filter.data());
+    F = std::move(packed_filter);
+  }
   int64_t y_size = std::accumulate(y_shape.begin(), y_shape.end(), 1LL, std::multiplies<int64_t>());
   std::vector<float> Y(static_cast<size_t>(y_size));
   std::vector<float> working_buffer(WorkingBufferSize);
@@ -200,6 +223,20 @@ static void ResNet50(benchmark::internal::Benchmark* b) {
 
 BENCHMARK_CAPTURE(SCONV_NCHW, ResNet50, "")->Apply(ResNet50)->UseRealTime();
 
+static void ResNet50_3x3(benchmark::internal::Benchmark* b) {
+  b->ArgNames(ArgNamesForConv(2));
+
+  // The 3x3 stride 1 convolutions of ResNet50, which are eligible for the Winograd algorithm.
+  //    Rank, N, G,Cpg,Fpg,  I,   , K, , P, , , , S, , D, ,
+  b->Args({2, 1, 1, 64, 64, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 128, 128, 28, 28, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 256, 256, 14, 14, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+  b->Args({2, 1, 1, 512, 512, 7, 7, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});
+}
+
+BENCHMARK_CAPTURE(SCONV_NCHW, ResNet50_3x3, "")->Apply(ResNet50_3x3)->UseRealTime();
+BENCHMARK_CAPTURE(SCONV_NCHW, ResNet50_3x3_Winograd, "winograd")->Apply(ResNet50_3x3)->UseRealTime();
+
 static void TeamsModel(benchmark::internal::Benchmark* b) {
   b->ArgNames(ArgNamesForConv(2));
   //    Rank, N, G, Cpg, Fpg,  I,   , K, , P, , , , S, , D, ,
@@ -140,6 +140,8 @@ class Conv2dShortExecuteTest : public MlasTestFixture<Conv2dTester> {
       test_registered += RegisterSingleTest(1, 16, 1, i, i, 1, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
       test_registered += RegisterSingleTest(1, 16, 1, i, i, 1, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2);
     }
+    // More filters than outputs and a large K, which expands the input in slices of K.
+    test_registered += RegisterSingleTest(1, 1, 1024, 7, 7, 64, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
     return test_registered;
   }
 
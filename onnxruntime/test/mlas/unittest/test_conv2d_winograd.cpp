@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferWorking;
+
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t BatchCount,
+            size_t GroupCount,
+            size_t InputChannels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t FilterCount,
+            size_t Padding,
+            float Beta) {
+    const size_t OutputHeight = InputHeight + 2 * Padding - 2;
+    const size_t OutputWidth = InputWidth + 2 * Padding - 2;
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t PaddingShape[] = {int64_t(Padding), int64_t(Padding), int64_t(Padding), int64_t(Padding)};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    ASSERT_TRUE(MlasConvWinogradIsSupported(2, InputChannels, FilterCount, KernelShape, DilationShape, StrideShape));
+
+    const size_t InputElements = BatchCount * GroupCount * InputChannels * InputHeight * InputWidth;
+    const size_t FilterElements = GroupCount * FilterCount * InputChannels * 9;
+    const size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputHeight * OutputWidth;
+
+    const float* Input = BufferInput.GetBuffer(InputElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterElements);
+    const float* Bias = BufferBias.GetBuffer(GroupCount * FilterCount);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+    const size_t PackedFilterSize = MlasConvWinogradPackFilterSize(GroupCount, InputChannels, FilterCount);
+    float* PackedFilter = BufferPackedFilter.GetBuffer(PackedFilterSize);
+    MlasConvWinogradPackFilter(GroupCount, InputChannels, FilterCount, Filter, PackedFilter);
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasReluActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters, 2, BatchCount, GroupCount, InputChannels, InputShape, KernelShape,
+                    DilationShape, PaddingShape, StrideShape, OutputShape, FilterCount, &Activation,
+                    &WorkingBufferSize, Beta, threadpool_, true);
+    ASSERT_EQ(Parameters.Algorithm, MlasConvAlgorithmWinograd);
+
+    MlasConv(&Parameters, Input, PackedFilter, Bias, BufferWorking.GetBuffer(WorkingBufferSize),
+             Output, threadpool_);
+
+    MlasConvPrepare(&Parameters, 2, BatchCount, GroupCount, InputChannels, InputShape, KernelShape,
+                    DilationShape, PaddingShape, StrideShape, OutputShape, FilterCount, &Activation,
+                    &WorkingBufferSize, Beta, threadpool_);
+    ASSERT_NE(Parameters.Algorithm, MlasConvAlgorithmWinograd);
+
+    MlasConv(&Parameters, Input, Filter, Bias, BufferWorking.GetBuffer(WorkingBufferSize),
+             OutputReference, threadpool_);
+
+    constexpr float epsilon = 1e-5f;
+
+    for (size_t n = 0; n < OutputElements; n++) {
+      const float diff = std::fabs(Output[n] - OutputReference[n]);
+      ASSERT_LE(diff, epsilon * std::max(1.0f, std::fabs(OutputReference[n])))
+          << " @" << n << " B" << BatchCount << "/G" << GroupCount << "/Cpg" << InputChannels
+          << "/Fpg" << FilterCount << "/H" << InputHeight << "/W" << InputWidth << "/Pad" << Padding
+          << "/Beta" << Beta << ", got:" << Output[n] << ", expecting:" << OutputReference[n];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Conv2dWinograd_Threaded" : "Conv2dWinograd_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasConv2DWinogradTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (size_t i = 3; i < 40; i += 3) {
+      for (size_t padding = 0; padding <= 2; padding++) {
+        Test(1, 1, 16, i, i + 1, 16, padding, 0.0f);
+        Test(2, 1, 17, i + 1, i, 32, padding, 1.0f);
+      }
+    }
+    Test(1, 2, 16, 28, 28, 24, 1, 0.0f);
+    Test(1, 1, 64, 56, 56, 64, 1, 0.0f);
+    Test(3, 1, 32, 7, 130, 16, 1, 0.0f);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
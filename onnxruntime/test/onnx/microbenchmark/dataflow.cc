@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <core/session/onnxruntime_session_options_config_keys.h>
+#include <core/session/ort_env.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+using namespace onnxruntime;
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+// Creates a model with independent branches of Add and Relu nodes over a small tensor, combined by a final Sum.
+// The nodes are cheap so the run time is dominated by how the executor dispatches them.
+static std::string CreateWideModel(int64_t num_branches, int64_t depth, int64_t size) {
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}};
+  Model model("wide", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+              {}, *logger);
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(size);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_float);
+  std::vector<NodeArg*> branch_outputs;
+  for (int64_t b = 0; b < num_branches; ++b) {
+    NodeArg* prev = &x;
+    for (int64_t d = 0; d < depth; ++d) {
+      const std::string name = "b" + std::to_string(b) + "_" + std::to_string(d);
+      auto& output = graph.GetOrCreateNodeArg(name, &tensor_float);
+      if (d % 2 == 0) {
+        graph.AddNode(name, "Add", "", {prev, prev}, {&output});
+      } else {
+        graph.AddNode(name, "Relu", "", {prev}, {&output});
+      }
+      prev = &output;
+    }
+    branch_outputs.push_back(prev);
+  }
+
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("sum", "Sum", "", branch_outputs, {&y});
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+  return serialized;
+}
+
+// Writes a partition config that puts each branch of the model created by CreateWideModel on its own logic stream,
+// so that parallel execution without dataflow scheduling runs the branches concurrently.
+static std::string WritePartitionConfig(int64_t num_branches, int64_t depth) {
+  std::string config = R"({"type":"DeviceBasedPartitioner","streams":[)";
+  std::string devices;
+  for (int64_t b = 0; b < num_branches; ++b) {
+    config += b == 0 ? "[\"sum\"," : ",[";
+    for (int64_t d = 0; d < depth; ++d) {
+      config += (d == 0 ? "\"b" : ",\"b") + std::to_string(b) + "_" + std::to_string(d) + "\"";
+    }
+    config += "]";
+    devices += b == 0 ? "\"0\"" : ",\"0\"";
+  }
+  config += R"(],"devices":[)" + devices + "]}";
+
+  const std::string config_file = "dataflow_partition_" + std::to_string(num_branches) + "_" +
+                                  std::to_string(depth) + ".json";
+  std::ofstream config_stream(config_file);
+  config_stream << config;
+  return config_file;
+}
+
+// state.range(0): number of branches, state.range(1): depth of each branch,
+// state.range(2): 0 for sequential execution, 1 for parallel execution without dataflow scheduling, 2 for dataflow
+static void BM_DataflowExecution(benchmark::State& state) {
+  const int64_t num_branches = state.range(0);
+  const int64_t depth = state.range(1);
+  const int64_t mode = state.range(2);
+  constexpr int64_t size = 64;
+
+  const std::string model_data = CreateWideModel(num_branches, depth, size);
+
+  OrtSessionOptions* session_options;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_BREAK_ON_ERROR(g_ort->SetSessionExecutionMode(session_options, mode == 0 ? ORT_SEQUENTIAL : ORT_PARALLEL));
+  ORT_BREAK_ON_ERROR(g_ort->SetInterOpNumThreads(session_options, 4));
+  ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, 1));
+  ORT_BREAK_ON_ERROR(g_ort->AddSessionConfigEntry(session_options, kOrtSessionOptionsEnableDataflowExecution,
+                                                  mode == 2 ? "1" : "0"));
+  // without dataflow scheduling, the nodes of different logic streams are the only ones run in parallel
+  std::string partition_config_file;
+  if (mode == 1) {
+    partition_config_file = WritePartitionConfig(num_branches, depth);
+    ORT_BREAK_ON_ERROR(g_ort->AddSessionConfigEntry(session_options, kNodePartitionConfigFile,
+                                                    partition_config_file.c_str()));
+  }
+
+  OrtSession* session;
+  OrtStatus* create_status = g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(),
+                                                           session_options, &session);
+  g_ort->ReleaseSessionOptions(session_options);
+  if (!partition_config_file.empty()) {
+    std::remove(partition_config_file.c_str());
+  }
+  ORT_BREAK_ON_ERROR(create_status);
+
+  OrtMemoryInfo* memory_info;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  std::vector<float> input_data(size, 1.0f);
+  const int64_t shape[] = {size};
+  OrtValue* input;
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, input_data.data(),
+                                                           input_data.size() * sizeof(float), shape, 1,
+                                                           ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &input));
+  g_ort->ReleaseMemoryInfo(memory_info);
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  for (auto _ : state) {
+    OrtValue* output = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, &input, 1, output_names, 1, &output));
+    g_ort->ReleaseValue(output);
+  }
+
+  g_ort->ReleaseValue(input);
+  g_ort->ReleaseSession(session);
+}
+
+BENCHMARK(BM_DataflowExecution)
+    ->UseRealTime()
+    ->ArgNames({"branches", "depth", "mode"})
+    ->ArgsProduct({{1, 4, 16}, {16, 64}, {0, 1, 2}});
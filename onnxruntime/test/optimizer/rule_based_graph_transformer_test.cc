@@ -20,6 +20,29 @@ using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 namespace test {
 
+namespace {
+// Graph transformer that reports the graph as modified or not according to a script, and counts its invocations.
+class ScriptedGraphTransformer : public GraphTransformer {
+ public:
+  ScriptedGraphTransformer(const std::string& name, std::vector<bool> modified_script) noexcept
+      : GraphTransformer(name), modified_script_(std::move(modified_script)) {}
+
+  size_t NumInvocations() const {
+    return num_invocations_;
+  }
+
+ private:
+  std::vector<bool> modified_script_;
+  mutable size_t num_invocations_ = 0;
+
+  Status ApplyImpl(Graph& /*graph*/, bool& modified, int /*graph_level*/, const logging::Logger&) const override {
+    modified = num_invocations_ < modified_script_.size() && modified_script_[num_invocations_];
+    ++num_invocations_;
+    return Status::OK();
+  }
+};
+}  // namespace
+
 TEST(RuleBasedGraphTransformerTest, TestCompatibleProviders) {
   auto model_uri = ORT_TSTR("testdata/transform/fusion/fuse-conv-bn-mul-add-unsqueeze.onnx");
 
@@ -71,5 +94,32 @@ TEST(RuleBasedGraphTransformerTest, TestSettingStepsInGraphTransformerManager) {
   ASSERT_STATUS_OK(graph_transformation_mgr.GetSteps(steps_queried));
   ASSERT_EQ(steps_queried, static_cast<unsigned>(10));
 }
+
+TEST(RuleBasedGraphTransformerTest, TestSkippingUnmodifyingTransformersInGraphTransformerManager) {
+  auto model_uri = ORT_TSTR("testdata/transform/fusion/fuse-conv-bn-mul-add-unsqueeze.onnx");
+
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, DefaultLoggingManager().DefaultLogger()));
+  Graph& graph = model->MainGraph();
+
+  // step 0: first does not modify the graph, second does.
+  // step 1: first runs again since the graph was modified after it ran, and modifies it. second runs as well.
+  // step 2: first runs and does not modify the graph. second is skipped as nothing modified the graph since it
+  //         last ran without modifying it, and the transformers reached a fixed point.
+  auto first = std::make_unique<ScriptedGraphTransformer>("First", std::vector<bool>{false, true, false});
+  auto second = std::make_unique<ScriptedGraphTransformer>("Second", std::vector<bool>{true, false});
+  const auto* first_ptr = first.get();
+  const auto* second_ptr = second.get();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(first), TransformerLevel::Level2));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(second), TransformerLevel::Level2));
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  ASSERT_EQ(first_ptr->NumInvocations(), size_t{3});
+  ASSERT_EQ(second_ptr->NumInvocations(), size_t{2});
+}
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
@@ -39,6 +39,12 @@ namespace perftest {
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding. Free dimensions are treated as 1 unless overridden using -f.\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-Q [requests_per_second]: Run in open-loop mode, issuing requests at the given rate independently of the\n"
+      "\t\tcompletion of previous requests, and measure latency from the intended send time of each request.\n"
+      "\t\tRequests are served by up to [parallel runs] threads and use the test data sets in a random order.\n"
+      "\t\tThe run lasts for [seconds_to_run] in 'duration' mode or issues [repeated_times] requests in 'times' mode.\n"
+      "\t-a [constant|poisson]: Specifies the arrival process of the requests in open-loop mode. Default:'poisson'.\n"
+      "\t-H [histogram_file]: Write the latency percentile distribution to the file in the HdrHistogram format.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|dml|acl|nnapi|coreml|qnn|snpe|rocm|migraphx|xnnpack|vitisai|webgpu]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'openvino', 'dml', 'acl', 'nnapi', 'coreml', 'qnn', 'snpe', 'rocm', 'migraphx', 'xnnpack', 'vitisai' or 'webgpu'. "
       "Default:'cpu'.\n"
@@ -186,7 +192,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:AMPIDZvhsqznlR:"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:Q:a:H:AMPIDZvhsqznlR:"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -311,6 +317,29 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
           return false;
         }
         break;
+      case 'Q':
+        ORT_TRY {
+          test_config.run_config.open_loop_qps = std::stod(ToUTF8String(optarg));
+        }
+        ORT_CATCH(...) {
+          return false;
+        }
+        if (!(test_config.run_config.open_loop_qps > 0)) {
+          return false;
+        }
+        break;
+      case 'a':
+        if (!CompareCString(optarg, ORT_TSTR("constant"))) {
+          test_config.run_config.arrival_process = ArrivalProcess::kConstant;
+        } else if (!CompareCString(optarg, ORT_TSTR("poisson"))) {
+          test_config.run_config.arrival_process = ArrivalProcess::kPoisson;
+        } else {
+          return false;
+        }
+        break;
+      case 'H':
+        test_config.run_config.latency_histogram_file = optarg;
+        break;
       case 'o': {
         int tmp = static_cast<int>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
         switch (tmp) {
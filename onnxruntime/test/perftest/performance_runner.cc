@@ -7,7 +7,10 @@
 #endif
 
 #include "performance_runner.h"
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
 #include "utils.h"
@@ -111,6 +114,69 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
   }
 }
 
+void PerformanceResult::DumpPercentileDistribution(const std::basic_string<ORTCHAR_T>& path) const {
+  std::ofstream outfile(path, std::ofstream::out | std::ofstream::trunc);
+  if (!outfile.good()) {
+    std::cerr << "failed to open histogram file '" << ToUTF8String(path.c_str()) << "'.\n";
+    return;
+  }
+
+  if (time_costs.empty()) {
+    return;
+  }
+
+  std::vector<double> sorted_time = time_costs;
+  std::sort(sorted_time.begin(), sorted_time.end());
+  const size_t total = sorted_time.size();
+
+  // match the output of HdrHistogram's outputPercentileDistribution() with 5 ticks per half distance so the
+  // HdrHistogram tools can plot and compare the results
+  constexpr int kTicksPerHalfDistance = 5;
+  outfile << std::setw(12) << "Value" << " " << std::setw(14) << "Percentile" << " " << std::setw(10) << "TotalCount"
+          << " " << std::setw(14) << "1/(1-Percentile)" << "\n\n";
+
+  double percentile = 0.0;
+  while (true) {
+    size_t count = std::clamp<size_t>(static_cast<size_t>(std::ceil(percentile / 100.0 * total)), 1, total);
+    // a value is reported with the count of all the samples up to and including it
+    count = static_cast<size_t>(std::upper_bound(sorted_time.begin(), sorted_time.end(), sorted_time[count - 1]) -
+                                sorted_time.begin());
+    const double value = sorted_time[count - 1] * 1000;
+
+    if (count == total) {
+      outfile << std::fixed << std::setprecision(3) << std::setw(12) << value << " " << std::setprecision(12)
+              << 1.0 << " " << std::setw(10) << count << "\n";
+      break;
+    }
+
+    const double fraction = percentile / 100.0;
+    outfile << std::fixed << std::setprecision(3) << std::setw(12) << value << " " << std::setprecision(12)
+            << fraction << " " << std::setw(10) << count << " " << std::setprecision(2) << std::setw(14)
+            << 1.0 / (1.0 - fraction) << "\n";
+
+    const double half_distance = std::pow(2.0, std::floor(std::log2(100.0 / (100.0 - percentile))) + 1);
+    percentile += 100.0 / (kTicksPerHalfDistance * half_distance);
+  }
+
+  double mean = 0.0;
+  for (double time : sorted_time) {
+    mean += time;
+  }
+  mean /= total;
+
+  double variance = 0.0;
+  for (double time : sorted_time) {
+    variance += (time - mean) * (time - mean);
+  }
+  variance /= total;
+
+  outfile << std::fixed << std::setprecision(3)
+          << "#[Mean    = " << std::setw(12) << mean * 1000 << ", StdDeviation   = " << std::setw(12)
+          << std::sqrt(variance) * 1000 << "]\n"
+          << "#[Max     = " << std::setw(12) << sorted_time.back() * 1000 << ", Total count    = " << std::setw(12)
+          << total << "]" << std::endl;
+}
+
 void PerformanceRunner::LogSessionCreationTime() {
   std::chrono::duration<double> session_create_duration = session_create_end_ - session_create_start_;
   std::cout << "\nSession creation time cost: " << session_create_duration.count() << " s\n";
@@ -131,15 +197,19 @@ Status PerformanceRunner::Run() {
   performance_result_.start = std::chrono::high_resolution_clock::now();
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(FixDurationTest());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RepeatedTimesTest());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  if (performance_test_config_.run_config.open_loop_qps > 0) {
+    ORT_RETURN_IF_ERROR(RunOpenLoop());
+  } else {
+    switch (performance_test_config_.run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(FixDurationTest());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RepeatedTimesTest());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
   }
   performance_result_.end = std::chrono::high_resolution_clock::now();
 
@@ -165,6 +235,19 @@ Status PerformanceRunner::Run() {
             << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
             << std::endl;
 
+  if (performance_test_config_.run_config.open_loop_qps > 0) {
+    // in open-loop mode the latency statistics are measured from the intended send time of the requests
+    std::cout << "Target requests per second: " << performance_test_config_.run_config.open_loop_qps << "\n"
+              << "Average queueing delay: ";
+    // no request may complete when the duration is shorter than the interval between the requests
+    if (performance_result_.time_costs.empty()) {
+      std::cout << "n/a";
+    } else {
+      std::cout << performance_result_.total_queueing_delay / performance_result_.time_costs.size() * 1000 << " ms";
+    }
+    std::cout << std::endl;
+  }
+
   return Status::OK();
 }
 
@@ -255,6 +338,90 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::RunOpenLoop() {
+  using Clock = std::chrono::steady_clock;
+  const auto& run_config = performance_test_config_.run_config;
+
+  // generate the intended send times of all the requests up front so the schedule doesn't depend on how quickly
+  // the requests are served. a request that can't start on time waits for a thread and the wait counts towards its
+  // latency, which avoids the coordinated omission of the closed-loop modes.
+  std::random_device rd;
+  std::mt19937 rand_engine(run_config.random_seed_for_input_data >= 0
+                               ? static_cast<std::mt19937::result_type>(run_config.random_seed_for_input_data)
+                               : rd());
+  std::exponential_distribution<double> inter_arrival_dist(run_config.open_loop_qps);
+  const bool fixed_count = run_config.test_mode == TestMode::KFixRepeatedTimesMode;
+
+  std::vector<Clock::duration> send_offsets;
+  double send_offset = 0.0;
+  while (fixed_count ? send_offsets.size() < run_config.repeated_times
+                     : send_offset < static_cast<double>(run_config.duration_in_seconds)) {
+    send_offsets.push_back(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(send_offset)));
+    send_offset += run_config.arrival_process == ArrivalProcess::kPoisson ? inter_arrival_dist(rand_engine)
+                                                                          : 1.0 / run_config.open_loop_qps;
+  }
+
+  // create a threadpool with one thread per concurrent request
+  auto tpool = std::make_unique<DefaultThreadPoolType>(run_config.concurrent_session_runs);
+  std::atomic<size_t> next_request{0};
+  std::atomic<int> counter{0};
+  std::mutex m;
+  std::condition_variable cv;
+  const auto start = Clock::now();
+
+  // Fork
+  for (size_t i = 0; i != run_config.concurrent_session_runs; ++i) {
+    counter++;
+    tpool->Schedule([this, &send_offsets, &next_request, &counter, &m, &cv, &run_config, start]() {
+      for (size_t request = next_request++; request < send_offsets.size(); request = next_request++) {
+        const auto intended_start = start + send_offsets[request];
+        std::this_thread::sleep_until(intended_start);
+        const auto actual_start = Clock::now();
+
+        std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
+        bool succeeded = true;
+        ORT_TRY {
+          duration_seconds = session_->Run();
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            std::cerr << "PerformanceRunner::RunOpenLoop caught exception: " << ex.what() << std::endl;
+            succeeded = false;
+          });
+        }
+
+        if (!succeeded) {
+          continue;
+        }
+
+        const std::chrono::duration<double> latency = Clock::now() - intended_start;
+        const std::chrono::duration<double> queueing_delay = actual_start - intended_start;
+
+        std::lock_guard<std::mutex> guard(results_mutex_);
+        performance_result_.time_costs.emplace_back(latency.count());
+        performance_result_.total_time_cost += duration_seconds.count();
+        performance_result_.total_queueing_delay += queueing_delay.count();
+        if (run_config.f_verbose) {
+          std::cout << "iteration:" << performance_result_.time_costs.size() << ","
+                    << "latency:" << latency.count() << ","
+                    << "time_cost:" << duration_seconds.count() << std::endl;
+        }
+      }
+
+      // Simplified version of Eigen::Barrier
+      std::lock_guard<std::mutex> lg(m);
+      counter--;
+      cv.notify_all();
+    });
+  }
+
+  // Join
+  std::unique_lock<std::mutex> lock(m);
+  cv.wait(lock, [&counter]() { return counter == 0; });
+
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   const auto& file_path = performance_test_config_.model_info.model_file_path;
 #if !defined(ORT_MINIMAL_BUILD)
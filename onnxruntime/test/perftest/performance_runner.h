@@ -34,9 +34,14 @@ struct PerformanceResult {
   short average_CPU_usage{0};
   double total_time_cost{0};
   std::vector<double> time_costs;
+  // open-loop mode only. sum of the time requests waited for a thread after their intended send time
+  double total_queueing_delay{0};
   std::string model_name;
 
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
+
+  // Writes the distribution of time_costs in the percentile distribution format of HdrHistogram, in milliseconds.
+  void DumpPercentileDistribution(const std::basic_string<ORTCHAR_T>& path) const;
 };
 
 class PerformanceRunner {
@@ -53,6 +58,9 @@ class PerformanceRunner {
   inline void SerializeResult() const {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
+    if (!performance_test_config_.run_config.latency_histogram_file.empty()) {
+      performance_result_.DumpPercentileDistribution(performance_test_config_.run_config.latency_histogram_file);
+    }
   }
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerformanceRunner);
 
@@ -90,6 +98,7 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status RunOpenLoop();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -19,6 +19,12 @@ enum class TestMode : std::uint8_t {
   KFixRepeatedTimesMode
 };
 
+// Arrival process of the requests in open-loop mode
+enum class ArrivalProcess : std::uint8_t {
+  kConstant = 0,
+  kPoisson
+};
+
 enum class Platform : std::uint8_t {
   kWindows = 0,
   kLinux
@@ -43,6 +49,11 @@ struct RunConfig {
   size_t repeated_times{1000};
   size_t duration_in_seconds{600};
   size_t concurrent_session_runs{1};
+  // Target request rate of open-loop mode. Requests are issued on a fixed schedule independent of the completion of
+  // previous requests and their latency is measured from their intended send time. 0 runs requests back-to-back.
+  double open_loop_qps{0};
+  ArrivalProcess arrival_process{ArrivalProcess::kPoisson};
+  std::basic_string<ORTCHAR_T> latency_histogram_file;
   bool f_dump_statistics{false};
   int random_seed_for_input_data{-1};
   bool f_verbose{false};
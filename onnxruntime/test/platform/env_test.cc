@@ -3,7 +3,9 @@
 
 #include "core/platform/env.h"
 
+#include <cstring>
 #include <fstream>
+#include <memory>
 
 #include "gtest/gtest.h"
 
@@ -53,5 +55,41 @@ TEST(PlatformEnvTest, GetErrnoInfo) {
 #pragma warning(pop)
 #endif
 }
+
+#if defined(__linux__)
+TEST(PlatformEnvTest, GetPageFaultCounts) {
+  const auto& env = Env::Default();
+  const auto before = env.GetPageFaultCounts();
+
+  // touching fresh anonymous memory faults its pages in
+  constexpr size_t length = 16 * 1024 * 1024;
+  auto buffer = std::make_unique<char[]>(length);
+  std::memset(buffer.get(), 1, length);
+  ASSERT_EQ(buffer[length - 1], 1);
+
+  const auto after = env.GetPageFaultCounts();
+  ASSERT_GT(after.minor, before.minor);
+}
+
+TEST(PlatformEnvTest, GetThreadHardwareCounters) {
+  const auto& env = Env::Default();
+  Env::HardwareCounters before;
+  if (!env.GetThreadHardwareCounters(before)) {
+    GTEST_SKIP() << "Hardware counters are not available, perf_event_open may not be permitted.";
+  }
+
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < 1000 * 1000; ++i) {
+    sum += i;
+  }
+
+  Env::HardwareCounters after;
+  ASSERT_TRUE(env.GetThreadHardwareCounters(after));
+  ASSERT_GT(after.instructions, before.instructions + 1000 * 1000);
+  ASSERT_GT(after.cycles, before.cycles);
+  ASSERT_GT(after.time_enabled, before.time_enabled);
+  ASSERT_GE(after.time_enabled, after.time_running);
+}
+#endif
 }  // namespace test
 }  // namespace onnxruntime
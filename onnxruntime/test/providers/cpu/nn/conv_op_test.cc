@@ -1,8 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "core/graph/constants.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/asserts.h"
 
 using namespace std;
 namespace onnxruntime {
@@ -992,5 +994,59 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// 3x3 stride 1 convolution with enough channels and a constant filter to use the Winograd algorithm on CPU.
+TEST(ConvTest, Conv2D_Winograd) {
+  constexpr int64_t C = 16, M = 24, H = 7, W = 10;
+  vector<float> X(C * H * W);
+  vector<float> W_data(M * C * 3 * 3);
+  vector<float> B(M);
+  for (size_t i = 0; i < X.size(); i++) X[i] = static_cast<float>((i * 7) % 13) / 13.0f - 0.5f;
+  for (size_t i = 0; i < W_data.size(); i++) W_data[i] = static_cast<float>((i * 5) % 11) / 11.0f - 0.5f;
+  for (size_t i = 0; i < B.size(); i++) B[i] = static_cast<float>(i) / 10.0f;
+
+  // pads of 1 on every edge keep the output the size of the input
+  vector<float> Y(M * H * W);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t oh = 0; oh < H; oh++) {
+      for (int64_t ow = 0; ow < W; ow++) {
+        float sum = B[m];
+        for (int64_t c = 0; c < C; c++) {
+          for (int64_t kh = 0; kh < 3; kh++) {
+            for (int64_t kw = 0; kw < 3; kw++) {
+              const int64_t ih = oh + kh - 1;
+              const int64_t iw = ow + kw - 1;
+              if (ih >= 0 && ih < H && iw >= 0 && iw < W) {
+                sum += X[(c * H + ih) * W + iw] * W_data[((m * C + c) * 3 + kh) * 3 + kw];
+              }
+            }
+          }
+        }
+        Y[(m * H + oh) * W + ow] = sum;
+      }
+    }
+  }
+
+  // the algorithm is opt-in, run both with and without it
+  for (bool enable_winograd : {false, true}) {
+    for (bool weight_is_initializer : {false, true}) {
+      OpTester test("Conv", 11);
+      test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+      test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+      test.AddInput<float>("X", {1, C, H, W}, X);
+      test.AddInput<float>("W", {M, C, 3, 3}, W_data, weight_is_initializer);
+      test.AddInput<float>("B", {M}, B);
+      test.AddOutput<float>("Y", {1, M, H, W}, Y);
+      test.SetOutputTolerance(1e-4f);
+
+      SessionOptions so;
+      ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMlasEnableConvWinograd,
+                                                        enable_winograd ? "1" : "0"));
+      test.ConfigExcludeEps({kTensorrtExecutionProvider, kQnnExecutionProvider})
+          .Config(so)
+          .RunWithConfig();
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
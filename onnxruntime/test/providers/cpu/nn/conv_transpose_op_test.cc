@@ -1190,6 +1190,89 @@ TEST(ConvTransposeTest, ConvTranspose_AutoPad_with_non_default_strides) {
                        kDmlExecutionProvider});     // TODO: Unskip when fixed #41968513
 }
 
+// Stride 2 with a 4x4 kernel: every output phase has a 2x2 sub-kernel. Runs through the phase
+// decomposition when the weights are an initializer.
+TEST(ConvTransposeTest, ConvTranspose_2D_Stride2_Kernel4_Pads1) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{4, 4},        // kernel_shape
+      {},                           // output_padding
+      {},                           // output_shape
+      vector<int64_t>{1, 1, 1, 1},  // pads
+      vector<int64_t>{2, 2},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      1,                            // group
+      "NOTSET"                      // auto_pad
+  };
+
+  vector<float> X = {-3.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, 3.0f, -3.0f, -2.0f,
+                     -1.0f, 0.0f, 1.0f, 2.0f, 3.0f, -3.0f, -2.0f, -1.0f, 0.0f};
+  vector<int64_t> X_shape = {1, 2, 3, 3};
+  vector<float> W = {-2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f,
+                     -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f,
+                     0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f,
+                     1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f};
+  vector<int64_t> W_shape = {2, 2, 4, 4};
+  vector<float> B = {0.0f, 0.5f};
+  vector<int64_t> B_shape = {2};
+
+  vector<float> expected_vals = {6.0f, -2.0f, 2.0f, -1.0f, 2.0f, 2.0f,
+                                 -3.0f, 6.0f, -4.0f, 3.0f, -11.0f, -4.0f,
+                                 -1.0f, -4.0f, 6.0f, 7.0f, 3.0f, -8.0f,
+                                 -7.0f, -3.0f, 10.0f, 8.0f, 10.0f, -4.0f,
+                                 -10.0f, -6.0f, -3.0f, -9.0f, 8.0f, 9.0f,
+                                 8.0f, -7.0f, -10.0f, 4.0f, -2.0f, 4.0f,
+
+                                 2.5f, 2.5f, 1.5f, 2.5f, 0.5f, 2.5f,
+                                 10.5f, -3.5f, 6.5f, -10.5f, -4.5f, 10.5f,
+                                 -2.5f, 6.5f, -3.5f, 3.5f, -10.5f, -3.5f,
+                                 -3.5f, 10.5f, 8.5f, 10.5f, -2.5f, -6.5f,
+                                 -6.5f, -2.5f, 10.5f, 8.5f, 10.5f, -3.5f,
+                                 -5.5f, -9.5f, 2.5f, -1.5f, 2.5f, 2.5f};
+  vector<int64_t> Y_shape = {1, 2, 6, 6};
+
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
+// Stride larger than the kernel, with groups and output_padding: some output phases only receive the bias.
+TEST(ConvTransposeTest, ConvTranspose_2D_StrideLargerThanKernel_Group_OutputPadding) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{2, 2},        // kernel_shape
+      vector<int64_t>{1, 1},        // output_padding
+      {},                           // output_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{3, 3},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      2,                            // group
+      "NOTSET"                      // auto_pad
+  };
+
+  vector<float> X = {-3.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, 3.0f, -3.0f, -2.0f, -1.0f, 0.0f, 1.0f,
+                     2.0f, 3.0f, -3.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, 3.0f, -3.0f, -2.0f, -1.0f};
+  vector<int64_t> X_shape = {1, 4, 2, 3};
+  vector<float> W = {-2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f,
+                     1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f};
+  vector<int64_t> W_shape = {4, 1, 2, 2};
+  vector<float> B = {0.0f, 0.5f};
+  vector<int64_t> B_shape = {2};
+
+  vector<float> expected_vals = {12.0f, -3.0f, 0.0f, -2.0f, 8.0f, 0.0f, -2.0f, 5.0f, 0.0f,
+                                 -3.0f, -3.0f, 0.0f, 3.0f, -2.0f, 0.0f, 2.0f, -1.0f, 0.0f,
+                                 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                                 -2.0f, 2.0f, 0.0f, -2.0f, -1.0f, 0.0f, -2.0f, -4.0f, 0.0f,
+                                 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, -1.0f, 2.0f, 0.0f,
+                                 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+
+                                 2.5f, 5.5f, 0.5f, 3.5f, 8.5f, 0.5f, -2.5f, -2.5f, 0.5f,
+                                 -1.5f, -3.5f, 0.5f, -1.5f, -6.5f, 0.5f, 12.5f, -2.5f, 0.5f,
+                                 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f,
+                                 -1.5f, -6.5f, 0.5f, -0.5f, -3.5f, 0.5f, 0.5f, -0.5f, 0.5f,
+                                 -1.5f, 8.5f, 0.5f, -1.5f, 5.5f, 0.5f, -1.5f, 2.5f, 0.5f,
+                                 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f};
+  vector<int64_t> Y_shape = {1, 2, 6, 9};
+
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
 TEST(ConvTransposeTest, SharedPrepackedWeights) {
@@ -1,9 +1,17 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <exception>
+#include <sstream>
 #include "gtest/gtest.h"
+#include "core/graph/model.h"
+#include "core/providers/cpu/tensor/upsample.h"
+#include "core/session/inference_session.h"
+#include "test/framework/test_utils.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
 #include "test/util/include/default_providers.h"
 #include "test/common/trt_op_test_utils.h"
 
@@ -2532,5 +2540,224 @@ TEST(ResizeOpTest, Axes_and_Size_18) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kQnnExecutionProvider});
 }
 
+// Repeats the values of one image num_images times, adding the index of the image to its values. Nearest and cubic
+// interpolation commute with adding a constant, so the reference output of a single image tiled the same way is the
+// reference output of the tiled input.
+static std::vector<float> TileImages(const std::vector<float>& image, int64_t num_images) {
+  std::vector<float> images;
+  images.reserve(image.size() * static_cast<size_t>(num_images));
+  for (int64_t i = 0; i < num_images; ++i) {
+    for (float value : image) {
+      images.push_back(value + static_cast<float>(i));
+    }
+  }
+  return images;
+}
+
+// the tests below use enough images for the rows to be partitioned across the intra-op thread pool
+static SessionOptions ParallelResizeSessionOptions() {
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  return so;
+}
+
+TEST(ResizeOpTest, ResizeOpNearestUpSampleTest_Parallel) {
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 3.0f};
+
+  test.AddAttribute("mode", "nearest");
+
+  constexpr int64_t N = 2, C = 2048, H = 2, W = 2;
+  std::vector<float> X = {1.0f, 2.0f, 3.0f, 4.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, TileImages(X, N * C));
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<float> Y = {1.0f, 1.0f, 1.0f, 2.0f, 2.0f, 2.0f,
+                          1.0f, 1.0f, 1.0f, 2.0f, 2.0f, 2.0f,
+                          3.0f, 3.0f, 3.0f, 4.0f, 4.0f, 4.0f,
+                          3.0f, 3.0f, 3.0f, 4.0f, 4.0f, 4.0f};
+
+  test.AddOutput<float>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])},
+                        TileImages(Y, N * C));
+  test.ConfigExcludeEps({kTensorrtExecutionProvider})
+      .Config(ParallelResizeSessionOptions())
+      .RunWithConfig();
+}
+
+TEST(ResizeOpTest, ResizeOpNearestUpSample_Nearest2xOptimization_Parallel) {
+  OpTester test("Resize", 13);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+
+  test.AddAttribute("mode", "nearest");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+  test.AddAttribute("nearest_mode", "floor");
+
+  constexpr int64_t N = 2, C = 4096, H = 2, W = 2;
+  std::vector<float> X = {
+      1.0f, 2.0f,
+      3.0f, 4.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, TileImages(X, N * C));
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales, true);
+
+  std::vector<float> Y = {1.0f, 1.0f, 2.0f, 2.0f,
+                          1.0f, 1.0f, 2.0f, 2.0f,
+                          3.0f, 3.0f, 4.0f, 4.0f,
+                          3.0f, 3.0f, 4.0f, 4.0f};
+
+  test.AddOutput<float>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])},
+                        TileImages(Y, N * C));
+  test.ConfigExcludeEps({kTensorrtExecutionProvider})
+      .Config(ParallelResizeSessionOptions())
+      .RunWithConfig();
+}
+
+// 4x4 image of ResizeOpCubicUpSampleTest and ResizeOpCubicDownSampleTest_asymmetric
+static const std::vector<float> kCubicTestImage = {
+    1.0f, 2.0f, 3.0f, 4.0f,
+    5.0f, 6.0f, 7.0f, 8.0f,
+    9.0f, 10.0f, 11.0f, 12.0f,
+    13.0f, 14.0f, 15.0f, 16.0f};
+
+// cubic asymmetric reference output of kCubicTestImage for scales of 2
+static const std::vector<float> kCubicTestUpSampled = {
+    1.0f, 1.40625f, 2.0f, 2.5f, 3.0f, 3.59375f, 4.0f, 4.09375f,
+    2.625f, 3.03125f, 3.625f, 4.125f, 4.625f, 5.21875f, 5.625f, 5.71875f,
+    5.0f, 5.40625f, 6.0f, 6.5f, 7.0f, 7.59375f, 8.0f, 8.09375f,
+    7.0f, 7.40625f, 8.0f, 8.5f, 9.0f, 9.59375f, 10.0f, 10.0938f,
+    9.0f, 9.40625f, 10.0f, 10.5f, 11.0f, 11.5938f, 12.0f, 12.0938f,
+    11.375f, 11.7813f, 12.375f, 12.875f, 13.375f, 13.9688f, 14.375f, 14.4688f,
+    13.0f, 13.4063f, 14.0f, 14.5f, 15.0f, 15.5938f, 16.0f, 16.0938f,
+    13.375f, 13.7813f, 14.375f, 14.875f, 15.375f, 15.9688f, 16.375f, 16.4688f};
+
+// cubic asymmetric reference output of kCubicTestImage for scales of 0.8
+static const std::vector<float> kCubicTestDownSampled = {
+    1.0f, 2.29688f, 3.59375f,
+    6.1875f, 7.48438f, 8.78125f,
+    11.375f, 12.6719f, 13.9688f};
+
+TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_Parallel) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+
+  constexpr int64_t N = 2, C = 256, H = 4, W = 4;
+  test.AddInput<float>("X", {N, C, H, W}, TileImages(kCubicTestImage, N * C));
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  test.AddOutput<float>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])},
+                        TileImages(kCubicTestUpSampled, N * C));
+  test.SetOutputTolerance(1e-4f);
+  test.ConfigExcludeEps({kTensorrtExecutionProvider})
+      .Config(ParallelResizeSessionOptions())
+      .RunWithConfig();
+}
+
+TEST(ResizeOpTest, InterpolationTableCache) {
+  struct Params {
+    int id;
+  };
+
+  InterpolationTableCache<Params> cache;
+  int num_setups = 0;
+  const auto setup = [&num_setups]() { return Params{num_setups++}; };
+
+  const std::vector<int64_t> input_dims{1, 1, 4, 4};
+  const std::vector<int64_t> up_dims{1, 1, 8, 8};
+  const std::vector<int64_t> down_dims{1, 1, 3, 3};
+  const std::vector<float> up_scales{1.0f, 1.0f, 2.0f, 2.0f};
+  const std::vector<float> down_scales{1.0f, 1.0f, 0.8f, 0.8f};
+  const std::vector<float> roi{};
+
+  auto up = cache.Get(input_dims, up_dims, up_scales, roi, setup);
+  EXPECT_EQ(cache.Get(input_dims, up_dims, up_scales, roi, setup), up);
+  EXPECT_EQ(num_setups, 1);
+
+  // any change of the key rebuilds the tables, and only the most recent ones are kept
+  auto down = cache.Get(input_dims, down_dims, down_scales, roi, setup);
+  EXPECT_NE(down, up);
+  EXPECT_EQ(num_setups, 2);
+  EXPECT_EQ(cache.Get(std::vector<int64_t>{1, 2, 4, 4}, down_dims, down_scales, roi, setup)->id, 2);
+  EXPECT_EQ(cache.Get(input_dims, up_dims, up_scales, std::vector<float>{0.0f, 1.0f}, setup)->id, 3);
+  EXPECT_EQ(cache.Get(input_dims, up_dims, up_scales, roi, setup)->id, 4);
+
+  // tables in use by a previous call stay valid after they are replaced
+  EXPECT_EQ(up->id, 0);
+  EXPECT_EQ(down->id, 1);
+}
+
+// Runs the same cubic Resize kernel on inputs of different shapes and scales, so that its cached interpolation
+// tables are rebuilt and reused across the runs.
+TEST(ResizeOpTest, ResizeOpCubic_InterpolationTablesAcrossShapes) {
+  onnxruntime::Model model("resize", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto image_type;
+  image_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  for (const char* dim : {"N", "C", "H", "W"}) {
+    image_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param(dim);
+  }
+  ONNX_NAMESPACE::TypeProto scales_type;
+  scales_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  scales_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &image_type);
+  auto& roi = graph.GetOrCreateNodeArg("", nullptr);
+  auto& scales = graph.GetOrCreateNodeArg("scales", &scales_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &image_type);
+  auto& node = graph.AddNode("resize", "Resize", "", {&x, &roi, &scales}, {&y});
+  node.AddAttribute("mode", "cubic");
+  node.AddAttribute("coordinate_transformation_mode", "asymmetric");
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized_model;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized_model));
+
+  InferenceSession session{ParallelResizeSessionOptions(), GetEnvironment()};
+  std::stringstream model_stream(serialized_model);
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  auto run = [&session](int64_t num_images, float scale, const std::vector<float>& expected_image) {
+    OrtValue x_value;
+    OrtValue scales_value;
+    auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+    CreateMLValue<float>(allocator, {1, num_images, 4, 4}, TileImages(kCubicTestImage, num_images), &x_value);
+    CreateMLValue<float>(allocator, {4}, {1.0f, 1.0f, scale, scale}, &scales_value);
+
+    NameMLValMap feeds{{"X", x_value}, {"scales", scales_value}};
+    const std::vector<std::string> output_names{"Y"};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, output_names, &fetches));
+
+    const auto& y_tensor = fetches[0].Get<Tensor>();
+    const int64_t output_size = static_cast<int64_t>(std::round(4 * scale));
+    ASSERT_EQ(y_tensor.Shape(), TensorShape({1, num_images, output_size, output_size}));
+    const auto expected = TileImages(expected_image, num_images);
+    const auto actual = y_tensor.DataAsSpan<float>();
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_NEAR(actual[i], expected[i], 1e-4f) << "image of " << num_images << ", scale " << scale << ", i " << i;
+    }
+  };
+
+  run(1, 2.0f, kCubicTestUpSampled);
+  run(1, 2.0f, kCubicTestUpSampled);
+  run(1, 0.8f, kCubicTestDownSampled);
+  run(512, 2.0f, kCubicTestUpSampled);
+  run(512, 0.8f, kCubicTestDownSampled);
+  run(1, 2.0f, kCubicTestUpSampled);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -955,6 +955,20 @@ class TestInferenceSession(unittest.TestCase):
         res = sess.run([output_name], {x_name: x})
         np.testing.assert_equal(x, res[0])
 
+    def test_string_input3(self):
+        # characters outside of the basic multilingual plane, an empty string and a mix of str and non str objects
+        sess = onnxrt.InferenceSession(get_name("identity_string.onnx"), providers=available_providers_without_tvm)
+        x_name = sess.get_inputs()[0].name
+        output_name = sess.get_outputs()[0].name
+
+        x = np.array(["\U0001f600", "", "\U0001d11eclef", "é"], dtype=str).reshape((2, 2))
+        res = sess.run([output_name], {x_name: x})
+        np.testing.assert_equal(x, res[0])
+
+        x = np.array(["\U0001f600", "", 12, 1.5], object).reshape((2, 2))
+        res = sess.run([output_name], {x_name: x})
+        np.testing.assert_equal(x.astype(str), res[0].astype(str))
+
     def test_input_bytes(self):
         sess = onnxrt.InferenceSession(get_name("identity_string.onnx"), providers=available_providers_without_tvm)
         x = np.array([b"this", b"is", b"identity", b"test"]).reshape((2, 2))
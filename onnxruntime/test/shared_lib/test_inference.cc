@@ -2001,6 +2001,63 @@ TEST(CApiTest, get_allocator_rocm) {
 }
 #endif
 
+TEST(CApiTest, prepared_run) {
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::PreparedRun prepared_run(session, input_names, 1, output_names, 1);
+
+  const std::array<int64_t, 2> shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), shape.data(), shape.size());
+
+  // outputs allocated by onnxruntime, repeated runs reuse the prepared names
+  for (int run = 0; run < 3; ++run) {
+    x_values[0] = static_cast<float>(run);
+    Ort::Value y{nullptr};
+    session.Run(Ort::RunOptions(), prepared_run, &x, 1, &y, 1);
+
+    ASSERT_TRUE(y.IsTensor());
+    const float* y_values = y.GetTensorData<float>();
+    ASSERT_EQ(y_values[0], static_cast<float>(run * run));
+    ASSERT_EQ(y_values[5], 36.0f);
+  }
+
+  // pre-allocated output
+  {
+    std::array<float, 3 * 2> y_values;
+    Ort::Value y = Ort::Value::CreateTensor(info_cpu, y_values.data(), y_values.size(), shape.data(), shape.size());
+    x_values[0] = 1.0f;
+    session.Run(Ort::RunOptions(), prepared_run, &x, 1, &y, 1);
+
+    const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+    ASSERT_TRUE(std::equal(std::begin(y_values), std::end(y_values), std::begin(expected_y)));
+  }
+
+  // wrong number of inputs
+  {
+    Ort::Value y{nullptr};
+    ASSERT_THROW(session.Run(Ort::RunOptions(), prepared_run, &x, 0, &y, 1), Ort::Exception);
+
+    // the extra input is null, the count must be checked before the inputs are
+    Ort::Value inputs[] = {
+        Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), shape.data(), shape.size()),
+        Ort::Value{nullptr}};
+    ASSERT_THROW(session.Run(Ort::RunOptions(), prepared_run, inputs, 2, &y, 1), Ort::Exception);
+  }
+
+  // invalid names are reported when preparing
+  {
+    const char* invalid_names[] = {"Z"};
+    ASSERT_THROW(Ort::PreparedRun(session, invalid_names, 1, output_names, 1), Ort::Exception);
+    ASSERT_THROW(Ort::PreparedRun(session, input_names, 1, invalid_names, 1), Ort::Exception);
+  }
+}
+
 TEST(CApiTest, io_binding) {
   Ort::SessionOptions session_options;
   Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CPU(session_options, 1));
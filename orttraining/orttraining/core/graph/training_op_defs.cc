@@ -1652,7 +1652,7 @@ void RegisterTrainingOpSchemas() {
           "Constrain gradients' types.")
       .TypeConstraint(
           "S_MOMENT",
-          {"seq(tensor(float16))", "seq(tensor(float))", "seq(tensor(double))"},
+          {"seq(tensor(float16))", "seq(tensor(bfloat16))", "seq(tensor(float))", "seq(tensor(double))"},
           "Constrain momentums' types.")
       .TypeConstraint(
           "T_BOOL",
@@ -52,6 +52,7 @@ def generate_artifacts(
     additional_output_names: Optional[List[str]] = None,
     nominal_checkpoint: bool = False,
     loss_input_names: Optional[List[str]] = None,
+    master_weights: bool = False,
 ) -> None:
     """Generates artifacts required for training with ORT training api.
 
@@ -85,6 +86,9 @@ def generate_artifacts(
         loss_input_names: Specifies a list of input names to be used specifically for the loss computation. When provided,
             only these inputs will be passed to the loss function. If `None`, all graph outputs are passed to
             the loss function.
+        master_weights: Whether float16 and bfloat16 trainable parameters are trained through float master weights,
+            so that small updates are not lost to rounding. Their gradients are then accumulated in float, and the
+            optimizer model updates float parameters. Master weights are only supported on CPU. Default is False.
     Raises:
         RuntimeError: If the loss provided is neither one of the supported losses nor an instance of `onnxblock.Block`
         RuntimeError: If the optimizer provided is not one of the supported optimizers.
@@ -176,6 +180,8 @@ def generate_artifacts(
         for arg in frozen_params:
             training_block.requires_grad(arg, False)
 
+    training_block.use_master_weights(master_weights)
+
     training_model = None
     eval_model = None
     model_params = None
@@ -253,7 +259,7 @@ def generate_artifacts(
     optim_block = None
     if isinstance(optimizer, OptimType):
         logging.info("Optimizer enum provided: %s", optimizer.name)
-        optim_block = optim_blocks[optimizer]()
+        optim_block = optim_blocks[optimizer](master_weights=master_weights)
     elif isinstance(optimizer, onnxblock.Block):
         logging.info("Optimizer block provided: %s", optimizer.__class__.__name__)
         optim_block = optimizer
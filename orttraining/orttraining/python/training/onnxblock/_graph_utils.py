@@ -26,6 +26,18 @@ def get_input_from_input_name(onnx_model: onnx.ModelProto, input_name: str) -> o
     raise LookupError(f"The provided output name {input_name} is not a graph input.")
 
 
+def get_full_precision_type(data_type: int) -> int:
+    """Returns the type that values of the given type are accumulated and updated in.
+
+    The gradients of reduced precision (float16 and bfloat16) parameters with master weights are accumulated, and the
+    parameters are updated through their master weights, in float so that small updates are not lost to rounding.
+    """
+
+    if data_type in (onnx.TensorProto.FLOAT16, onnx.TensorProto.BFLOAT16):
+        return onnx.TensorProto.FLOAT
+    return data_type
+
+
 _GRAPH_TOKEN = 0
 
 
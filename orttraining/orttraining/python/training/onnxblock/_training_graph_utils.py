@@ -8,6 +8,7 @@ from typing import List, Optional, Set, Tuple, Union
 
 import onnx
 
+import onnxruntime.training.onnxblock._graph_utils as _graph_utils
 from onnxruntime import SessionOptions
 from onnxruntime.capi._pybind_state import GradientGraphBuilder, get_optimized_model
 
@@ -134,7 +135,9 @@ def build_gradient_graph(
     return gradient_model, eval_model
 
 
-def build_gradient_accumulation_graph(grad_model: onnx.ModelProto, requires_grad: Set[str]) -> None:
+def build_gradient_accumulation_graph(
+    grad_model: onnx.ModelProto, requires_grad: Set[str], master_weights: bool = False
+) -> None:
     """Builds gradient accumulation nodes on top of a training model.
 
     Adds an InPlaceAccumulatorV2 node for every gradient so that the gradients
@@ -154,6 +157,8 @@ def build_gradient_accumulation_graph(grad_model: onnx.ModelProto, requires_grad
         |                      |
         |                      v
         |______________________|
+
+    If master_weights is True, the gradients of reduced precision parameters are accumulated in float buffers.
     """
 
     # TODO: Avoid hard coded input/output strings
@@ -190,9 +195,13 @@ def build_gradient_accumulation_graph(grad_model: onnx.ModelProto, requires_grad
 
         graph_nodes.append(acc_node)
 
-        # Grad buffer is also a graph input
+        # Grad buffer is also a graph input. Reduced precision gradients of parameters with master weights
+        # are accumulated in float.
         grad_accumulation_buffer_input = copy.deepcopy(graph_output)
         grad_accumulation_buffer_input.name = grad_accumulation_buffer_name
+        if master_weights:
+            tensor_type = grad_accumulation_buffer_input.type.tensor_type
+            tensor_type.elem_type = _graph_utils.get_full_precision_type(tensor_type.elem_type)
         graph_inputs.append(grad_accumulation_buffer_input)
 
         # Accumulated gradient update flag is also a graph output
@@ -109,6 +109,7 @@ class TrainingBlock(blocks.Block):
         self._parameters = None
         self._training_model = None
         self._eval_model = None
+        self._master_weights = False
 
     @abstractmethod
     def build(self, *args, **kwargs):
@@ -139,6 +140,18 @@ class TrainingBlock(blocks.Block):
                 self._requires_grad.remove(argument_name)
             self._frozen_params.add(argument_name)
 
+    def use_master_weights(self, value: bool = True):
+        """Specify whether reduced precision parameters are trained through float master weights.
+
+        If True, the gradients of float16 and bfloat16 parameters are accumulated in float, to be used by an
+        optimizer built with master weights. Master weights are only supported on CPU. By default, the gradients
+        are accumulated in the type of the parameters.
+
+        Args:
+            value (bool): True if reduced precision parameters are trained through master weights, False otherwise.
+        """
+        self._master_weights = value
+
     def parameters(self) -> Tuple[List[onnx.TensorProto], List[onnx.TensorProto]]:
         """Trainable as well as non-trainable (frozen) parameters of the model.
 
@@ -207,7 +220,9 @@ class TrainingBlock(blocks.Block):
 
         logging.debug("Adding gradient accumulation nodes for training block %s", self.__class__.__name__)
 
-        _training_graph_utils.build_gradient_accumulation_graph(self._training_model, self._requires_grad)
+        _training_graph_utils.build_gradient_accumulation_graph(
+            self._training_model, self._requires_grad, self._master_weights
+        )
 
         accessor._GLOBAL_ACCESSOR.model.CopyFrom(self._training_model)
 
@@ -201,9 +201,17 @@ class AdamWOptimizer(_OptimizerBase):
 class _Optimizer(onnxblock_module.ForwardBlock):
     """Base class for building optimizer onnxblocks."""
 
-    def __init__(self, clip_grad=None):
+    def __init__(self, clip_grad=None, master_weights=False):
         super().__init__()
         self._clip_grad = clip_grad
+        self._master_weights = master_weights
+
+    def _state_data_type(self, data_type: int) -> int:
+        # Reduced precision parameters with master weights are updated through float master weights, with float
+        # gradients and moments. Master weights are only supported on CPU.
+        if self._master_weights:
+            return _graph_utils.get_full_precision_type(data_type)
+        return data_type
 
     def build(self, parameters):
         onnx_model = self.base
@@ -223,10 +231,9 @@ class _Optimizer(onnxblock_module.ForwardBlock):
             ]
         )
 
+        data_type = self._state_data_type(trainable_parameters[0].data_type)
         for input_name in [params_name, gradients_name, first_order_moments_name]:
-            onnx_model.graph.input.append(
-                onnx.helper.make_tensor_sequence_value_info(input_name, trainable_parameters[0].data_type, None)
-            )
+            onnx_model.graph.input.append(onnx.helper.make_tensor_sequence_value_info(input_name, data_type, None))
 
         if self._clip_grad is not None:
             gradients_name = self._clip_grad(gradients_name)
@@ -250,8 +257,16 @@ class _Optimizer(onnxblock_module.ForwardBlock):
 class AdamW(_Optimizer):
     """Builds AdamW optimizer onnxblock for the given training parameters."""
 
-    def __init__(self, bias_correction=True, betas=(0.9, 0.999), eps=1e-6, weight_decay=0.0, clip_grad=None):
-        super().__init__(clip_grad)
+    def __init__(
+        self,
+        bias_correction=True,
+        betas=(0.9, 0.999),
+        eps=1e-6,
+        weight_decay=0.0,
+        clip_grad=None,
+        master_weights=False,
+    ):
+        super().__init__(clip_grad, master_weights)
         self._adamw = AdamWOptimizer(
             bias_correction=bias_correction,
             betas=betas,
@@ -274,7 +289,7 @@ class AdamW(_Optimizer):
         # Prepare the tensor sequence inputs for moments
         onnx_model.graph.input.append(
             onnx.helper.make_tensor_sequence_value_info(
-                second_order_moments_name, trainable_parameters[0].data_type, None
+                second_order_moments_name, self._state_data_type(trainable_parameters[0].data_type), None
             )
         )
 
@@ -298,8 +313,8 @@ class AdamW(_Optimizer):
 class SGD(_Optimizer):
     """Builds SGD optimizer onnxblock for the given training parameters."""
 
-    def __init__(self, clip_grad=None):
-        super().__init__(clip_grad)
+    def __init__(self, clip_grad=None, master_weights=False):
+        super().__init__(clip_grad, master_weights)
         self._sgd = SGDOptimizer()
 
     def _optimizer_specific_logic(
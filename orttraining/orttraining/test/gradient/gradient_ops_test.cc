@@ -2228,6 +2228,61 @@ TEST(GradientUtilsTest, InPlaceAccumulatorV2Overwrite) {
   test.Run();
 }
 
+TEST(GradientUtilsTest, InPlaceAccumulatorV2_Float16) {
+  OpTester test("InPlaceAccumulatorV2", 1, onnxruntime::kMSDomain);
+
+  std::vector<float> old_sum = {1.0f, 2.0f, 3.0f};
+  std::vector<float> value = {4.0f, 5.0f, 6.0f};
+  std::vector<float> new_sum = {4.0f, 5.0f, 6.0f};
+
+  std::vector<MLFloat16> value_half(3);
+  ConvertFloatToMLFloat16(value.data(), value_half.data(), 3);
+
+  test.AddInput<float>("old_sum", {3}, old_sum);
+  test.AddInput<MLFloat16>("value", {3}, value_half);
+  test.AddInput<bool>("overwrite", {1}, {true});
+  test.AddOutput<bool>("updated", {1}, {true});
+  test.AddOutput<float>("new_sum", {3}, new_sum);
+
+  test.Run();
+}
+
+TEST(GradientUtilsTest, InPlaceAccumulatorV2_Float16_Accumulate) {
+  OpTester test("InPlaceAccumulatorV2", 1, onnxruntime::kMSDomain);
+
+  std::vector<float> old_sum = {1.0f, 2.0f, 3.0f};
+  std::vector<float> value = {4.0f, 5.0f, 6.0f};
+  std::vector<float> new_sum = {5.0f, 7.0f, 9.0f};
+
+  std::vector<MLFloat16> value_half(3);
+  ConvertFloatToMLFloat16(value.data(), value_half.data(), 3);
+
+  test.AddInput<float>("old_sum", {3}, old_sum);
+  test.AddInput<MLFloat16>("value", {3}, value_half);
+  test.AddOutput<bool>("updated", {1}, {true});
+  test.AddOutput<float>("new_sum", {3}, new_sum);
+
+  test.Run();
+}
+
+TEST(GradientUtilsTest, InPlaceAccumulatorV2_BFloat16_CPU) {
+  OpTester test("InPlaceAccumulatorV2", 1, onnxruntime::kMSDomain);
+
+  std::vector<float> old_sum = {1.0f, 2.0f, 3.0f};
+  std::vector<float> value = {0.5f, -2.0f, 6.0f};
+  std::vector<float> new_sum = {1.5f, 0.0f, 9.0f};
+
+  test.AddInput<float>("old_sum", {3}, old_sum);
+  test.AddInput<BFloat16>("value", {3}, FloatsToBFloat16s(value));
+  test.AddInput<bool>("overwrite", {1}, {false});
+  test.AddOutput<bool>("updated", {1}, {true});
+  test.AddOutput<float>("new_sum", {3}, new_sum);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> providers;
+  providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &providers);
+}
+
 #if defined(USE_CUDA)
 // TODO: Add rocm kernel defs
 TEST(GradientUtilsTest, InPlaceAccumulatorV2_GPU) {
@@ -2251,27 +2306,6 @@ TEST(GradientUtilsTest, InPlaceAccumulatorV2_GPU) {
   }
 }
 
-TEST(GradientUtilsTest, InPlaceAccumulatorV2_Float16) {
-  OpTester test("InPlaceAccumulatorV2", 1, onnxruntime::kMSDomain);
-
-  std::vector<float> old_sum = {1.0f, 2.0f, 3.0f};
-  std::vector<float> value = {4.0f, 5.0f, 6.0f};
-  std::vector<float> new_sum = {4.0f, 5.0f, 6.0f};
-
-  std::vector<MLFloat16> value_half(3);
-  ConvertFloatToMLFloat16(value.data(), value_half.data(), 3);
-
-  test.AddInput<float>("old_sum", {3}, old_sum);
-  test.AddInput<MLFloat16>("value", {3}, value_half);
-  test.AddInput<bool>("overwrite", {1}, {true});
-  test.AddOutput<bool>("updated", {1}, {true});
-  test.AddOutput<float>("new_sum", {3}, new_sum);
-
-  // Didn't implement mixed precision InPlaceAccumulatorV2 in CPU
-  std::vector<std::unique_ptr<IExecutionProvider>> providers;
-  providers.emplace_back(DefaultCudaExecutionProvider());
-  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &providers);
-}
 #endif
 
 #if defined(USE_CUDA) || defined(USE_ROCM)
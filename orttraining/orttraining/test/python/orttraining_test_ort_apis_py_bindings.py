@@ -145,6 +145,84 @@ def test_optimizer_step(optimizer_type):
         assert not np.array_equal(old_flatten_params.numpy(), new_params.numpy())
 
 
+@pytest.mark.parametrize("optimizer_type", [artifacts.OptimType.SGD, artifacts.OptimType.AdamW])
+def test_optimizer_step_with_float16_parameters(optimizer_type):
+    # A linear model that stores its parameters in float16 and computes in float.
+    weight = onnx.numpy_helper.from_array(np.random.rand(4, 2).astype(np.float16), "weight")
+    bias = onnx.numpy_helper.from_array(np.random.rand(2).astype(np.float16), "bias")
+    nodes = [
+        onnx.helper.make_node("Cast", ["weight"], ["weight_float"], to=onnx.TensorProto.FLOAT),
+        onnx.helper.make_node("Cast", ["bias"], ["bias_float"], to=onnx.TensorProto.FLOAT),
+        onnx.helper.make_node("MatMul", ["input", "weight_float"], ["matmul_output"]),
+        onnx.helper.make_node("Add", ["matmul_output", "bias_float"], ["output"]),
+    ]
+    graph = onnx.helper.make_graph(
+        nodes,
+        "float16_linear",
+        [onnx.helper.make_tensor_value_info("input", onnx.TensorProto.FLOAT, [8, 4])],
+        [onnx.helper.make_tensor_value_info("output", onnx.TensorProto.FLOAT, [8, 2])],
+        initializer=[weight, bias],
+    )
+    onnx_model = onnx.helper.make_model(graph, opset_imports=[onnx.helper.make_opsetid("", 17)])
+
+    inputs = np.random.rand(8, 4).astype(np.float32)
+    targets = np.random.rand(8, 2).astype(np.float32)
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+        # Without master weights, the gradients are accumulated and the parameters updated in float16.
+        artifacts.generate_artifacts(
+            onnx_model,
+            optimizer=optimizer_type,
+            loss=artifacts.LossType.MSELoss,
+            requires_grad=["weight", "bias"],
+            artifact_directory=temp_dir,
+        )
+        training_model = onnx.load(os.path.join(temp_dir, "training_model.onnx"))
+        for graph_input in training_model.graph.input:
+            if graph_input.name.endswith(".accumulation.buffer"):
+                assert graph_input.type.tensor_type.elem_type == onnx.TensorProto.FLOAT16
+
+        artifacts.generate_artifacts(
+            onnx_model,
+            optimizer=optimizer_type,
+            loss=artifacts.LossType.MSELoss,
+            requires_grad=["weight", "bias"],
+            artifact_directory=temp_dir,
+            master_weights=True,
+        )
+
+        # The gradients are accumulated in float, and the optimizer updates float master weights.
+        training_model = onnx.load(os.path.join(temp_dir, "training_model.onnx"))
+        for graph_input in training_model.graph.input:
+            if graph_input.name.endswith(".accumulation.buffer"):
+                assert graph_input.type.tensor_type.elem_type == onnx.TensorProto.FLOAT
+        optimizer_model = onnx.load(os.path.join(temp_dir, "optimizer_model.onnx"))
+        for graph_input in optimizer_model.graph.input:
+            if graph_input.type.HasField("sequence_type"):
+                assert graph_input.type.sequence_type.elem_type.tensor_type.elem_type == onnx.TensorProto.FLOAT
+
+        state = CheckpointState.load_checkpoint(os.path.join(temp_dir, "checkpoint"))
+        model = Module(os.path.join(temp_dir, "training_model.onnx"), state)
+        optimizer = Optimizer(os.path.join(temp_dir, "optimizer_model.onnx"), model)
+
+        model.train()
+        old_weight = state.parameters["weight"].data
+        model(inputs, targets)
+        assert state.parameters["weight"].grad.dtype == np.float32
+        assert state.parameters["weight"].grad.any()
+
+        optimizer.step()
+        new_weight = state.parameters["weight"].data
+        assert new_weight.dtype == np.float16
+        assert not np.array_equal(old_weight, new_weight)
+
+        # The parameters keep being trained through their master weights.
+        model.lazy_reset_grad()
+        model(inputs, targets)
+        optimizer.step()
+        assert not np.array_equal(new_weight, state.parameters["weight"].data)
+
+
 @pytest.mark.parametrize("optimizer_type", [artifacts.OptimType.SGD, artifacts.OptimType.AdamW])
 def test_get_and_set_lr(optimizer_type):
     with tempfile.TemporaryDirectory() as temp_dir:
@@ -581,4 +581,161 @@ TEST(CheckpointApiTest, SaveOnnxModelAsCheckpoint_ThenLoad_WithExternalData) {
   }
 }
 
+/**
+ * Load a checkpoint with external data, save it back to the same checkpoint synchronously and asynchronously,
+ * and check that only the modified parameters are written to the external data file.
+ */
+TEST(CheckpointApiTest, SaveCheckpointState_Incremental_WithExternalData) {
+  auto model_uri = MODEL_FOLDER "transform/computation_reduction/gathernd/e2e.onnx";
+  const std::string trainable_param_name = "cls.predictions.transform.LayerNorm.weight";
+
+  auto logger_ptr = std::make_unique<logging::Logger>(logging::LoggingManager::DefaultLogger());
+  std::shared_ptr<Model> p_model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, p_model, nullptr, *logger_ptr));
+  Graph& graph = p_model->MainGraph();
+
+  std::vector<ONNX_NAMESPACE::TensorProto> trainable_param_values;
+  std::vector<ONNX_NAMESPACE::TensorProto> non_trainable_param_values;
+  for (const auto& [initializer_name, tensor_proto] : graph.GetAllInitializedTensors()) {
+    if (initializer_name == trainable_param_name) {
+      trainable_param_values.emplace_back(static_cast<ONNX_NAMESPACE::TensorProto>(*tensor_proto));
+    } else {
+      non_trainable_param_values.emplace_back(static_cast<ONNX_NAMESPACE::TensorProto>(*tensor_proto));
+    }
+  }
+  ASSERT_EQ(trainable_param_values.size(), size_t{1});
+
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+  PathString checkpoint_path{
+      ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("e2e_ckpt_incremental"))};
+  PathString external_data_path = ExternalCheckpointDataPath(checkpoint_path);
+  ASSERT_STATUS_OK(SaveCheckpoint(trainable_param_values, non_trainable_param_values, checkpoint_path,
+                                  false /* nominal checkpoint */, 0 /* external_data_threshold */));
+
+  CheckpointState checkpoint_state;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, checkpoint_state));
+  ASSERT_TRUE(checkpoint_state.has_external_data);
+
+  // The parameters too small to be in the external data file of the original checkpoint are appended to it.
+  ASSERT_STATUS_OK(SaveCheckpoint(checkpoint_state, checkpoint_path, false));
+  const auto external_data_size = std::filesystem::file_size(external_data_path);
+
+  // Nothing changed, nothing is written.
+  ASSERT_STATUS_OK(SaveCheckpoint(checkpoint_state, checkpoint_path, false));
+  ASSERT_EQ(std::filesystem::file_size(external_data_path), external_data_size);
+
+  // Only the updated parameter is written.
+  Tensor* trainable_tensor =
+      checkpoint_state.module_checkpoint_state.named_parameters.at(trainable_param_name)->Data().GetMutable<Tensor>();
+  auto trainable_data = trainable_tensor->MutableDataAsSpan<float>();
+  for (auto& value : trainable_data) {
+    value += 1.0f;
+  }
+  checkpoint_state.module_checkpoint_state.named_parameters.at(trainable_param_name)->MarkDataModified();
+  ASSERT_STATUS_OK(SaveCheckpointAsync(checkpoint_state, checkpoint_path, false));
+  ASSERT_STATUS_OK(WaitForCheckpointSave(checkpoint_state));
+  ASSERT_GT(std::filesystem::file_size(external_data_path), external_data_size);
+  ASSERT_LE(std::filesystem::file_size(external_data_path), external_data_size + trainable_tensor->SizeInBytes() + 8);
+
+  CheckpointState restored_checkpoint_state;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, restored_checkpoint_state));
+  const auto& param_states = checkpoint_state.module_checkpoint_state.named_parameters;
+  const auto& restored_param_states = restored_checkpoint_state.module_checkpoint_state.named_parameters;
+  ASSERT_EQ(param_states.size(), restored_param_states.size());
+  for (const auto& [name, param] : param_states) {
+    const Tensor& tensor = param->Data().Get<Tensor>();
+    const Tensor& restored_tensor = restored_param_states.at(name)->Data().Get<Tensor>();
+    ASSERT_EQ(tensor.DataType(), restored_tensor.DataType());
+    ASSERT_EQ(tensor.SizeInBytes(), restored_tensor.SizeInBytes());
+    ASSERT_EQ(std::memcmp(tensor.DataRaw(), restored_tensor.DataRaw(), tensor.SizeInBytes()), 0);
+  }
+}
+
+/**
+ * Load a checkpoint with external data into two states, modify them differently and save them to the same
+ * checkpoint in turn, and check that each save writes the data of the state saved.
+ */
+TEST(CheckpointApiTest, SaveDivergedCheckpointStates_WithExternalData) {
+  auto model_uri = MODEL_FOLDER "transform/computation_reduction/gathernd/e2e.onnx";
+  const std::string trainable_param_name = "cls.predictions.transform.LayerNorm.weight";
+
+  auto logger_ptr = std::make_unique<logging::Logger>(logging::LoggingManager::DefaultLogger());
+  std::shared_ptr<Model> p_model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, p_model, nullptr, *logger_ptr));
+  Graph& graph = p_model->MainGraph();
+
+  std::vector<ONNX_NAMESPACE::TensorProto> trainable_param_values;
+  std::vector<ONNX_NAMESPACE::TensorProto> non_trainable_param_values;
+  for (const auto& [initializer_name, tensor_proto] : graph.GetAllInitializedTensors()) {
+    if (initializer_name == trainable_param_name) {
+      trainable_param_values.emplace_back(static_cast<ONNX_NAMESPACE::TensorProto>(*tensor_proto));
+    } else {
+      non_trainable_param_values.emplace_back(static_cast<ONNX_NAMESPACE::TensorProto>(*tensor_proto));
+    }
+  }
+  ASSERT_EQ(trainable_param_values.size(), size_t{1});
+
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+  PathString checkpoint_path{
+      ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("e2e_ckpt_diverged"))};
+  ASSERT_STATUS_OK(SaveCheckpoint(trainable_param_values, non_trainable_param_values, checkpoint_path,
+                                  false /* nominal checkpoint */, 0 /* external_data_threshold */));
+
+  CheckpointState checkpoint_state;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, checkpoint_state));
+  ASSERT_TRUE(checkpoint_state.has_external_data);
+
+  // The copy shares the parameters of the original state until one of them is replaced.
+  CheckpointState diverged_checkpoint_state = checkpoint_state;
+  const Tensor& original_tensor =
+      checkpoint_state.module_checkpoint_state.named_parameters.at(trainable_param_name)->Data().Get<Tensor>();
+  OrtValue diverged_value;
+  Tensor::InitOrtValue(original_tensor.DataType(), original_tensor.Shape(), std::make_shared<CPUAllocator>(),
+                       diverged_value);
+  auto diverged_data = diverged_value.GetMutable<Tensor>()->MutableDataAsSpan<float>();
+  auto original_data = original_tensor.DataAsSpan<float>();
+  for (size_t i = 0; i < diverged_data.size(); ++i) {
+    diverged_data[i] = original_data[i] + 2.0f;
+  }
+  diverged_checkpoint_state.module_checkpoint_state.named_parameters[trainable_param_name] =
+      std::make_shared<Parameter>(trainable_param_name, diverged_value, true);
+
+  auto check_saved_state = [&checkpoint_path](const CheckpointState& state) {
+    CheckpointState restored_checkpoint_state;
+    ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, restored_checkpoint_state));
+    const auto& param_states = state.module_checkpoint_state.named_parameters;
+    const auto& restored_param_states = restored_checkpoint_state.module_checkpoint_state.named_parameters;
+    ASSERT_EQ(param_states.size(), restored_param_states.size());
+    for (const auto& [name, param] : param_states) {
+      const Tensor& tensor = param->Data().Get<Tensor>();
+      const Tensor& restored_tensor = restored_param_states.at(name)->Data().Get<Tensor>();
+      ASSERT_EQ(tensor.DataType(), restored_tensor.DataType());
+      ASSERT_EQ(tensor.SizeInBytes(), restored_tensor.SizeInBytes());
+      ASSERT_EQ(std::memcmp(tensor.DataRaw(), restored_tensor.DataRaw(), tensor.SizeInBytes()), 0);
+    }
+  };
+
+  // Update the parameter of the original state in place.
+  Tensor* trainable_tensor =
+      checkpoint_state.module_checkpoint_state.named_parameters.at(trainable_param_name)->Data().GetMutable<Tensor>();
+  for (auto& value : trainable_tensor->MutableDataAsSpan<float>()) {
+    value += 1.0f;
+  }
+  checkpoint_state.module_checkpoint_state.named_parameters.at(trainable_param_name)->MarkDataModified();
+
+  ASSERT_STATUS_OK(SaveCheckpoint(checkpoint_state, checkpoint_path, false));
+  check_saved_state(checkpoint_state);
+
+  // The copy still refers to the external data file as it was loaded.
+  ASSERT_STATUS_OK(SaveCheckpoint(diverged_checkpoint_state, checkpoint_path, false));
+  check_saved_state(diverged_checkpoint_state);
+
+  // The original state refers to the external data file as it saved it, before the copy replaced it.
+  ASSERT_STATUS_OK(SaveCheckpointAsync(checkpoint_state, checkpoint_path, false));
+  ASSERT_STATUS_OK(WaitForCheckpointSave(checkpoint_state));
+  check_saved_state(checkpoint_state);
+}
+
 }  // namespace onnxruntime::training::test
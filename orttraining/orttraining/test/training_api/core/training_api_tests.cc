@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -596,6 +599,84 @@ TEST(TrainingApiTest, OptimStep) {
   }
 }
 
+TEST(TrainingApiTest, OptimStep_GradientScaling) {
+  auto model_uri = MODEL_FOLDER "training_model.onnx";
+  auto optim_uri = MODEL_FOLDER "adamw.onnx";
+
+  onnxruntime::training::api::CheckpointState state;
+  auto checkpoint_to_load_path = MODEL_FOLDER "checkpoint.ckpt";
+  ASSERT_STATUS_OK(onnxruntime::training::api::LoadCheckpoint(checkpoint_to_load_path, state));
+
+  onnxruntime::SessionOptions session_option;
+  std::unique_ptr<Environment> env;
+  std::vector<std::shared_ptr<IExecutionProvider>> providers;
+  ASSERT_STATUS_OK(Environment::Create(nullptr, env));
+
+  auto model_identifier = ModelIdentifiers(onnxruntime::ToUTF8String(model_uri),
+                                           std::nullopt,
+                                           std::optional<std::string>(onnxruntime::ToUTF8String(optim_uri)));
+  auto model = std::make_unique<onnxruntime::training::api::Module>(
+      model_identifier, &state, session_option,
+      *env, providers);
+  auto optim = std::make_unique<onnxruntime::training::api::Optimizer>(
+      model_identifier, &state, session_option,
+      *env, providers);
+
+  constexpr float loss_scale = 1024.0f;
+  constexpr float max_grad_norm = 0.5f;
+  ASSERT_STATUS_OK(optim->SetGradientScaling(loss_scale, max_grad_norm));
+  ASSERT_FALSE(optim->SetGradientScaling(0.0f, max_grad_norm).IsOK());
+
+  OrtValue input, target;
+  GenerateRandomInput(std::array<int64_t, 2>{2, 784}, input);
+  target = onnxruntime::test::CreateInputOrtValueOnCPU<int32_t>(
+      std::array<int64_t, 1>{2}, std::vector<int32_t>(2, 1));
+  std::vector<OrtValue> inputs{input, target};
+
+  const std::string param_name = "fc2.weight";
+  auto param = model->NamedParameters().at(param_name);
+  auto& group0_states = state.optimizer_checkpoint_state.group_named_optimizer_states["group0"];
+
+  // the step is skipped if any gradient is not finite
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(model->TrainStep(inputs, fetches));
+  std::vector<float> param_before_step, param_after_step;
+  CpuOrtValueToVec(param->Data(), param_before_step);
+  param->Gradient().GetMutable<Tensor>()->MutableData<float>()[0] = std::numeric_limits<float>::infinity();
+  ASSERT_STATUS_OK(optim->Step());
+  CpuOrtValueToVec(param->Data(), param_after_step);
+  ASSERT_EQ(param_before_step, param_after_step);
+  ASSERT_EQ(group0_states->step, 0);
+  ASSERT_EQ(optim->SkippedStepCount(), 1);
+
+  // and the gradients are reset
+  std::vector<float> grads_after_skip;
+  CpuOrtValueToVec(param->Gradient(), grads_after_skip);
+  ASSERT_TRUE(std::all_of(grads_after_skip.begin(), grads_after_skip.end(), [](float g) { return g == 0.0f; }));
+
+  // otherwise the gradients are unscaled and clipped to the max norm before the update
+  fetches.clear();
+  ASSERT_STATUS_OK(model->TrainStep(inputs, fetches));
+  ASSERT_STATUS_OK(optim->Step());
+  ASSERT_EQ(group0_states->step, 1);
+  ASSERT_EQ(optim->SkippedStepCount(), 1);
+
+  double squared_norm = 0.0;
+  for (auto& [name, parameter] : model->NamedParameters()) {
+    if (parameter->RequiresGrad()) {
+      std::vector<float> grads;
+      CpuOrtValueToVec(parameter->Gradient(), grads);
+      for (float grad : grads) {
+        squared_norm += static_cast<double>(grad) * grad;
+      }
+    }
+  }
+  ASSERT_LE(std::sqrt(squared_norm), max_grad_norm * 1.001);
+
+  CpuOrtValueToVec(param->Data(), param_after_step);
+  ASSERT_NE(param_before_step, param_after_step);
+}
+
 TEST(TrainingApiTest, ModuleAndOptimizerWithNominalState) {
   auto model_uri = MODEL_FOLDER "training_model.onnx";
   auto eval_model_uri = MODEL_FOLDER "eval_model.onnx";
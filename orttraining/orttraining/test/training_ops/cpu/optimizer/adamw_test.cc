@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+namespace optimizer {
+namespace {
+
+// The CPU kernel splits the weights in chunks updated in parallel, and can keep the momentums in float16.
+TEST(AdamWTest, CpuFloat16MomentumsMultipleChunks) {
+  const float lr = 1e-3f, alpha = 0.9f, beta = 0.999f, epsilon = 1e-8f, weight_decay = 1e-2f;
+  const int64_t step = 3;
+  const float alpha_correction = 1.f - static_cast<float>(std::pow(alpha, step));
+  const float beta_correction = 1.f - static_cast<float>(std::pow(beta, step));
+
+  RandomValueGenerator random{};
+  SeqTensors<float> weights, gradients, updated_weights;
+  SeqTensors<MLFloat16> momentums_1, momentums_2, updated_momentums_1, updated_momentums_2;
+  for (const VectorInt64& shape : {VectorInt64{3, 5}, VectorInt64{70, 100}, VectorInt64{10001}}) {
+    std::vector<float> weight = random.Uniform<float>(shape, -1.f, 1.f);
+    const std::vector<float> gradient = random.Uniform<float>(shape, -1.f, 1.f);
+    const std::vector<MLFloat16> momentum_1 = ToFloat16(random.Uniform<float>(shape, -0.1f, 0.1f));
+    const std::vector<MLFloat16> momentum_2 = ToFloat16(random.Uniform<float>(shape, 0.f, 0.01f));
+
+    weights.AddTensor(shape, weight);
+    gradients.AddTensor(shape, gradient);
+    momentums_1.AddTensor(shape, momentum_1);
+    momentums_2.AddTensor(shape, momentum_2);
+
+    std::vector<float> updated_momentum_1(weight.size()), updated_momentum_2(weight.size());
+    for (size_t i = 0; i < weight.size(); ++i) {
+      updated_momentum_1[i] = alpha * momentum_1[i].ToFloat() + (1.f - alpha) * gradient[i];
+      updated_momentum_2[i] = beta * momentum_2[i].ToFloat() + (1.f - beta) * gradient[i] * gradient[i];
+      weight[i] -= weight[i] * lr * weight_decay;
+      weight[i] -= lr * updated_momentum_1[i] /
+                   (alpha_correction * (std::sqrt(updated_momentum_2[i] / beta_correction) + epsilon));
+    }
+
+    updated_weights.AddTensor(shape, weight);
+    updated_momentums_1.AddTensor(shape, ToFloat16(updated_momentum_1));
+    updated_momentums_2.AddTensor(shape, ToFloat16(updated_momentum_2));
+  }
+
+  OpTester test("AdamWOptimizer", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("alpha", alpha);
+  test.AddAttribute("beta", beta);
+  test.AddAttribute("epsilon", epsilon);
+  test.AddAttribute("weight_decay", weight_decay);
+  test.AddAttribute("adam_mode", static_cast<int64_t>(0));
+  test.AddAttribute("correct_bias", static_cast<int64_t>(1));
+
+  test.AddInput<float>("lr", {}, {lr});
+  test.AddInput<int64_t>("step", {}, {step});
+  test.AddSeqInput("weights", weights);
+  test.AddSeqInput("gradients", gradients);
+  test.AddSeqInput("momentums_1", momentums_1);
+  test.AddSeqInput("momentums_2", momentums_2);
+
+  test.AddOutput<bool>("updated_flag", {}, {1});
+  test.AddSeqOutput("updated_weights", updated_weights, 1e-4f, 1e-5f);
+  test.AddSeqOutput("updated_momentums_1", updated_momentums_1, 1e-3f, 1e-4f);
+  test.AddSeqOutput("updated_momentums_2", updated_momentums_2, 1e-3f, 1e-5f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+}  // namespace optimizer
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+namespace optimizer {
+namespace {
+
+// The CPU kernel splits the weights in chunks of 16K elements updated in parallel. The weights below are a single
+// partial chunk, two chunks and three chunks with a partial last one.
+TEST(SGDOptimizerV2Test, CpuMultipleChunks) {
+  const float lr = 1e-2f;
+
+  RandomValueGenerator random{};
+  SeqTensors<float> weights, gradients, updated_weights;
+  for (const VectorInt64& shape : {VectorInt64{3, 5}, VectorInt64{256, 128}, VectorInt64{40001}}) {
+    std::vector<float> weight = random.Uniform<float>(shape, -1.f, 1.f);
+    const std::vector<float> gradient = random.Uniform<float>(shape, -1.f, 1.f);
+
+    weights.AddTensor(shape, weight);
+    gradients.AddTensor(shape, gradient);
+
+    for (size_t i = 0; i < weight.size(); ++i) {
+      weight[i] -= lr * gradient[i];
+    }
+    updated_weights.AddTensor(shape, weight);
+  }
+
+  OpTester test("SGDOptimizerV2", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("lr", {}, {lr});
+  test.AddSeqInput("weights", weights);
+  test.AddSeqInput("gradients", gradients);
+
+  test.AddOutput<bool>("update_completed", {}, {true});
+  test.AddSeqOutput("updated_weights", updated_weights, 1e-6f, 1e-6f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+}  // namespace optimizer
+}  // namespace test
+}  // namespace onnxruntime
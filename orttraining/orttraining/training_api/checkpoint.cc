@@ -3,6 +3,13 @@
 
 #include "orttraining/training_api/checkpoint.h"
 
+#include <filesystem>
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
 #include "core/flatbuffers/checkpoint_version.h"
 #include "core/flatbuffers/schema/ort_training_checkpoint.fbs.h"
 #include "core/framework/framework_common.h"
@@ -35,6 +42,22 @@ Status ReadFromExternalFileHelper(std::ifstream& external_data_stream,
   return Status::OK();
 }
 
+/**
+ * @brief Alignment of tensor data in an external file.
+ * @param data_type data type of the tensor.
+ * @return Alignment in bytes.
+ */
+int32_t ExternalDataAlignment(int32_t data_type) {
+  // for now align everything to 4 or 8 bytes. we can optimize this later if needed.
+  // Add more special-cased types if needed. Currently we don't expect to see any other types that are >= 8-bytes here.
+  if (data_type == ONNX_NAMESPACE::TensorProto_DataType_INT64 ||
+      data_type == ONNX_NAMESPACE::TensorProto_DataType_DOUBLE) {
+    return 8;
+  }
+
+  return 4;
+}
+
 /**
  * @brief Helper method to write data to an external file.
  * @param external_data_stream Stream where data will be written to.
@@ -45,14 +68,7 @@ Status ReadFromExternalFileHelper(std::ifstream& external_data_stream,
  */
 Status WriteToExternalFileHelper(std::ofstream& external_data_stream,
                                  int32_t data_type, gsl::span<const uint8_t> bytes, uint64_t& offset) {
-  // for now align everything to 4 or 8 bytes. we can optimize this later if needed.
-  int32_t alignment = 4;
-
-  // Add more special-cased types if needed. Currently we don't expect to see any other types that are >= 8-bytes here.
-  if (data_type == ONNX_NAMESPACE::TensorProto_DataType_INT64 ||
-      data_type == ONNX_NAMESPACE::TensorProto_DataType_DOUBLE) {
-    alignment = 8;
-  }
+  const int32_t alignment = ExternalDataAlignment(data_type);
 
   int64_t pos = external_data_stream.tellp();
 
@@ -75,6 +91,190 @@ Status WriteToExternalFileHelper(std::ofstream& external_data_stream,
   return Status::OK();
 }
 
+/**
+ * @brief Get the identity of an external data file, to find whether it was replaced or modified later.
+ * @param path path of the file.
+ * @return Identity of the file, or nullopt if the file does not exist.
+ */
+std::optional<CheckpointExternalData::FileIdentity> GetFileIdentity(const PathString& path) {
+  CheckpointExternalData::FileIdentity identity;
+  std::error_code error_code;
+  const auto modification_time = std::filesystem::last_write_time(path, error_code);
+  if (error_code) {
+    return std::nullopt;
+  }
+  identity.modification_time = static_cast<int64_t>(modification_time.time_since_epoch().count());
+
+#if !defined(_WIN32)
+  struct stat file_stat;
+  if (stat(path.c_str(), &file_stat) != 0) {
+    return std::nullopt;
+  }
+  identity.device = static_cast<uint64_t>(file_stat.st_dev);
+  identity.inode = static_cast<uint64_t>(file_stat.st_ino);
+  identity.size = static_cast<uint64_t>(file_stat.st_size);
+#else
+  identity.size = static_cast<uint64_t>(std::filesystem::file_size(path, error_code));
+  if (error_code) {
+    return std::nullopt;
+  }
+#endif
+
+  return identity;
+}
+
+/**
+ * @brief Returns whether two paths refer to the same existing file.
+ */
+bool IsSameFile(const PathString& path, const PathString& other_path) {
+  std::error_code error_code;
+  return std::filesystem::equivalent(path, other_path, error_code) && !error_code;
+}
+
+/**
+ * @brief Writes the parameters of a checkpoint state to the external data file of a checkpoint.
+ *
+ * If the file is the one the state was last loaded from or saved to, and it was not replaced or modified since, the
+ * parameters that were not modified since are not written again and the others are appended to the file. The data
+ * already in the file is never modified, as the parameters of the checkpoint states loaded from it may alias its
+ * memory mapped pages. Once the data that is not used anymore takes more space than the data in use, or if the file
+ * is another one or changed since, a new file is written and replaces the existing one.
+ *
+ * The data is either written right away, or copied and written later by Flush(), possibly on another thread.
+ */
+class CheckpointDataWriter {
+ public:
+  CheckpointDataWriter(const PathString& data_path, std::optional<CheckpointExternalData> previous_external_data,
+                       bool defer_writes)
+      : data_path_(data_path), defer_writes_(defer_writes) {
+    external_data_.data_path = data_path;
+    // another state, e.g. a copy of this one, may have saved to the file since. its recorded location of the
+    // parameters is then stale, and the file is written again.
+    if (previous_external_data.has_value() && previous_external_data->file_identity.has_value() &&
+        IsSameFile(previous_external_data->data_path, data_path) &&
+        GetFileIdentity(data_path) == previous_external_data->file_identity) {
+      uint64_t used_size = 0;
+      for (const auto& [name, tensor_data] : previous_external_data->tensors) {
+        used_size += tensor_data.size;
+      }
+
+      if (previous_external_data->file_size - used_size <= used_size) {
+        append_ = true;
+        external_data_.file_size = previous_external_data->file_size;
+        previous_tensors_ = std::move(previous_external_data->tensors);
+      }
+    }
+  }
+
+  /**
+   * @brief Open the external data file for writing.
+   */
+  Status Open() {
+    const PathString output_path = OutputPath();
+    // opening for input as well keeps the content of the existing file
+    stream_.open(output_path, append_ ? std::ios::binary | std::ios::in | std::ios::out
+                                      : std::ios::binary | std::ios::out);
+    ORT_RETURN_IF(stream_.fail(), "Failed to open checkpoint's external data file: ", ToUTF8String(output_path));
+
+    return Status::OK();
+  }
+
+  /**
+   * @brief Set the version of the data of a tensor to be written, see Parameter::DataVersion().
+   */
+  void SetDataVersion(const std::string& name, uint64_t data_version) {
+    data_versions_[name] = data_version;
+  }
+
+  /**
+   * @brief Write the data of a tensor, unless it is already in the file.
+   * @param name name of the tensor. Its data version must have been set.
+   * @param data_type data type of the tensor -- used to determine alignment.
+   * @param bytes data of the tensor.
+   * @param offset Modified to be the offset of the data in the external data file.
+   * @return Status of the operation.
+   */
+  Status Write(const std::string& name, int32_t data_type, gsl::span<const uint8_t> bytes, uint64_t& offset) {
+    const auto data_version = data_versions_.find(name);
+    ORT_RETURN_IF(data_version == data_versions_.end(), "Data version of tensor ", name, " is not set.");
+
+    // the data is not read unless it is written, so that the pages of unmodified mapped parameters are not touched
+    if (const auto previous = previous_tensors_.find(name);
+        previous != previous_tensors_.end() && previous->second.size == bytes.size() &&
+        previous->second.data_version == data_version->second) {
+      offset = previous->second.offset;
+      external_data_.tensors[name] = previous->second;
+      return Status::OK();
+    }
+
+    const uint64_t alignment = static_cast<uint64_t>(ExternalDataAlignment(data_type));
+    offset = (external_data_.file_size + alignment - 1) / alignment * alignment;
+    external_data_.file_size = offset + bytes.size();
+    external_data_.tensors[name] = {offset, bytes.size(), data_version->second};
+
+    if (defer_writes_) {
+      deferred_writes_.emplace_back(offset, std::vector<uint8_t>(bytes.begin(), bytes.end()));
+      return Status::OK();
+    }
+
+    return WriteToFile(offset, bytes);
+  }
+
+  /**
+   * @brief Write the deferred data and close the external data file.
+   */
+  Status Flush() {
+    if (defer_writes_) {
+      ORT_RETURN_IF_ERROR(Open());
+      for (const auto& [offset, bytes] : deferred_writes_) {
+        ORT_RETURN_IF_ERROR(WriteToFile(offset, bytes));
+      }
+      deferred_writes_.clear();
+    }
+
+    stream_.close();
+    ORT_RETURN_IF(stream_.fail(), "Failed writing external checkpoint data.");
+
+    if (!append_) {
+      // the existing file may be memory mapped. replacing it keeps the mapped data of its parameters valid.
+      std::error_code error_code;
+      std::filesystem::rename(OutputPath(), data_path_, error_code);
+      ORT_RETURN_IF(error_code, "Failed to replace checkpoint's external data file: ", ToUTF8String(data_path_),
+                    ". error:", error_code.message());
+    }
+
+    return Status::OK();
+  }
+
+  /**
+   * @brief Location and data version of the tensors in the external data file once written.
+   */
+  const CheckpointExternalData& ExternalData() const { return external_data_; }
+
+ private:
+  PathString OutputPath() const {
+    return append_ ? data_path_ : data_path_ + ORT_TSTR(".tmp");
+  }
+
+  Status WriteToFile(uint64_t offset, gsl::span<const uint8_t> bytes) {
+    stream_.seekp(static_cast<std::streamoff>(offset));
+    stream_.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    const auto [err, msg] = GetErrnoInfo();
+    ORT_RETURN_IF(stream_.fail(), "Failed writing external checkpoint data. ", msg, " errno:", errno);
+
+    return Status::OK();
+  }
+
+  PathString data_path_;
+  bool defer_writes_;
+  bool append_ = false;
+  InlinedHashMap<std::string, CheckpointExternalData::TensorData> previous_tensors_;
+  InlinedHashMap<std::string, uint64_t> data_versions_;
+  CheckpointExternalData external_data_;
+  std::fstream stream_;
+  std::vector<std::pair<uint64_t, std::vector<uint8_t>>> deferred_writes_;
+};
+
 /**
  * @brief Sort keys of a hash map.
  * @param hash_map Hash map to sort.
@@ -129,6 +329,43 @@ Status FlatbufferTensorFromOrtValue(
   return Status::OK();
 }
 
+/**
+ * @brief Create OrtValue object aliasing the data of a flatbuffer tensor in a memory mapped external data file.
+ *
+ * @param fbs_tensor Flatbuffer tensor with external data.
+ * @param mapped_external_data Memory mapped external data file.
+ * @param tensor_name Name of the tensor.
+ * @param ort_value OrtValue object to be populated. Not initialized if the data cannot be aliased.
+ * @return Status of the operation.
+ */
+Status OrtValueFromMappedFlatbufferTensor(const fbs::Tensor& fbs_tensor, gsl::span<uint8_t> mapped_external_data,
+                                          std::string& tensor_name, OrtValue& ort_value) {
+  ORT_RETURN_IF_NOT(fbs_tensor.name(), "Flatbuffer tensor is invalid. Expected: A valid tensor name. Actual: nullptr.");
+  const auto* tensor_dims = fbs_tensor.dims();
+  ORT_RETURN_IF_NOT(tensor_dims, "Flatbuffer tensor is invalid. Expected: Valid tensor dims. Actual: nullptr.");
+
+  const DataTypeImpl* tensor_dtype = DataTypeImpl::TensorTypeFromONNXEnum(
+                                         static_cast<int32_t>(fbs_tensor.data_type()))
+                                         ->GetElementType();
+  const TensorShape tensor_shape(tensor_dims->data(), tensor_dims->size());
+  const size_t num_bytes = Tensor::CalculateTensorStorageSize(tensor_dtype, tensor_shape);
+  const auto offset = static_cast<uint64_t>(fbs_tensor.external_data_offset());
+  ORT_RETURN_IF(offset > mapped_external_data.size() || num_bytes > mapped_external_data.size() - offset,
+                "Data of tensor ", fbs_tensor.name()->str(), " is out of the bounds of the external data file.");
+
+  // the tensor is copied instead if its data is not aligned to its element size.
+  uint8_t* data = mapped_external_data.data() + offset;
+  if (reinterpret_cast<uintptr_t>(data) % tensor_dtype->Size() != 0) {
+    return Status::OK();
+  }
+
+  tensor_name = fbs_tensor.name()->str();
+  const OrtMemoryInfo cpu_alloc_info{onnxruntime::CPU, OrtDeviceAllocator};
+  Tensor::InitOrtValue(tensor_dtype, tensor_shape, data, cpu_alloc_info, ort_value);
+
+  return Status::OK();
+}
+
 /**
  * @brief Create OrtValue object from flatbuffer tensor
  *
@@ -136,23 +373,40 @@ Status FlatbufferTensorFromOrtValue(
  * @param tensor_name Name of the tensor.
  * @param ort_value OrtValue object to be populated.
  * @param external_data_reader delegate to read initializer data from an external file or buffer
+ * @param mapped_external_data Optional memory mapped external data file. Tensors with external data alias it.
+ * @param external_data Optional location of the tensors in the external data file to be populated.
  * @return Status of the operation.
  */
 Status OrtValueFromFlatbufferTensor(const fbs::Tensor& fbs_tensor,
                                     std::string& tensor_name, OrtValue& ort_value,
-                                    const fbs::utils::ExternalDataReader& external_data_reader) {
-  // The assumption is that the flatbuffer buffer will be destructed once the checkpoint has been loaded.
-  // And so, we must allocate a buffer where the tensor data can be copied using the cpu allocator.
-  // This buffer is owned by the OrtValue.
-  static CPUExecutionProviderInfo info;
-  static CPUExecutionProvider cpu_provider(info);
-  AllocatorPtr cpu_allocator = cpu_provider.CreatePreferredAllocators()[0];
+                                    const fbs::utils::ExternalDataReader& external_data_reader,
+                                    gsl::span<uint8_t> mapped_external_data = {},
+                                    CheckpointExternalData* external_data = nullptr) {
+  const bool has_external_data = fbs_tensor.external_data_offset() >= 0;
+  if (has_external_data && !mapped_external_data.empty()) {
+    ORT_RETURN_IF_ERROR(OrtValueFromMappedFlatbufferTensor(fbs_tensor, mapped_external_data, tensor_name, ort_value));
+  }
 
-  std::unique_ptr<Tensor> ort_tensor = std::make_unique<Tensor>();
-  ORT_RETURN_IF_ERROR(fbs::utils::LoadOrtTensorOrtFormat(fbs_tensor, cpu_allocator, tensor_name, *ort_tensor, external_data_reader));
+  if (!ort_value.IsAllocated()) {
+    // The assumption is that the flatbuffer buffer will be destructed once the checkpoint has been loaded.
+    // And so, we must allocate a buffer where the tensor data can be copied using the cpu allocator.
+    // This buffer is owned by the OrtValue.
+    static CPUExecutionProviderInfo info;
+    static CPUExecutionProvider cpu_provider(info);
+    AllocatorPtr cpu_allocator = cpu_provider.CreatePreferredAllocators()[0];
 
-  ort_value.Init(ort_tensor.release(), DataTypeImpl::GetType<onnxruntime::Tensor>(),
-                 DataTypeImpl::GetType<onnxruntime::Tensor>()->GetDeleteFunc());
+    std::unique_ptr<Tensor> ort_tensor = std::make_unique<Tensor>();
+    ORT_RETURN_IF_ERROR(fbs::utils::LoadOrtTensorOrtFormat(fbs_tensor, cpu_allocator, tensor_name, *ort_tensor, external_data_reader));
+
+    ort_value.Init(ort_tensor.release(), DataTypeImpl::GetType<onnxruntime::Tensor>(),
+                   DataTypeImpl::GetType<onnxruntime::Tensor>()->GetDeleteFunc());
+  }
+
+  // the data version is set once the parameter is created
+  if (has_external_data && external_data) {
+    external_data->tensors[tensor_name] = {static_cast<uint64_t>(fbs_tensor.external_data_offset()),
+                                           ort_value.Get<Tensor>().SizeInBytes(), 0};
+  }
 
   return Status::OK();
 }
@@ -164,7 +418,7 @@ Status OrtValueFromFlatbufferTensor(const fbs::Tensor& fbs_tensor,
  * @param data_transfer_manager Data transfer manager to copy the OrtValue tensor to a cpu buffer.
  * @param builder Builder to create flatbuffer tensors.
  * @param flatbuffer_tensors Flatbuffer tensors to be populated.
- * @param external_data_writer Optional delegate to write the tensor data to an external file.
+ * @param external_data_writer Optional writer of the tensor data to an external file.
  * @return Status of the operation.
  */
 Status FlatbufferTensorsFromOrtValues(
@@ -172,10 +426,17 @@ Status FlatbufferTensorsFromOrtValues(
     const DataTransferManager* data_transfer_manager,
     flatbuffers::FlatBufferBuilder& builder,
     std::vector<flatbuffers::Offset<fbs::Tensor>>& flatbuffer_tensors,
-    fbs::utils::ExternalDataWriter external_data_writer = nullptr) {
+    CheckpointDataWriter* external_data_writer = nullptr) {
   for (const auto& name : SortedKeys(name_to_ort_value)) {
     const OrtValue& ort_value = name_to_ort_value.at(name);
     flatbuffers::Offset<fbs::Tensor> fbs_tensor;
+    fbs::utils::ExternalDataWriter tensor_data_writer = nullptr;
+    if (external_data_writer) {
+      tensor_data_writer = [external_data_writer, &name](int32_t data_type, gsl::span<const uint8_t> bytes,
+                                                         uint64_t& offset) {
+        return external_data_writer->Write(name, data_type, bytes, offset);
+      };
+    }
     ORT_RETURN_IF_ERROR(FlatbufferTensorFromOrtValue(
         name, ort_value, [&data_transfer_manager](const auto& src_tensor, auto& dst_tensor) {
           ORT_RETURN_IF_NOT(data_transfer_manager,
@@ -183,7 +444,7 @@ Status FlatbufferTensorsFromOrtValues(
                             "Actual: nullptr.");
           return data_transfer_manager->CopyTensor(src_tensor, dst_tensor);
         },
-        builder, fbs_tensor, external_data_writer));
+        builder, fbs_tensor, tensor_data_writer));
     flatbuffer_tensors.push_back(fbs_tensor);
   }
 
@@ -196,17 +457,21 @@ Status FlatbufferTensorsFromOrtValues(
  * @param flatbuffer_tensors Flatbuffer tensors.
  * @param name_to_ort_value Name to OrtValue map to be populated.
  * @param external_data_reader delegate to read initializer data from an external file or buffer
+ * @param mapped_external_data Optional memory mapped external data file. Tensors with external data alias it.
+ * @param external_data Optional location of the tensors in the external data file to be populated.
  * @return Status of the operation.
  */
 Status OrtValuesFromFlatbufferTensors(
     const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::Tensor>>& flatbuffer_tensors,
-    InlinedHashMap<std::string, OrtValue>& name_to_ort_value, const fbs::utils::ExternalDataReader& external_data_reader) {
+    InlinedHashMap<std::string, OrtValue>& name_to_ort_value, const fbs::utils::ExternalDataReader& external_data_reader,
+    gsl::span<uint8_t> mapped_external_data = {}, CheckpointExternalData* external_data = nullptr) {
   for (const auto* fbs_tensor : flatbuffer_tensors) {
     ORT_RETURN_IF_NOT(fbs_tensor, "Encountered a nullptr flatbuffer tensor. Checkpoint file is invalid.");
 
     std::string tensor_name;
     OrtValue ort_value;
-    ORT_RETURN_IF_ERROR(OrtValueFromFlatbufferTensor(*fbs_tensor, tensor_name, ort_value, external_data_reader));
+    ORT_RETURN_IF_ERROR(OrtValueFromFlatbufferTensor(*fbs_tensor, tensor_name, ort_value, external_data_reader,
+                                                     mapped_external_data, external_data));
     name_to_ort_value.emplace(std::move(tensor_name), std::move(ort_value));
   }
 
@@ -218,15 +483,13 @@ namespace save {
 /**
  * @brief Save from a checkpoint flatbuffer to file.
  * @param checkpoint_path Path to save the checkpoint file.
- * @param builder Flatbuffer builder containing the checkpoint buffer.
+ * @param checkpoint_bytes Checkpoint flatbuffer buffer.
  * @return Status of the operation.
  *
  */
-Status ToFile(const PathString& checkpoint_path, flatbuffers::FlatBufferBuilder& builder) {
+Status ToFile(const PathString& checkpoint_path, gsl::span<const uint8_t> checkpoint_bytes) {
   std::ofstream file(checkpoint_path, std::ios::binary);
-  const uint8_t* buf = builder.GetBufferPointer();
-  int size = builder.GetSize();
-  file.write(reinterpret_cast<const char*>(buf), size);
+  file.write(reinterpret_cast<const char*>(checkpoint_bytes.data()), checkpoint_bytes.size());
   const auto [err, msg] = GetErrnoInfo();
   ORT_RETURN_IF_NOT(file, "Failed to save checkpoint to file: ", ToUTF8String(checkpoint_path), ". error:", msg,
                     " errno:", errno);
@@ -364,7 +627,7 @@ Status FromTensorProtos(gsl::span<const ONNX_NAMESPACE::TensorProto> trainable_t
   const auto checkpoint = checkpoint_builder.Finish();
   builder.Finish(checkpoint, fbs::CheckpointIdentifier());
 
-  return save::ToFile(checkpoint_path, builder);
+  return save::ToFile(checkpoint_path, gsl::make_span(builder.GetBufferPointer(), builder.GetSize()));
 }
 #endif
 
@@ -374,13 +637,13 @@ Status FromTensorProtos(gsl::span<const ONNX_NAMESPACE::TensorProto> trainable_t
  * @param module_state module state containing the model's trainable and non-trainable parameters.
  * @param builder Flatbuffer builder.
  * @param fbs_module_state Flatbuffer module state to be populated.
- * @param external_data_writer Optional delegate to write tensor data to an external file.
+ * @param external_data_writer Optional writer of the tensor data to an external file.
  * @return Status of the operation.
  */
 Status FromModuleState(const ModuleCheckpointState& module_state,
                        flatbuffers::FlatBufferBuilder& builder,
                        flatbuffers::Offset<fbs::ModuleState>& fbs_module_state,
-                       fbs::utils::ExternalDataWriter external_data_writer = nullptr) {
+                       CheckpointDataWriter* external_data_writer = nullptr) {
   if (module_state.named_parameters.empty()) {
     return Status::OK();
   }
@@ -400,6 +663,9 @@ Status FromModuleState(const ModuleCheckpointState& module_state,
     } else {
       frozen_params.insert({name, value->Data()});
     }
+    if (external_data_writer) {
+      external_data_writer->SetDataVersion(name, value->DataVersion());
+    }
   }
 
   std::vector<flatbuffers::Offset<fbs::Tensor>> trainable_tensors;
@@ -552,31 +818,32 @@ Status FromPropertyBag(const PropertyBag& property_bag, flatbuffers::FlatBufferB
  * @param state parameter/optimizer and other user defined training states.
  * @param checkpoint_path file where checkpoint is saved.
  * @param include_optimizer_state Whether to include optimizer state in the checkpoint.
+ * @param write_asynchronously Whether to write the checkpoint files on another thread. The states are copied before
+ *                             returning, and the write is tracked by state.pending_save.
  * @return Status of the operation.
  */
 Status FromCheckpointState(
-    const CheckpointState& state, const PathString& checkpoint_path, const bool include_optimizer_state) {
+    CheckpointState& state, const PathString& checkpoint_path, const bool include_optimizer_state,
+    const bool write_asynchronously) {
   flatbuffers::FlatBufferBuilder builder(1024);
 
-  fbs::utils::ExternalDataWriter external_data_writer = nullptr;
-  std::optional<std::ofstream> external_data_stream;
-  if (state.has_external_data) {
-    auto data_path = ExternalCheckpointDataPath(checkpoint_path);
-    external_data_stream = std::ofstream(data_path, std::ios::binary);
-
-    ORT_RETURN_IF(external_data_stream->fail(), "Failed to create checkpoint's external data file: ",
-                  ToUTF8String(data_path));
+  // the location of the parameters in the external data file is only known again once it has been written
+  std::optional<CheckpointExternalData> previous_external_data = std::move(state.external_data);
+  state.external_data.reset();
 
-    // setup the data writer to write aligned data to external_data_stream
-    external_data_writer = [&external_data_stream](int32_t data_type, gsl::span<const uint8_t> bytes,
-                                                   uint64_t& offset) {
-      return WriteToExternalFileHelper(external_data_stream.value(), data_type, bytes, offset);
-    };
+  std::optional<CheckpointDataWriter> external_data_writer;
+  if (state.has_external_data) {
+    external_data_writer.emplace(ExternalCheckpointDataPath(checkpoint_path), std::move(previous_external_data),
+                                 write_asynchronously);
+    if (!write_asynchronously) {
+      ORT_RETURN_IF_ERROR(external_data_writer->Open());
+    }
   }
 
   // Write weight tensors files.
   flatbuffers::Offset<fbs::ModuleState> module_state;
-  ORT_RETURN_IF_ERROR(FromModuleState(state.module_checkpoint_state, builder, module_state, external_data_writer));
+  ORT_RETURN_IF_ERROR(FromModuleState(state.module_checkpoint_state, builder, module_state,
+                                      external_data_writer ? &*external_data_writer : nullptr));
 
   // Write optimizer state tensors files.
   std::vector<flatbuffers::Offset<fbs::OptimizerGroup>> optimizer_groups;
@@ -597,7 +864,34 @@ Status FromCheckpointState(
   const auto checkpoint = checkpoint_builder.Finish();
   builder.Finish(checkpoint, fbs::CheckpointIdentifier());
 
-  return save::ToFile(checkpoint_path, builder);
+  std::shared_ptr<CheckpointExternalData> external_data;
+  if (external_data_writer) {
+    external_data = std::make_shared<CheckpointExternalData>(external_data_writer->ExternalData());
+  }
+
+  auto write_files = [checkpoint_path, checkpoint_bytes = builder.Release(),
+                      external_data_writer = std::move(external_data_writer), external_data]() mutable {
+    if (external_data_writer) {
+      ORT_RETURN_IF_ERROR(external_data_writer->Flush());
+      external_data->file_identity = GetFileIdentity(external_data->data_path);
+    }
+
+    return save::ToFile(checkpoint_path, gsl::make_span(checkpoint_bytes.data(), checkpoint_bytes.size()));
+  };
+
+  if (write_asynchronously) {
+    // WaitForCheckpointSave() keeps the external data once the write succeeds.
+    state.pending_external_data = std::move(external_data);
+    state.pending_save = std::async(std::launch::async, std::move(write_files)).share();
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(write_files());
+  if (external_data) {
+    state.external_data = std::move(*external_data);
+  }
+
+  return Status::OK();
 }
 
 }  // namespace save
@@ -632,21 +926,35 @@ Status FromFile(const PathString& checkpoint_path, InlinedVector<uint8_t>& check
  * @param fbs_module_state Flatbuffer module state.
  * @param module_state Module state to be populated.
  * @param external_data_reader delegate to read initializer data from an external file or buffer
+ * @param mapped_external_data Optional memory mapped external data file. Parameters with external data alias it.
+ * @param external_data Optional location and data version of the parameters in the external data file to be
+ *                      populated.
  * @return Status of the operation.
  */
 Status ToModuleState(
     const onnxruntime::fbs::ModuleState& fbs_module_state, ModuleCheckpointState& module_state,
-    const fbs::utils::ExternalDataReader& external_data_reader) {
+    const fbs::utils::ExternalDataReader& external_data_reader,
+    gsl::span<uint8_t> mapped_external_data, CheckpointExternalData* external_data) {
   const auto* requires_grad_params = fbs_module_state.requires_grad_params();
   ORT_RETURN_IF_NOT(requires_grad_params, "Expected: Valid trainable tensors flatbuffer.",
                     " Actual: Encountered a nullptr. Checkpoint file is invalid");
   flatbuffers::uoffset_t trainable_params_size = requires_grad_params->size();
   InlinedHashMap<std::string, OrtValue> trainable_params;
   trainable_params.reserve(trainable_params_size);
-  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*requires_grad_params, trainable_params, external_data_reader));
+  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*requires_grad_params, trainable_params, external_data_reader,
+                                                     mapped_external_data, external_data));
+
+  const auto set_data_version = [external_data](const Parameter& param) {
+    if (external_data) {
+      if (auto it = external_data->tensors.find(param.Name()); it != external_data->tensors.end()) {
+        it->second.data_version = param.DataVersion();
+      }
+    }
+  };
 
   for (auto& [name, value] : trainable_params) {
     auto param = std::make_shared<Parameter>(name, value, true);
+    set_data_version(*param);
     module_state.named_parameters.insert({name, param});
   }
 
@@ -656,10 +964,12 @@ Status ToModuleState(
   flatbuffers::uoffset_t non_trainable_params_size = frozen_params->size();
   InlinedHashMap<std::string, OrtValue> non_trainable_params;
   non_trainable_params.reserve(non_trainable_params_size);
-  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*frozen_params, non_trainable_params, external_data_reader));
+  ORT_RETURN_IF_ERROR(OrtValuesFromFlatbufferTensors(*frozen_params, non_trainable_params, external_data_reader,
+                                                     mapped_external_data, external_data));
 
   for (auto& [name, value] : non_trainable_params) {
     auto param = std::make_shared<Parameter>(name, value, false);
+    set_data_version(*param);
     module_state.named_parameters.insert({name, param});
   }
 
@@ -877,8 +1187,10 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
 
   fbs::utils::ExternalDataReader external_data_reader = nullptr;
   std::optional<std::ifstream> external_data_stream;
+  gsl::span<uint8_t> mapped_external_data;
 
   state.has_external_data = false;
+  state.external_data.reset();
   if (nullptr != fbs_module_state && fbs_module_state->has_external_data()) {
     state.has_external_data = true;
     ORT_RETURN_IF_NOT(checkpoint_path.has_value(),
@@ -896,10 +1208,33 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
     external_data_reader = [&external_data_stream](uint64_t offset, gsl::span<uint8_t> output_buffer) {
       return ReadFromExternalFileHelper(external_data_stream.value(), offset, output_buffer);
     };
+
+    // the identity is taken before the file is read, so that any later change of the file is noticed when saving
+    state.external_data.emplace();
+    state.external_data->file_identity = GetFileIdentity(data_path);
+
+    size_t data_length = 0;
+    ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(data_path.c_str(), data_length));
+    state.external_data->data_path = data_path;
+    state.external_data->file_size = data_length;
+
+#if !defined(_WIN32)
+    // The parameters alias the mapped file instead of being copied. The mapping is private so the pages are copied
+    // when the parameters are updated. Parameters of a previous load may alias the mapping the state already holds,
+    // in which case the data is read instead. File mappings are read only on Windows.
+    Env::MappedMemoryPtr mapped_data;
+    if (!state.mapped_external_data && data_length > 0 &&
+        Env::Default().MapFileIntoMemory(data_path.c_str(), 0, data_length, mapped_data).IsOK()) {
+      mapped_external_data = gsl::make_span(reinterpret_cast<uint8_t*>(mapped_data.get()), data_length);
+      state.mapped_external_data = std::make_shared<Env::MappedMemoryPtr>(std::move(mapped_data));
+    }
+#endif
   }
 
   if (nullptr != fbs_module_state) {
-    ORT_RETURN_IF_ERROR(ToModuleState(*fbs_module_state, state.module_checkpoint_state, external_data_reader));
+    ORT_RETURN_IF_ERROR(ToModuleState(*fbs_module_state, state.module_checkpoint_state, external_data_reader,
+                                      mapped_external_data,
+                                      state.external_data.has_value() ? &*state.external_data : nullptr));
   }
 
   const auto* fbs_optimizer_groups = fbs_checkpoint->optimizer_groups();
@@ -948,14 +1283,39 @@ Status SaveCheckpoint(gsl::span<const ONNX_NAMESPACE::TensorProto> trainable_ten
 }
 #endif
 
-Status SaveCheckpoint(const CheckpointState& states, const PathString& checkpoint_path,
+Status SaveCheckpoint(CheckpointState& states, const PathString& checkpoint_path,
                       const bool include_optimizer_state) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
-  return save::FromCheckpointState(states, checkpoint_path, include_optimizer_state);
+  ORT_RETURN_IF_ERROR(WaitForCheckpointSave(states));
+  return save::FromCheckpointState(states, checkpoint_path, include_optimizer_state, false /* write_asynchronously */);
+}
+
+Status SaveCheckpointAsync(CheckpointState& states, const PathString& checkpoint_path,
+                           const bool include_optimizer_state) {
+  ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
+  ORT_RETURN_IF_ERROR(WaitForCheckpointSave(states));
+  return save::FromCheckpointState(states, checkpoint_path, include_optimizer_state, true /* write_asynchronously */);
+}
+
+Status WaitForCheckpointSave(CheckpointState& state) {
+  if (!state.pending_save.valid()) {
+    return Status::OK();
+  }
+
+  Status status = state.pending_save.get();
+  state.pending_save = {};
+  // if the external data file was not completely written, the next save writes all the parameters again
+  if (status.IsOK() && state.pending_external_data) {
+    state.external_data = *state.pending_external_data;
+  }
+  state.pending_external_data.reset();
+
+  return status;
 }
 
 Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkpoint_states) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
+  ORT_RETURN_IF_ERROR(WaitForCheckpointSave(checkpoint_states));
 
   InlinedVector<uint8_t> checkpoint_bytes;
   ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, checkpoint_bytes));
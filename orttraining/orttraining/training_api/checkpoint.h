@@ -3,6 +3,12 @@
 
 #pragma once
 
+#include <future>
+#include <memory>
+#include <optional>
+
+#include "core/common/inlined_containers.h"
+#include "core/platform/env.h"
 #include "core/platform/path_lib.h"
 #include "orttraining/training_api/checkpoint_property.h"
 #include "orttraining/training_api/module.h"
@@ -21,16 +27,64 @@
  * The checkpoint file is a single flatbuffer file containing all the states highlighted above.
  * The flatbuffer schema is defined in onnxruntime/core/flatbuffers/schema/ort_training_checkpoint.fbs
  *
+ * The data of the parameters can be stored in an external data file next to the checkpoint file. When loading such
+ * a checkpoint, the external data file is memory mapped and the parameters alias it instead of being copied. Saving
+ * the state to the same checkpoint again only appends the parameters that changed since it was loaded or last saved,
+ * unless the external data file was replaced or modified by another state in the meantime.
+ *
  */
 
 namespace onnxruntime::training::api {
 
+/**
+ * Location of the parameters in the external data file of a checkpoint, and version of their data when they were
+ * last loaded from or saved to it.
+ */
+struct CheckpointExternalData {
+  struct TensorData {
+    uint64_t offset;
+    size_t size;
+    // see Parameter::DataVersion()
+    uint64_t data_version;
+  };
+
+  // Identity of the file when it was loaded or saved, to find whether it was replaced or modified since.
+  struct FileIdentity {
+    uint64_t device = 0;
+    uint64_t inode = 0;
+    uint64_t size = 0;
+    int64_t modification_time = 0;
+
+    bool operator==(const FileIdentity& other) const {
+      return device == other.device && inode == other.inode && size == other.size &&
+             modification_time == other.modification_time;
+    }
+  };
+
+  PathString data_path;
+  uint64_t file_size = 0;
+  std::optional<FileIdentity> file_identity;
+  InlinedHashMap<std::string, TensorData> tensors;
+};
+
 struct CheckpointState {
  public:
   ModuleCheckpointState module_checkpoint_state;
   OptimizerCheckpointState optimizer_checkpoint_state;
   PropertyBag property_bag;
   bool has_external_data = false;
+
+  // External data file the state was last loaded from or saved to.
+  std::optional<CheckpointExternalData> external_data;
+
+  // Memory mapped external data file the parameters were loaded from. The loaded parameters alias it (pages are
+  // copied on write), so it is kept alive with the state.
+  std::shared_ptr<Env::MappedMemoryPtr> mapped_external_data;
+
+  // Write of the checkpoint files started by SaveCheckpointAsync(), if any.
+  std::shared_future<Status> pending_save;
+  // External data file written by the pending save, which becomes external_data once the write succeeds.
+  std::shared_ptr<CheckpointExternalData> pending_external_data;
 };
 
 /**
@@ -45,11 +99,35 @@ PathString ExternalCheckpointDataPath(const PathString& checkpoint_path);
  *
  * @param state parameter/optimizer and other user defined training states.
  * @param checkpoint_path file where checkpoint is saved.
+ * @remarks If the state has external data and was last loaded from or saved to the same checkpoint, only the
+ *          parameters modified since (see Parameter::DataVersion()) are written to the external data file. The file
+ *          is written again entirely if it was replaced or modified since, e.g. by saving another state to it.
  * @return Status
  */
-Status SaveCheckpoint(const CheckpointState& state, const PathString& checkpoint_path,
+Status SaveCheckpoint(CheckpointState& state, const PathString& checkpoint_path,
                       const bool include_optimizer_state);
 
+/**
+ * @brief Save training states as ORT checkpoint without waiting for the checkpoint files to be written.
+ *
+ * The states to save are copied before returning, so training can continue while the files are written on another
+ * thread. A state has at most one save in progress, saving it again first waits for the previous save to complete.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param checkpoint_path file where checkpoint is saved.
+ * @return Status of the preparation of the save. The status of the write is returned by WaitForCheckpointSave().
+ */
+Status SaveCheckpointAsync(CheckpointState& state, const PathString& checkpoint_path,
+                           const bool include_optimizer_state);
+
+/**
+ * @brief Wait for the save of the state started by SaveCheckpointAsync() to complete.
+ *
+ * @param state state being saved.
+ * @return Status of the write of the checkpoint files. OK if there is no save in progress.
+ */
+Status WaitForCheckpointSave(CheckpointState& state);
+
 #if !defined(ORT_MINIMAL_BUILD)
 /**
  * @brief Save ONNX initializers as ORT checkpoint.
@@ -3,6 +3,8 @@
 
 #include "orttraining/training_api/module.h"
 
+#include <atomic>
+
 #include "core/common/safeint.h"
 #include "core/common/string_utils.h"
 #include "core/framework/execution_provider.h"
@@ -181,8 +183,20 @@ Status LoadParameter(const std::string& param_name, const Tensor& src_weight_ten
     const size_t grad_input_index = grad_it->second;
     auto& param_grad_name = grad_names[grad_input_index];
 
+    // The gradient buffer takes the element type of the graph input, so that the gradients of reduced precision
+    // weights can be accumulated in full precision.
+    MLDataType grad_element_type = nullptr;
+    const NodeArg* param_grad_arg = session_state.GetGraphViewer().GetNodeArg(param_grad_name);
+    if (param_grad_arg != nullptr && param_grad_arg->TypeAsProto() != nullptr) {
+      const auto* grad_tensor_type = onnxruntime::utils::GetMLDataType(*param_grad_arg)->AsTensorType();
+      if (grad_tensor_type != nullptr) {
+        grad_element_type = grad_tensor_type->GetElementType();
+      }
+    }
+
     OrtValue param_grad;
-    ORT_THROW_IF_ERROR(utils::CreateZeroValuedOrtValueLike(session_state, param.Data(), param_grad));
+    ORT_THROW_IF_ERROR(utils::CreateZeroValuedOrtValueLike(session_state, param.Data(), param_grad,
+                                                           grad_element_type));
     ORT_THROW_IF_ERROR(param.SetGrad(param_grad_name, param_grad));
   }
 
@@ -191,6 +205,11 @@ Status LoadParameter(const std::string& param_name, const Tensor& src_weight_ten
 
 }  // namespace
 
+uint64_t Parameter::NextDataVersion() {
+  static std::atomic<uint64_t> next_data_version{0};
+  return next_data_version.fetch_add(1, std::memory_order_relaxed);
+}
+
 Status Parameter::CopyTo(const DataTransferManager* data_transfer_manager, OrtValue& data) const {
   ORT_ENFORCE(data.IsAllocated(), "Given parameter data is not allocated. Cannot copy the checkpoint parameter to it.");
   ORT_ENFORCE(data.IsTensor(), "Parameter data should be of tensor type.");
@@ -242,6 +261,7 @@ Status Parameter::CopyFrom(const DataTransferManager* data_transfer_manager, con
               "Please create the TrainingSession before trying to update the parameter.");
 
   ORT_THROW_IF_ERROR(data_transfer_manager->CopyTensor(data.Get<Tensor>(), *data_.GetMutable<Tensor>()));
+  MarkDataModified();
 
   return Status::OK();
 }
@@ -602,6 +622,7 @@ Status Module::CopyBufferToParameters(OrtValue& parameters_buffer, const bool tr
       ORT_ENFORCE(weight_tensor->DataType() == element_type, "Data types must match.");
       ORT_THROW_IF_ERROR(sess_data_transfer_manager.CopyTensor(*src_tensor.get(), *weight_tensor));
     }
+    param->MarkDataModified();
 
     offset += narrow<size_t>(shape.Size());
   }
@@ -38,9 +38,20 @@ struct Parameter {
 
   Status SetGrad(const std::string& gradient_name, const OrtValue& param_grad);
 
+  // Returns the version of the data, which changes whenever the data is modified through this Parameter or by an
+  // optimizer step. Versions are unique across parameters, so that a checkpoint can tell whether the data it saved
+  // is still the data of the parameter.
+  uint64_t DataVersion() const { return data_version_; }
+
+  // Records that the data was modified in place. Must be called after writing to the data through Data().
+  void MarkDataModified() { data_version_ = NextDataVersion(); }
+
  private:
+  static uint64_t NextDataVersion();
+
   std::string name_;
   OrtValue data_;
+  uint64_t data_version_{NextDataVersion()};
 
   OrtValue gradient_;
   std::string gradient_name_;
@@ -2,9 +2,16 @@
 // Licensed under the MIT License.
 
 #include "orttraining/training_api/optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/common/logging/logging.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/TensorSeq.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
 #include "core/session/environment.h"
@@ -20,6 +27,70 @@ namespace {
 
 constexpr char GROUP_ZERO_NAME[] = "group0";
 static constexpr std::array CommonOptimizerInputs{"learning_rate", "step", "params", "gradients"};
+constexpr char MASTER_WEIGHT_KEY[] = "master_weight";
+
+// Gradients and master weights are processed in chunks of this many elements.
+constexpr std::ptrdiff_t kChunkSize = 16384;
+
+// Whether the optimizer graph updates float parameters. The artifacts generated for reduced precision parameters
+// update float master weights, so that small updates are not lost to rounding.
+bool UpdatesFloatParams(const GraphViewer& graph_viewer) {
+  const NodeArg* params = graph_viewer.GetNodeArg("params");
+  const auto* type = params != nullptr ? params->TypeAsProto() : nullptr;
+  return type != nullptr && type->has_sequence_type() &&
+         type->sequence_type().elem_type().has_tensor_type() &&
+         type->sequence_type().elem_type().tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
+
+bool RequiresMasterWeight(const Tensor& param, bool float_params) {
+  return float_params && (param.IsDataType<MLFloat16>() || param.IsDataType<BFloat16>());
+}
+
+Status CreateMasterWeight(const SessionState& sess_state, const Tensor& param, OrtValue& master_weight) {
+  ORT_RETURN_IF_NOT(param.Location().device.Type() == OrtDevice::CPU,
+                    "Master weights of reduced precision parameters are only supported on CPU.");
+  AllocatorPtr allocator = sess_state.GetAllocator(param.Location().device);
+  ORT_RETURN_IF_NOT(allocator != nullptr, "No allocator found for the master weight.");
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), param.Shape(), std::move(allocator), master_weight);
+
+  float* master_weight_data = master_weight.GetMutable<Tensor>()->MutableData<float>();
+  const size_t count = static_cast<size_t>(param.Shape().Size());
+  if (param.IsDataType<MLFloat16>()) {
+    MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(param.Data<MLFloat16>()),
+                                 master_weight_data, count);
+  } else {
+    const BFloat16* param_data = param.Data<BFloat16>();
+    for (size_t i = 0; i < count; ++i) {
+      master_weight_data[i] = param_data[i].ToFloat();
+    }
+  }
+
+  return Status::OK();
+}
+
+void CopyFromMasterWeight(const Tensor& master_weight, Tensor& param, concurrency::ThreadPool* thread_pool) {
+  const float* master_weight_data = master_weight.Data<float>();
+  const std::ptrdiff_t count = master_weight.Shape().Size();
+  const std::ptrdiff_t num_chunks = (count + kChunkSize - 1) / kChunkSize;
+
+  if (param.IsDataType<MLFloat16>()) {
+    auto* param_data = reinterpret_cast<MLAS_FP16*>(param.MutableData<MLFloat16>());
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_chunks, [&](std::ptrdiff_t chunk) {
+      const std::ptrdiff_t begin = chunk * kChunkSize;
+      const std::ptrdiff_t end = std::min(count, begin + kChunkSize);
+      MlasConvertFloatToHalfBuffer(master_weight_data + begin, param_data + begin, static_cast<size_t>(end - begin));
+    });
+  } else {
+    BFloat16* param_data = param.MutableData<BFloat16>();
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_chunks, [&](std::ptrdiff_t chunk) {
+      const std::ptrdiff_t begin = chunk * kChunkSize;
+      const std::ptrdiff_t end = std::min(count, begin + kChunkSize);
+      for (std::ptrdiff_t i = begin; i < end; ++i) {
+        param_data[i] = BFloat16(master_weight_data[i]);
+      }
+    });
+  }
+}
 
 Status GraphInputsAreExpected(gsl::span<const std::string> actual_graph_inputs,
                               gsl::span<const std::string> expected_graph_inputs) {
@@ -106,9 +177,19 @@ Status Optimizer::GenerateMomentumNamedStates(OptimizerCheckpointState& optimize
     if (pair.second->RequiresGrad()) {
       param_named_optimizer_states.insert({pair.first, ParameterOptimizerState()});
       ParameterOptimizerState& cur_param_optimizer_states = param_named_optimizer_states[pair.first];
+
+      // The moments of parameters with a master weight are kept in the precision of the master weight.
+      OrtValue moment_like = pair.second->Data();
+      if (RequiresMasterWeight(moment_like.Get<Tensor>(), float_params_)) {
+        OrtValue master_weight;
+        ORT_RETURN_IF_ERROR(CreateMasterWeight(optim_sess_state, moment_like.Get<Tensor>(), master_weight));
+        moment_like = master_weight;
+        cur_param_optimizer_states.insert({MASTER_WEIGHT_KEY, std::move(master_weight)});
+      }
+
       for (auto& state_name : optimizer_algo_ptr_->momentum_keys) {
         OrtValue param_state;
-        ORT_ENFORCE(utils::CreateZeroValuedOrtValueLike(optim_sess_state, pair.second->Data(), param_state).IsOK(),
+        ORT_ENFORCE(utils::CreateZeroValuedOrtValueLike(optim_sess_state, moment_like, param_state).IsOK(),
                     "Error generating moment state for ", pair.first);
         cur_param_optimizer_states.insert({state_name, std::move(param_state)});
       }
@@ -121,6 +202,8 @@ Status Optimizer::GenerateMomentumNamedStates(OptimizerCheckpointState& optimize
 // Constructs the ortvalue inputs to be fed to the graph at each step
 Status Optimizer::ConstructInputs() {
   inputs_.clear();
+  gradients_.clear();
+  master_weights_.clear();
 
   auto& param_named_optimizer_states = optimizer_state_->param_named_optimizer_states;
 
@@ -131,14 +214,29 @@ Status Optimizer::ConstructInputs() {
   // Collect all the non-user-defined inputs from the named_parameters_.
   for (auto& [parameter_name, parameter] : state_->module_checkpoint_state.named_parameters) {
     if (parameter->RequiresGrad()) {
-      // Collect parameters and prepare for tensorseq creation
+      // Collect parameters and prepare for tensorseq creation.
+      // The optimizer updates the master weight instead of a reduced precision parameter, which is then
+      // copied back to the parameter after each step.
       auto* param_tensor = parameter->Data().GetMutable<Tensor>();
+      auto& param_optimizer_states = param_named_optimizer_states.at(parameter_name);
+      auto master_weight_it = param_optimizer_states.find(MASTER_WEIGHT_KEY);
+      const bool has_master_weight = master_weight_it != param_optimizer_states.end();
+      if (has_master_weight) {
+        auto* master_weight_tensor = master_weight_it->second.GetMutable<Tensor>();
+        master_weights_.emplace_back(master_weight_tensor, param_tensor);
+        param_tensor = master_weight_tensor;
+      }
       params.emplace_back(
           Tensor(param_tensor->DataType(), param_tensor->Shape(),
                  param_tensor->MutableDataRaw(), param_tensor->Location()));
 
       // Collect gradients and prepare for tensorseq creation
       auto* grad_tensor = parameter->Gradient().GetMutable<Tensor>();
+      ORT_RETURN_IF(has_master_weight && !grad_tensor->IsDataType<float>(),
+                    "The gradient of parameter ", parameter_name,
+                    " must be float to update its master weight, got ",
+                    DataTypeImpl::ToString(grad_tensor->DataType()));
+      gradients_.push_back(grad_tensor);
       grads.emplace_back(
           Tensor(grad_tensor->DataType(), grad_tensor->Shape(),
                  grad_tensor->MutableDataRaw(), grad_tensor->Location()));
@@ -146,9 +244,7 @@ Status Optimizer::ConstructInputs() {
       // Collect moments and prepare for tensorseq creation
       for (size_t m_index = 0; m_index < optimizer_algo_ptr_->momentum_keys.size(); ++m_index) {
         auto* moment_tensor =
-            param_named_optimizer_states.at(parameter_name)
-                .at(optimizer_algo_ptr_->momentum_keys[m_index])
-                .GetMutable<Tensor>();
+            param_optimizer_states.at(optimizer_algo_ptr_->momentum_keys[m_index]).GetMutable<Tensor>();
         list_of_momentums[m_index].emplace_back(
             Tensor(moment_tensor->DataType(), moment_tensor->Shape(),
                    moment_tensor->MutableDataRaw(), moment_tensor->Location()));
@@ -240,6 +336,7 @@ void Optimizer::Initialize(const ModelIdentifiers& model_identifiers,
   ORT_THROW_IF_ERROR(optim_sess_->Initialize());
   optimizer_algo_ptr_ = OptimizerAlorithmFactory::CreateInstance(optim_sess_->GetSessionState().GetGraphViewer(),
                                                                  group_count_);
+  float_params_ = UpdatesFloatParams(optim_sess_->GetSessionState().GetGraphViewer());
 
   // Make sure that the checkpoint state can copy tensors
   state_->optimizer_checkpoint_state.optimizer_session_data_transfer_mgr = &optim_sess_->GetDataTransferManager();
@@ -260,6 +357,22 @@ Status Optimizer::Step() {
     ORT_RETURN_IF_ERROR(ConstructOptimizerStateAndInputs());
   }
 
+  if (loss_scale_ != 1.0f || max_grad_norm_ > 0.0f) {
+    bool is_finite = true;
+    ORT_RETURN_IF_ERROR(UnscaleAndClipGradients(is_finite));
+    if (!is_finite) {
+      // the gradients are reset so that the next steps do not accumulate onto the non-finite values
+      LOGS_DEFAULT(WARNING) << "Skipping the optimizer step since the gradients are not finite.";
+      ++skipped_step_count_;
+      for (auto& [parameter_name, parameter] : state_->module_checkpoint_state.named_parameters) {
+        if (parameter->RequiresGrad()) {
+          ORT_RETURN_IF_ERROR(parameter->ResetGrad());
+        }
+      }
+      return Status::OK();
+    }
+  }
+
   OrtValue learning_rate_input, step_input;
   utils::WrapInOrtValue<float>(optimizer_state_->learning_rate, &learning_rate_input);
   // Use step count + 1 before running optimizer step.
@@ -276,6 +389,79 @@ Status Optimizer::Step() {
   // Extract step output and update
   if (utils::GetScalarFromOrtValue<bool>(outputs[0]) == true) {
     optimizer_state_->step++;
+
+    concurrency::ThreadPool* thread_pool = optim_sess_->GetSessionState().GetThreadPool();
+    for (auto& [master_weight, param] : master_weights_) {
+      CopyFromMasterWeight(*master_weight, *param, thread_pool);
+    }
+
+    for (auto& [parameter_name, parameter] : state_->module_checkpoint_state.named_parameters) {
+      if (parameter->RequiresGrad()) {
+        parameter->MarkDataModified();
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+Status Optimizer::UnscaleAndClipGradients(bool& is_finite) {
+  concurrency::ThreadPool* thread_pool = optim_sess_->GetSessionState().GetThreadPool();
+
+  // The squared norm is accumulated in double, one partial sum per chunk, so that it neither overflows for large
+  // loss scales nor depends on the number of threads.
+  double squared_norm = 0.0;
+  InlinedVector<double> partial_sums;
+  for (const Tensor* gradient : gradients_) {
+    ORT_RETURN_IF_NOT(gradient->IsDataType<float>() && gradient->Location().device.Type() == OrtDevice::CPU,
+                      "Gradient scaling is only supported for float gradients on CPU.");
+
+    const float* gradient_data = gradient->Data<float>();
+    const std::ptrdiff_t count = gradient->Shape().Size();
+    const std::ptrdiff_t num_chunks = (count + kChunkSize - 1) / kChunkSize;
+    partial_sums.assign(static_cast<size_t>(num_chunks), 0.0);
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_chunks, [&](std::ptrdiff_t chunk) {
+      const std::ptrdiff_t begin = chunk * kChunkSize;
+      const std::ptrdiff_t end = std::min(count, begin + kChunkSize);
+      double sum = 0.0;
+      for (std::ptrdiff_t i = begin; i < end; ++i) {
+        sum += static_cast<double>(gradient_data[i]) * gradient_data[i];
+      }
+      partial_sums[chunk] = sum;
+    });
+
+    for (double partial_sum : partial_sums) {
+      squared_norm += partial_sum;
+    }
+  }
+
+  is_finite = std::isfinite(squared_norm);
+  if (!is_finite) {
+    return Status::OK();
+  }
+
+  double scale = 1.0 / loss_scale_;
+  const double norm = std::sqrt(squared_norm) * scale;
+  if (max_grad_norm_ > 0.0f && norm > max_grad_norm_) {
+    scale *= max_grad_norm_ / (norm + 1e-6);
+  }
+
+  if (scale == 1.0) {
+    return Status::OK();
+  }
+
+  const float gradient_scale = static_cast<float>(scale);
+  for (Tensor* gradient : gradients_) {
+    float* gradient_data = gradient->MutableData<float>();
+    const std::ptrdiff_t count = gradient->Shape().Size();
+    const std::ptrdiff_t num_chunks = (count + kChunkSize - 1) / kChunkSize;
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_chunks, [&](std::ptrdiff_t chunk) {
+      const std::ptrdiff_t begin = chunk * kChunkSize;
+      const std::ptrdiff_t end = std::min(count, begin + kChunkSize);
+      for (std::ptrdiff_t i = begin; i < end; ++i) {
+        gradient_data[i] *= gradient_scale;
+      }
+    });
   }
 
   return Status::OK();
@@ -329,6 +515,14 @@ Status Optimizer::LoadStateDict(OptimizerCheckpointState& optimizer_checkpoint_s
           param_momentum.Init(target_tensor.release(), ml_tensor_type, ml_tensor_type->GetDeleteFunc());
         }
       }
+
+      // Checkpoints saved without master weights start from the parameters.
+      if (RequiresMasterWeight(param_data_tensor, float_params_) &&
+          momentum_named_states.find(MASTER_WEIGHT_KEY) == momentum_named_states.end()) {
+        OrtValue master_weight;
+        ORT_RETURN_IF_ERROR(CreateMasterWeight(optim_sess_state, param_data_tensor, master_weight));
+        momentum_named_states.insert({MASTER_WEIGHT_KEY, std::move(master_weight)});
+      }
     }
   }
 
@@ -18,6 +18,9 @@ namespace api {
  *   Momentum states for each Parameter.
  *   For Adam optimizer, it looks like:
  *     { "moment_0": OrtValue, "moment_1": OrtValue,}.
+ *   Reduced precision (float16/bfloat16) parameters on CPU also have their float master weight
+ *   under the "master_weight" key if the optimizer graph updates float parameters. The master weight
+ *   is updated by the optimizer instead of the parameter.
  */
 typedef InlinedHashMap<std::string, OrtValue> ParameterOptimizerState;
 
@@ -114,6 +117,29 @@ struct Optimizer {
     return optimizer_state_->learning_rate;
   }
 
+  /**
+   * @brief Sets how the gradients are prepared before each optimizer step.
+   *
+   * The gradients are divided by loss_scale, which the loss was multiplied by to keep the reduced precision
+   * gradients from underflowing. If max_grad_norm is positive, the gradients are then scaled so that their global
+   * L2 norm is at most max_grad_norm. Both are done in a single pass over the gradients after computing their norm,
+   * and the step is skipped if the gradients are not finite. A skipped step resets the gradients and is counted by
+   * SkippedStepCount(), so that the caller can e.g. lower the loss scale.
+   * Only supported for float gradients on CPU.
+   */
+  Status SetGradientScaling(float loss_scale, float max_grad_norm) {
+    ORT_RETURN_IF_NOT(loss_scale > 0.0f, "Loss scale must be positive, got ", loss_scale);
+    ORT_RETURN_IF(max_grad_norm < 0.0f, "Max gradient norm must not be negative, got ", max_grad_norm);
+    loss_scale_ = loss_scale;
+    max_grad_norm_ = max_grad_norm;
+    return Status::OK();
+  }
+
+  // Returns the number of steps skipped since the gradients were not finite, see SetGradientScaling().
+  int64_t SkippedStepCount() const noexcept {
+    return skipped_step_count_;
+  }
+
   Status SetInitialLearningRate(float initial_lr) {
     optimizer_state_->initial_lr = initial_lr;
     optimizer_state_->learning_rate = initial_lr;
@@ -154,6 +180,10 @@ struct Optimizer {
    */
   Status LoadStateDict(OptimizerCheckpointState& optimizer_checkpoint_states);
 
+  // Divides the gradients by the loss scale and clips them to the max gradient norm.
+  // is_finite is set to false, and the gradients are left unchanged, if any gradient is not finite.
+  Status UnscaleAndClipGradients(bool& is_finite);
+
   std::unique_ptr<OptimizerAlgorithmBase> optimizer_algo_ptr_;
   std::unique_ptr<onnxruntime::InferenceSession> optim_sess_;
 
@@ -164,6 +194,18 @@ struct Optimizer {
   InlinedVector<std::string> output_names_;
   InlinedVector<OrtValue> inputs_;
 
+  // gradients of the trainable parameters, in the order of the inputs.
+  InlinedVector<Tensor*> gradients_;
+  // float master weights and the reduced precision parameters they are copied back to after each step.
+  InlinedVector<std::pair<const Tensor*, Tensor*>> master_weights_;
+
+  // whether the optimizer graph updates float parameters, i.e. reduced precision parameters have master weights.
+  bool float_params_{false};
+
+  float loss_scale_{1.0f};
+  float max_grad_norm_{0.0f};
+  int64_t skipped_step_count_{0};
+
   int32_t group_count_{0};
 
   bool delay_optimizer_state_construction_{false};
@@ -57,13 +57,16 @@ bool GetParamNameFromGradient(const std::string& grad_name, std::string& param_n
   return false;
 }
 
-Status CreateZeroValuedOrtValueLike(const SessionState& sess_state, const OrtValue& input_val, OrtValue& output_val) {
+Status CreateZeroValuedOrtValueLike(const SessionState& sess_state, const OrtValue& input_val, OrtValue& output_val,
+                                    MLDataType element_type) {
   const auto& param_tensor = input_val.template Get<Tensor>();
   const TensorShape& shape = param_tensor.Shape();
   auto& tensor_location = param_tensor.Location();
   AllocatorPtr allocator = sess_state.GetAllocator(tensor_location);
 
-  auto element_type = param_tensor.DataType();
+  if (element_type == nullptr) {
+    element_type = param_tensor.DataType();
+  }
   auto p_tensor = std::make_unique<Tensor>(element_type, shape, allocator);
 
   if (tensor_location.device.Type() == OrtDevice::CPU ||
@@ -59,7 +59,9 @@ bool GetParamNameFromSuffix(const std::string& name, const std::string& suffix,
 bool GetParamNameFromGradient(const std::string& grad_name, std::string& param_name);
 
 // Allocate OrtValue like the input ortvalue on the same device
-Status CreateZeroValuedOrtValueLike(const SessionState& sess_state, const OrtValue& input_val, OrtValue& output_val);
+// If element_type is given, the output has that element type instead of the one of the input.
+Status CreateZeroValuedOrtValueLike(const SessionState& sess_state, const OrtValue& input_val, OrtValue& output_val,
+                                    MLDataType element_type = nullptr);
 
 // Create OrtValue from a single value of type T
 template <typename T>
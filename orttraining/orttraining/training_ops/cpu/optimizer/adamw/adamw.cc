@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "orttraining/training_ops/cpu/optimizer/adamw/adamw.h"
+
+#include <type_traits>
+
 #include "orttraining/training_ops/cpu/optimizer/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
@@ -9,6 +12,7 @@
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/tensor/utils.h"
+#include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -57,14 +61,22 @@ Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimize
 
           prepare.grouped_tensor_sizes[i] = static_cast<int>(weight_tensor.Shape().Size());
 
+          // momentums may be kept in reduced precision, their type is checked below.
           prepare.grouped_tensor_pointers[i] = {
               const_cast<float*>(weight_tensor.Data<float>()),
               const_cast<float*>(gradient_tensor.Data<float>()),
-              const_cast<float*>(momentum_1_tensor.Data<float>()),
-              const_cast<float*>(momentum_2_tensor.Data<float>())};
+              const_cast<void*>(momentum_1_tensor.DataRaw()),
+              const_cast<void*>(momentum_2_tensor.DataRaw())};
         }
       });
 
+  const MLDataType momentum_type = prepare.momentums_1->DataType();
+  ORT_RETURN_IF_NOT(momentum_type == prepare.momentums_2->DataType(), "Types of momentums_1 and momentums_2 mismatch.");
+  ORT_RETURN_IF_NOT(momentum_type == DataTypeImpl::GetType<float>() ||
+                        momentum_type == DataTypeImpl::GetType<MLFloat16>() ||
+                        momentum_type == DataTypeImpl::GetType<BFloat16>(),
+                    "Momentums must be float, float16 or bfloat16 tensors.");
+
   prepare.updated_flag = ctx->Output(0, prepare.step->Shape());
   prepare.updated_weights = ctx->Output<TensorSeq>(1);
   prepare.updated_momentums_1 = ctx->Output<TensorSeq>(2);
@@ -89,49 +101,102 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("S_MOMENT", DataTypeImpl::AllFixedSizeSequenceTensorTypes()),
     AdamWOptimizer<float>);
 
-template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float alpha_correction, float beta_correction) const {
-  // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (MakeEigenArrayMap<T>(weight) * lr * weight_decay_);
-
-  // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
+namespace {
+
+// Number of elements updated by a task. The weights, gradients and momentums of a chunk stay in L2 cache between the
+// expressions of the update, so every tensor is streamed through memory once per step.
+constexpr size_t kAdamWChunkSize = 4096;
+
+struct AdamWStepParameters {
+  float alpha;
+  float beta;
+  float epsilon;
+  float weight_decay;
+  int64_t adam_mode;
+
+  float lr;
+  float lr_corrected;
+  float alpha_correction;
+  float beta_correction;
+};
+
+void AdamWUpdate(const AdamWStepParameters& p, float* weight_data, const float* gradient_data,
+                 float* momentum_1_data, float* momentum_2_data, size_t size) {
+  const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(size);
+  EigenVectorArrayMap<float> weight(weight_data, n);
+  ConstEigenVectorArrayMap<float> gradient(gradient_data, n);
+  EigenVectorArrayMap<float> momentum_1(momentum_1_data, n);
+  EigenVectorArrayMap<float> momentum_2(momentum_2_data, n);
+
+  if (p.adam_mode == 0) {
+    // Perform weight decay.
+    weight = weight - (weight * p.lr * p.weight_decay);
+
+    // Compute exponentially-averaged historical gradient.
+    momentum_1 = p.alpha * momentum_1 + (1.f - p.alpha) * gradient;
+
+    // Compute exponentially-averaged historical squared gradient.
+    momentum_2 = p.beta * momentum_2 + (1.f - p.beta) * gradient * gradient;
+
+    // Compute the new weight.
+    auto denom = (momentum_2 / p.beta_correction).sqrt() + p.epsilon;
+    weight = weight - (p.lr * momentum_1) / (p.alpha_correction * denom);
+  } else {
+    // Compute exponentially-averaged historical gradient.
+    momentum_1 = p.alpha * momentum_1 + (1.f - p.alpha) * gradient;
 
-  // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
+    // Compute exponentially-averaged historical squared gradient.
+    momentum_2 = p.beta * momentum_2 + (1.f - p.beta) * gradient * gradient;
 
-  // Compute the new weight.
-  auto denom = (MakeEigenArrayMap<T>(momentums_2) / beta_correction).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr * MakeEigenArrayMap<T>(momentums_1)) / (alpha_correction * denom);
+    auto denom = momentum_2.sqrt() + p.epsilon;
+    weight = weight - (p.lr_corrected * momentum_1 / denom);
 
-  return Status::OK();
+    // Perform weight decay.
+    weight = weight - (p.lr * p.weight_decay * weight);
+  }
 }
 
-template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float lr_corrected) const {
-  // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
-
-  // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
+template <typename TMoment>
+void AdamWUpdateChunk(const AdamWStepParameters& p, float* weight, const float* gradient,
+                      TMoment* momentum_1, TMoment* momentum_2, size_t size) {
+  if constexpr (std::is_same_v<TMoment, float>) {
+    AdamWUpdate(p, weight, gradient, momentum_1, momentum_2, size);
+  } else {
+    // Momentums kept in reduced precision are updated in float and rounded once.
+    float momentum_1_buffer[kAdamWChunkSize];
+    float momentum_2_buffer[kAdamWChunkSize];
+    for (size_t i = 0; i < size; ++i) {
+      momentum_1_buffer[i] = momentum_1[i].ToFloat();
+      momentum_2_buffer[i] = momentum_2[i].ToFloat();
+    }
 
-  auto denom = MakeEigenArrayMap<T>(momentums_2).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr_corrected * MakeEigenArrayMap<T>(momentums_1) / denom);
+    AdamWUpdate(p, weight, gradient, momentum_1_buffer, momentum_2_buffer, size);
 
-  // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (lr * weight_decay_ * MakeEigenArrayMap<T>(weight));
+    for (size_t i = 0; i < size; ++i) {
+      momentum_1[i] = TMoment(momentum_1_buffer[i]);
+      momentum_2[i] = TMoment(momentum_2_buffer[i]);
+    }
+  }
+}
 
-  return Status::OK();
+template <typename TMoment>
+void AdamWUpdateChunks(const AdamWStepParameters& p, const AdamWOptimizerBase::Prepare& prepare,
+                       gsl::span<const TensorChunk> chunks, concurrency::ThreadPool* tp) {
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, static_cast<std::ptrdiff_t>(chunks.size()), [&](std::ptrdiff_t chunk_index) {
+        const TensorChunk& chunk = chunks[static_cast<size_t>(chunk_index)];
+        const auto& pointers = prepare.grouped_tensor_pointers[chunk.tensor_index];
+        AdamWUpdateChunk(p,
+                         static_cast<float*>(pointers[0]) + chunk.offset,
+                         static_cast<const float*>(pointers[1]) + chunk.offset,
+                         static_cast<TMoment*>(pointers[2]) + chunk.offset,
+                         static_cast<TMoment*>(pointers[3]) + chunk.offset,
+                         chunk.size);
+      });
 }
 
+}  // namespace
+
 template <typename T>
 Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
   AdamWOptimizerBase::Prepare p;
@@ -164,22 +229,19 @@ Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
     //         src/transformers/optimization.py,
     //         bias correction is applied on learning rate, then use lr_corrected for subsequent computations.
     //         weight decay is applied after weight is updated.
-
-    for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-      Tensor& momentums_1 = const_cast<Tensor&>(p.momentums_1->Get(weight_index));
-      Tensor& momentums_2 = const_cast<Tensor&>(p.momentums_2->Get(weight_index));
-
-      if (adam_mode_ == 0) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode0(weight, gradient, momentums_1, momentums_2, lr, alpha_correction, beta_correction));
-      } else if (adam_mode_ == 1) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode1(weight, gradient, momentums_1, momentums_2, lr, lr_corrected));
-      } else {
-        ORT_THROW("Unsupported Adamw optimizer mode.");
-      }
+    const AdamWStepParameters params{alpha_, beta_, epsilon_, weight_decay_, adam_mode_,
+                                     lr, lr_corrected, alpha_correction, beta_correction};
+
+    // All the weights are updated at once, split in chunks processed in parallel.
+    const auto chunks = SplitIntoChunks(p.grouped_tensor_sizes, kAdamWChunkSize);
+    auto* tp = ctx->GetOperatorThreadPool();
+    const MLDataType momentum_type = p.momentums_1->DataType();
+    if (momentum_type == DataTypeImpl::GetType<MLFloat16>()) {
+      AdamWUpdateChunks<MLFloat16>(params, p, chunks, tp);
+    } else if (momentum_type == DataTypeImpl::GetType<BFloat16>()) {
+      AdamWUpdateChunks<BFloat16>(params, p, chunks, tp);
+    } else {
+      AdamWUpdateChunks<float>(params, p, chunks, tp);
     }
 
     *updated_flag_ptr = true;
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
@@ -10,6 +12,17 @@
 namespace onnxruntime {
 namespace contrib {
 
+InlinedVector<TensorChunk> SplitIntoChunks(gsl::span<const int> tensor_sizes, size_t chunk_size) {
+  InlinedVector<TensorChunk> chunks;
+  for (size_t tensor_index = 0; tensor_index < tensor_sizes.size(); ++tensor_index) {
+    const size_t tensor_size = static_cast<size_t>(tensor_sizes[tensor_index]);
+    for (size_t offset = 0; offset < tensor_size; offset += chunk_size) {
+      chunks.push_back({tensor_index, offset, std::min(chunk_size, tensor_size - offset)});
+    }
+  }
+  return chunks;
+}
+
 Status CopyIfNotSameCPUBuffer(OpKernelContext* ctx, size_t number_of_values,
                               const TensorSeq* src_values, TensorSeq* dest_values) {
   if (src_values != dest_values) {
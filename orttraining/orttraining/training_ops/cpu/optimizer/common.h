@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
 #include <cmath>
 
@@ -19,6 +20,17 @@ TC compute_bias_correction_coefficient(const TC momentum_update_coefficient, con
   }
 }
 
+// A range of elements of one of the tensors updated by a multi-tensor optimizer.
+struct TensorChunk {
+  size_t tensor_index;
+  size_t offset;
+  size_t size;
+};
+
+// Splits tensors with the given numbers of elements in chunks of at most chunk_size elements, so that optimizers
+// update all the tensors in parallel regardless of their sizes.
+InlinedVector<TensorChunk> SplitIntoChunks(gsl::span<const int> tensor_sizes, size_t chunk_size);
+
 Status CopyIfNotSameCPUBuffer(OpKernelContext* ctx, size_t number_of_values, const TensorSeq* src_values,
                               TensorSeq* dest_values);
 
@@ -3,9 +3,12 @@
 
 #include "gradient_control.h"
 
+#include <type_traits>
+
 #include "core/framework/op_kernel.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -79,38 +82,69 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T2", DataTypeImpl::AllTensorTypes()),
     ZeroGradient<float>);
 
-ONNX_OPERATOR_KERNEL_EX(
-    InPlaceAccumulatorV2,
-    kMSDomain,
-    1,
-    kCpuExecutionProvider,
-    KernelDefBuilder()
-        .Alias(0, 1)  // accumulate tensors in-place
-        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
-    InPlaceAccumulatorV2<float>);
-
-template <typename T>
-Status InPlaceAccumulatorV2<T>::Compute(OpKernelContext* context) const {
+#define REGISTER_IN_PLACE_TENSOR_ACCUMULATORV2_TYPED(T, T_GRAD)             \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                            \
+      InPlaceAccumulatorV2,                                                 \
+      kMSDomain,                                                            \
+      1,                                                                    \
+      T##_##T_GRAD,                                                         \
+      kCpuExecutionProvider,                                                \
+      KernelDefBuilder()                                                    \
+          .Alias(0, 1) /* accumulate tensors in-place */                    \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())            \
+          .TypeConstraint("T_GRAD", DataTypeImpl::GetTensorType<T_GRAD>()), \
+      InPlaceAccumulatorV2<T, T_GRAD>);
+
+REGISTER_IN_PLACE_TENSOR_ACCUMULATORV2_TYPED(float, float)
+REGISTER_IN_PLACE_TENSOR_ACCUMULATORV2_TYPED(float, MLFloat16)
+REGISTER_IN_PLACE_TENSOR_ACCUMULATORV2_TYPED(float, BFloat16)
+
+template <typename T, typename T_GRAD>
+Status InPlaceAccumulatorV2<T, T_GRAD>::Compute(OpKernelContext* context) const {
   Tensor* accumulation_buffer = const_cast<Tensor*>(context->Input<Tensor>(0));
   const Tensor* new_value = context->Input<Tensor>(1);
   const Tensor* overwrite_tensor = context->Input<Tensor>(2);
 
-  void* accumulation_buffer_data = accumulation_buffer->template MutableData<T>();
+  T* accumulation_buffer_data = accumulation_buffer->template MutableData<T>();
   const bool overwrite = overwrite_tensor != nullptr ? *(overwrite_tensor->template Data<bool>()) : false;
 
-  if (overwrite) {
-    const void* updated_data = new_value->template Data<T>();
-    memcpy(accumulation_buffer_data, updated_data, new_value->SizeInBytes());
-  } else {
-    // Copy from Add CPU kernel
-    ProcessBroadcastSpanFuncs funcs;
-    getBroadcastSpanFunc<T>(funcs);
+  if constexpr (std::is_same_v<T, T_GRAD>) {
+    if (overwrite) {
+      const void* updated_data = new_value->template Data<T>();
+      memcpy(accumulation_buffer_data, updated_data, new_value->SizeInBytes());
+    } else {
+      // Copy from Add CPU kernel
+      ProcessBroadcastSpanFuncs funcs;
+      getBroadcastSpanFunc<T>(funcs);
 
-    InputBroadcaster input_broadcaster(*accumulation_buffer, *new_value);
-    OutputBroadcaster output_broadcaster(input_broadcaster.GetSpanSize(), *accumulation_buffer);
-    BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, nullptr);
+      InputBroadcaster input_broadcaster(*accumulation_buffer, *new_value);
+      OutputBroadcaster output_broadcaster(input_broadcaster.GetSpanSize(), *accumulation_buffer);
+      BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, nullptr);
 
-    BroadcastLooper(broadcast_helper, funcs);
+      BroadcastLooper(broadcast_helper, funcs);
+    }
+  } else {
+    // reduced precision values, e.g. the gradients of float16 weights, are accumulated in full precision directly
+    // into the buffer, without converting them to a temporary buffer first.
+    ORT_RETURN_IF_NOT(accumulation_buffer->Shape() == new_value->Shape(),
+                      "Mixed precision accumulation requires the same shapes, got ", accumulation_buffer->Shape(),
+                      " and ", new_value->Shape());
+
+    const T_GRAD* new_value_data = new_value->template Data<T_GRAD>();
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), new_value->Shape().Size(),
+        TensorOpCost{static_cast<double>(sizeof(T) + sizeof(T_GRAD)), static_cast<double>(sizeof(T)), 2.0},
+        [accumulation_buffer_data, new_value_data, overwrite](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          if (overwrite) {
+            for (std::ptrdiff_t i = begin; i < end; ++i) {
+              accumulation_buffer_data[i] = static_cast<T>(new_value_data[i].ToFloat());
+            }
+          } else {
+            for (std::ptrdiff_t i = begin; i < end; ++i) {
+              accumulation_buffer_data[i] += static_cast<T>(new_value_data[i].ToFloat());
+            }
+          }
+        });
   }
 
   Tensor* updated_output = context->Output(0, {1});
@@ -121,7 +155,7 @@ Status InPlaceAccumulatorV2<T>::Compute(OpKernelContext* context) const {
   if (nullptr != accumulated_value_out) {
     void* output_data = accumulated_value_out->template MutableData<T>();
     if (output_data != accumulation_buffer_data) {
-      memcpy(output_data, accumulation_buffer_data, new_value->SizeInBytes());
+      memcpy(output_data, accumulation_buffer_data, accumulation_buffer->SizeInBytes());
     }
   }
 
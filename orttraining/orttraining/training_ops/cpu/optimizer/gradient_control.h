@@ -22,7 +22,7 @@ class InPlaceAccumulator final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 };
 
-template <typename T>
+template <typename T, typename T_GRAD>
 class InPlaceAccumulatorV2 final : public OpKernel {
  public:
   InPlaceAccumulatorV2(const OpKernelInfo& info) : OpKernel(info) {}
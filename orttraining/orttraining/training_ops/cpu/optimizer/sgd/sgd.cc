@@ -6,7 +6,9 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
 #include "core/providers/common.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
+#include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -54,6 +56,13 @@ Status SGDOptimizerV2Base::PrepareForCompute(OpKernelContext* ctx, SGDOptimizerV
   return Status::OK();
 }
 
+namespace {
+
+// Number of elements updated by a task.
+constexpr size_t kSGDChunkSize = 16 * 1024;
+
+}  // namespace
+
 template <typename T>
 Status SGDOptimizerV2<T>::Compute(OpKernelContext* ctx) const {
   SGDOptimizerV2Base::Prepare p;
@@ -64,14 +73,19 @@ Status SGDOptimizerV2<T>::Compute(OpKernelContext* ctx) const {
   if (update_signal == nullptr || *update_signal->template Data<bool>()) {
     const float lr = *p.learning_rate->template Data<float>();
 
-    for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-
-      // new_weight = weight - lr * gradient
-      const auto& delta = -lr * MakeEigenArrayMap<T>(gradient);
-      MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) + delta;
-    }
+    // All the weights are updated at once, split in chunks processed in parallel.
+    const auto chunks = SplitIntoChunks(p.grouped_tensor_sizes, kSGDChunkSize);
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(chunks.size()), [&](std::ptrdiff_t chunk_index) {
+          const TensorChunk& chunk = chunks[static_cast<size_t>(chunk_index)];
+          const auto& pointers = p.grouped_tensor_pointers[chunk.tensor_index];
+          const std::ptrdiff_t size = static_cast<std::ptrdiff_t>(chunk.size);
+          EigenVectorArrayMap<T> weight(static_cast<T*>(pointers[0]) + chunk.offset, size);
+          ConstEigenVectorArrayMap<T> gradient(static_cast<const T*>(pointers[1]) + chunk.offset, size);
+
+          // new_weight = weight - lr * gradient
+          weight = weight - lr * gradient;
+        });
 
     *updated_flag_ptr = true;
   } else {